@@ -15,6 +15,7 @@ set(sslib_Header_Files__analysis
   include/spl/analysis/Histogram.h
   include/spl/analysis/MapArrangementTraits.h
   include/spl/analysis/MatplotlibMapOutputter.h
+  include/spl/analysis/RadialDistribution.h
   include/spl/analysis/RawMapOutputter.h
   include/spl/analysis/SpaceGroup.h
   include/spl/analysis/StructureConvexHullInfoSupplier.h
@@ -62,6 +63,7 @@ set(sslib_Header_Files__build_cell
   include/spl/build_cell/GeneratorShape.h
   include/spl/build_cell/IFragmentGenerator.h
   include/spl/build_cell/IUnitCellGenerator.h
+  include/spl/build_cell/ParallelStructureGenerator.h
   include/spl/build_cell/PointGroups.h
   include/spl/build_cell/PointSeparator.h
   include/spl/build_cell/RandomUnitCellGenerator.h
@@ -97,20 +99,31 @@ set(sslib_Header_Files__common
   include/spl/common/AtomSpeciesId.h
   include/spl/common/AtomSpeciesInfo.h
   include/spl/common/ClusterDistanceCalculator.h
+  include/spl/common/CompactFormula.h
   include/spl/common/Constants.h
   include/spl/common/DistanceCalculator.h
   include/spl/common/DistanceCalculatorDelegator.h
+  include/spl/common/GeometrySnapshot.h
   include/spl/common/OrthoCellDistanceCalculator.h
   include/spl/common/ReferenceDistanceCalculator.h
+  include/spl/common/StaticDistanceCalculator.h
   include/spl/common/Structure.h
   include/spl/common/StructureListener.h
   include/spl/common/StructureProperties.h
+  include/spl/common/SymmetryCache.h
   include/spl/common/Types.h
   include/spl/common/UnitCell.h
   include/spl/common/UniversalCrystalDistanceCalculator.h
 )
 source_group("Header Files\\common" FILES ${sslib_Header_Files__common})
 
+## common/detail
+
+set(sslib_Header_Files__common__detail
+  include/spl/common/detail/DistanceCalculatorDelegator.h
+)
+source_group("Header Files\\common\\detail" FILES ${sslib_Header_Files__common__detail})
+
 ## common/event
 
 set(sslib_Header_Files__common__event
@@ -149,6 +162,7 @@ set(sslib_Header_Files__io
   include/spl/io/Parsing.h
   include/spl/io/ResourceLocator.h
   include/spl/io/ResReaderWriter.h
+  include/spl/io/SplIndex.h
   include/spl/io/SplReaderWriter.h
   include/spl/io/StructureSchema.h
   include/spl/io/StructureYamlGenerator.h
@@ -167,6 +181,7 @@ source_group("Header Files\\io\\detail" FILES ${sslib_Header_Files__io__detail})
 ## math
 set(sslib_Header_Files__math
   include/spl/math/Geometry.h
+  include/spl/math/KdTree.h
   include/spl/math/LinearAlgebra.h
   include/spl/math/Matrix.h
   include/spl/math/NumberAlgorithms.h
@@ -183,6 +198,7 @@ source_group("Header Files\\math\\detail" FILES ${sslib_Header_Files__math__deta
 
 ## os
 set(sslib_Header_Files__os
+  include/spl/os/PipedProcess.h
   include/spl/os/Process.h
 )
 source_group("Header Files\\os" FILES ${sslib_Header_Files__os})
@@ -215,6 +231,7 @@ set(sslib_Header_Files__utility
   include/spl/utility/DataPool.h
   include/spl/utility/DistanceMatrixComparator.h
   include/spl/utility/EdgeMap.h
+  include/spl/utility/FingerprintComparator.h
   include/spl/utility/GenericBufferedComparator.h
   include/spl/utility/HasProperties.h
   include/spl/utility/HeterogeneousMap.h
@@ -223,6 +240,7 @@ set(sslib_Header_Files__utility
   include/spl/utility/IBufferedComparator.h
   include/spl/utility/IndexingEnums.h
   include/spl/utility/IndexRemappingView.h
+  include/spl/utility/Instrumentation.h
   include/spl/utility/IStructureComparator.h
   include/spl/utility/Iterator.h
   include/spl/utility/MapEx.h
@@ -234,9 +252,11 @@ set(sslib_Header_Files__utility
   include/spl/utility/MultiRange.h
   include/spl/utility/NamedProperty.h
   include/spl/utility/Outcome.h
+  include/spl/utility/PoolAllocated.h
   include/spl/utility/PromotableType.h
   include/spl/utility/Range.h
   include/spl/utility/SharedHandle.h
+  include/spl/utility/SimilarityIndex.h
   include/spl/utility/SortedDistanceComparator.h
   include/spl/utility/SortedDistanceComparatorEx.h
   include/spl/utility/StableComparison.h
@@ -299,6 +319,7 @@ set(sslib_Header_Files
   ${sslib_Header_Files__analysis__detail}
   ${sslib_Header_Files__build_cell}
   ${sslib_Header_Files__common}
+  ${sslib_Header_Files__common__detail}
   ${sslib_Header_Files__common__event}
   ${sslib_Header_Files__factory}
   ${sslib_Header_Files__factory__detail}
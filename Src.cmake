@@ -7,6 +7,7 @@ set(sslib_Source_Files__analysis
   src/analysis/DynamicConvexHullGenerator.cpp
   src/analysis/GnuplotConvexHullPlotter.cpp
   src/analysis/Histogram.cpp
+  src/analysis/RadialDistribution.cpp
   src/analysis/SpaceGroup.cpp
   src/analysis/StructureConvexHullInfoSupplier.cpp
   src/analysis/StructureTriangulation.cpp
@@ -23,6 +24,7 @@ set(sslib_Source_Files__build_cell
   src/build_cell/GenCylinder.cpp
   src/build_cell/GeneratorShape.cpp
   src/build_cell/GenSphere.cpp
+  src/build_cell/ParallelStructureGenerator.cpp
   src/build_cell/PointGroups.cpp
   src/build_cell/PointSeparator.cpp
   src/build_cell/RandomUnitCellGenerator.cpp
@@ -45,12 +47,15 @@ set(sslib_Source_Files__common
   src/common/AtomsFormula.cpp
   src/common/AtomSpeciesDatabase.cpp
   src/common/AtomSpeciesInfo.cpp
+  src/common/CompactFormula.cpp
   src/common/Constants.cpp
   src/common/DistanceCalculatorDelegator.cpp
+  src/common/GeometrySnapshot.cpp
   src/common/OrthoCellDistanceCalculator.cpp
   src/common/ReferenceDistanceCalculator.cpp
   src/common/Structure.cpp
   src/common/StructureProperties.cpp
+  src/common/SymmetryCache.cpp
   src/common/UnitCell.cpp
   src/common/UniversalCrystalDistanceCalculator.cpp
 )
@@ -83,6 +88,7 @@ set(sslib_Source_Files__io
   src/io/Parsing.cpp
   src/io/ResourceLocator.cpp
   src/io/ResReaderWriter.cpp
+  src/io/SplIndex.cpp
   src/io/SplReaderWriter.cpp
   src/io/StructureYamlGenerator.cpp
   src/io/StructureReadWriteManager.cpp
@@ -95,6 +101,7 @@ source_group("Source Files\\io" FILES ${sslib_Source_Files__io})
 
 set(sslib_Source_Files__math
   src/math/Geometry.cpp
+  src/math/KdTree.cpp
   src/math/Matrix.cpp
   src/math/Random.cpp
   src/math/RunningStats.cpp
@@ -104,6 +111,7 @@ source_group("Source Files\\math" FILES ${sslib_Source_Files__math})
 ## os
 
 set(sslib_Source_Files__os
+  src/os/PipedProcess.cpp
   src/os/Process.cpp
 )
 source_group("Source Files\\os" FILES ${sslib_Source_Files__os})
@@ -127,10 +135,13 @@ source_group("Source Files\\potential" FILES ${sslib_Source_Files__potential})
 set(sslib_Source_Files__utility
   src/utility/Armadillo.cpp
   src/utility/DistanceMatrixComparator.cpp
+  src/utility/FingerprintComparator.cpp
   src/utility/HeterogeneousMap.cpp
   src/utility/HeterogeneousMapKey.cpp
+  src/utility/Instrumentation.cpp
   src/utility/NamedProperty.cpp
   src/utility/Outcome.cpp
+  src/utility/SimilarityIndex.cpp
   src/utility/SortedDistanceComparator.cpp
   src/utility/SortedDistanceComparatorEx.cpp
   src/utility/StableComparison.cpp
@@ -0,0 +1,76 @@
+/*
+ * ConvexHullBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#include <spl/config.h>
+
+#ifdef SPL_USE_CGAL
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <boost/bind.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <spl/analysis/ConvexHull.h>
+#include <spl/common/AtomsFormula.h>
+#include <spl/common/Structure.h>
+#include <spl/common/StructureProperties.h>
+#include <spl/math/Random.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace {
+
+void
+generateHull(const analysis::ConvexHull::EndpointLabels & endpoints,
+    const boost::ptr_vector< common::Structure> & structures)
+{
+  // The hull is generated lazily so build a fresh one each time
+  analysis::ConvexHull hull(endpoints);
+  hull.addStructures(structures.begin(), structures.end());
+  doNotOptimise(hull.getHull() ? 1.0 : 0.0);
+}
+
+}
+
+SPL_BENCHMARK(ConvexHull)
+{
+  static const size_t NUM_STRUCTURES[] =
+    { 100, 1000 };
+  static const unsigned int MAX_ATOMS = 8;
+
+  analysis::ConvexHull::EndpointLabels endpoints;
+  endpoints.push_back(common::AtomsFormula("A"));
+  endpoints.push_back(common::AtomsFormula("B"));
+
+  for(size_t n = 0; n < 2; ++n)
+  {
+    boost::ptr_vector< common::Structure> structures;
+    for(size_t i = 0; i < NUM_STRUCTURES[n]; ++i)
+    {
+      common::Structure * const structure = new common::Structure();
+      const unsigned int numA = math::randu(MAX_ATOMS);
+      for(unsigned int a = 0; a < numA; ++a)
+        structure->newAtom("A");
+      for(unsigned int b = 0; b < MAX_ATOMS - numA; ++b)
+        structure->newAtom("B");
+      structure->properties()[common::structure_properties::general::ENTHALPY] =
+          -math::randu< double>() * MAX_ATOMS;
+      structures.push_back(structure);
+    }
+
+    Params params;
+    params["structures"] = param(NUM_STRUCTURES[n]);
+    runner.run("ConvexHull/generateHull", params,
+        boost::bind(&generateHull, boost::cref(endpoints),
+            boost::cref(structures)));
+  }
+}
+
+#endif // SPL_USE_CGAL
@@ -0,0 +1,72 @@
+/*
+ * RadialDistributionBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <spl/analysis/RadialDistribution.h>
+#include <spl/common/Structure.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace {
+
+void
+calcRdf(const analysis::RadialDistribution::Settings & settings,
+    const std::vector< const common::Structure *> & structures)
+{
+  analysis::RadialDistribution rdf(settings);
+  rdf.add(structures);
+  doNotOptimise(rdf.getTotal().back());
+}
+
+}
+
+SPL_BENCHMARK(RadialDistribution)
+{
+  static const size_t NUM_ATOMS = 1000;
+  static const size_t NUM_STRUCTURES = 8;
+  static const unsigned int NUM_THREADS[] =
+    { 1, 0 };
+
+  boost::ptr_vector< common::Structure> structures;
+  std::vector< const common::Structure *> batch;
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    structures.push_back(
+        randomStructure(NUM_ATOMS, CellShape::TRICLINIC).release());
+    batch.push_back(&structures.back());
+  }
+  const std::vector< const common::Structure *> single(1, batch[0]);
+
+  analysis::RadialDistribution::Settings settings;
+  settings.cutoff = 6.0;
+  settings.binWidth = 0.05;
+
+  Params params;
+  params["atoms"] = param(NUM_ATOMS);
+  params["cutoff"] = param(settings.cutoff);
+  for(size_t t = 0; t < 2; ++t)
+  {
+    settings.numThreads = NUM_THREADS[t];
+    params["threads"] = param(settings.numThreads);
+
+    params["structures"] = param(1);
+    runner.run("RadialDistribution/single", params,
+        boost::bind(&calcRdf, settings, boost::cref(single)), 5);
+    params["structures"] = param(NUM_STRUCTURES);
+    runner.run("RadialDistribution/batch", params,
+        boost::bind(&calcRdf, settings, boost::cref(batch)), 1);
+  }
+}
@@ -0,0 +1,73 @@
+/*
+ * StructureBuilderBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <boost/bind.hpp>
+
+#include <spl/build_cell/AtomsDescription.h>
+#include <spl/build_cell/AtomsGroup.h>
+#include <spl/build_cell/BuildCellFwd.h>
+#include <spl/build_cell/GenerationOutcome.h>
+#include <spl/build_cell/RandomUnitCellGenerator.h>
+#include <spl/build_cell/StructureBuilder.h>
+#include <spl/common/AtomSpeciesDatabase.h>
+#include <spl/common/Structure.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace {
+
+void
+generate(build_cell::StructureBuilder & builder,
+    const common::AtomSpeciesDatabase & speciesDb)
+{
+  common::StructurePtr structure;
+  const build_cell::GenerationOutcome outcome = builder.generateStructure(
+      structure, speciesDb);
+  doNotOptimise(outcome.isSuccess() ? structure->getNumAtoms() : 0.0);
+}
+
+}
+
+SPL_BENCHMARK(StructureBuilder)
+{
+  static const unsigned int NUM_ATOMS[] =
+    { 8, 32 };
+
+  const common::AtomSpeciesDatabase speciesDb;
+
+  for(size_t n = 0; n < 2; ++n)
+  {
+    for(size_t periodic = 0; periodic < 2; ++periodic)
+    {
+      build_cell::StructureBuilder builder;
+      {
+        UniquePtr< build_cell::AtomsGroup>::Type atoms(
+            new build_cell::AtomsGroup());
+        atoms->insertAtoms(build_cell::AtomsDescription("Na", NUM_ATOMS[n] / 2));
+        atoms->insertAtoms(build_cell::AtomsDescription("Cl", NUM_ATOMS[n] / 2));
+        builder.addGenerator(atoms);
+      }
+      if(periodic)
+      {
+        build_cell::IUnitCellGeneratorPtr cellGenerator(
+            new build_cell::RandomUnitCellGenerator());
+        builder.setUnitCellGenerator(cellGenerator);
+      }
+
+      Params params;
+      params["shape"] = periodic ? "random_cell" : "cluster";
+      params["atoms"] = param(NUM_ATOMS[n]);
+      runner.run("StructureBuilder/generateStructure", params,
+          boost::bind(&generate, boost::ref(builder), boost::cref(speciesDb)));
+    }
+  }
+}
@@ -0,0 +1,112 @@
+/*
+ * DistanceCalculatorsBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <vector>
+
+#include <boost/bind.hpp>
+
+#include <armadillo>
+
+#include <spl/common/DistanceCalculatorDelegator.h>
+#include <spl/common/Structure.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace {
+
+void
+minImgAllPairs(const common::Structure & structure)
+{
+  const common::DistanceCalculatorDelegator & distCalc =
+      structure.getDistanceCalculator();
+  const size_t numAtoms = structure.getNumAtoms();
+  double sum = 0.0;
+  for(size_t i = 0; i < numAtoms; ++i)
+  {
+    const arma::vec3 & posI = structure.getAtom(i).getPosition();
+    for(size_t j = i + 1; j < numAtoms; ++j)
+      sum += distCalc.getDistSqMinImg(posI, structure.getAtom(j).getPosition());
+  }
+  doNotOptimise(sum);
+}
+
+void
+vecsBetweenAllPairs(const common::Structure & structure, const double cutoff)
+{
+  const common::DistanceCalculatorDelegator & distCalc =
+      structure.getDistanceCalculator();
+  const size_t numAtoms = structure.getNumAtoms();
+  std::vector< arma::vec3> vecs;
+  size_t numVecs = 0;
+  for(size_t i = 0; i < numAtoms; ++i)
+  {
+    const arma::vec3 & posI = structure.getAtom(i).getPosition();
+    for(size_t j = i; j < numAtoms; ++j)
+    {
+      vecs.clear();
+      distCalc.getVecsBetween(posI, structure.getAtom(j).getPosition(), cutoff,
+          vecs);
+      numVecs += vecs.size();
+    }
+  }
+  doNotOptimise(static_cast< double>(numVecs));
+}
+
+void
+vecsBetweenAllPairsByIndex(const common::Structure & structure,
+    const double cutoff)
+{
+  const common::DistanceCalculatorDelegator & distCalc =
+      structure.getDistanceCalculator();
+  const size_t numAtoms = structure.getNumAtoms();
+  std::vector< arma::vec3> vecs;
+  size_t numVecs = 0;
+  for(size_t i = 0; i < numAtoms; ++i)
+  {
+    for(size_t j = i; j < numAtoms; ++j)
+    {
+      vecs.clear();
+      distCalc.getVecsBetween(i, j, cutoff, vecs);
+      numVecs += vecs.size();
+    }
+  }
+  doNotOptimise(static_cast< double>(numVecs));
+}
+
+}
+
+SPL_BENCHMARK(DistanceCalculators)
+{
+  static const size_t NUM_ATOMS = 64;
+  static const double CUTOFF = 5.0;
+  static const CellShape::Value SHAPES[] =
+    { CellShape::CLUSTER, CellShape::CUBIC, CellShape::TRICLINIC };
+
+  for(size_t s = 0; s < 3; ++s)
+  {
+    const common::StructurePtr structure = randomStructure(NUM_ATOMS,
+        SHAPES[s]);
+    Params params;
+    params["shape"] = CellShape::toString(SHAPES[s]);
+    params["atoms"] = param(NUM_ATOMS);
+
+    runner.run("DistanceCalculators/getDistSqMinImg", params,
+        boost::bind(&minImgAllPairs, boost::cref(*structure)), 10);
+
+    params["cutoff"] = param(CUTOFF);
+    runner.run("DistanceCalculators/getVecsBetween", params,
+        boost::bind(&vecsBetweenAllPairs, boost::cref(*structure), CUTOFF), 5);
+    runner.run("DistanceCalculators/getVecsBetweenByIndex", params,
+        boost::bind(&vecsBetweenAllPairsByIndex, boost::cref(*structure),
+            CUTOFF), 5);
+  }
+}
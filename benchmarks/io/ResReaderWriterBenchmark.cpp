@@ -0,0 +1,85 @@
+/*
+ * ResReaderWriterBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <sstream>
+
+#include <boost/bind.hpp>
+
+#include <spl/common/Structure.h>
+#include <spl/io/ResReaderWriter.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace {
+
+void
+read(const io::ResReaderWriter & resIo, const std::string & contents)
+{
+  std::istringstream is(contents);
+  const common::StructurePtr structure = resIo.readStructure(is);
+  doNotOptimise(structure.get() ? structure->getNumAtoms() : 0.0);
+}
+
+void
+write(const io::ResReaderWriter & resIo, const common::Structure & structure)
+{
+  std::ostringstream os;
+  resIo.writeStructure(os, structure, "bench");
+  doNotOptimise(static_cast< double>(os.str().size()));
+}
+
+void
+writeMany(const io::ResReaderWriter & resIo,
+    const io::StructuresContainer & structures)
+{
+  std::ostringstream os;
+  resIo.writeStructures(os, structures);
+  doNotOptimise(static_cast< double>(os.str().size()));
+}
+
+}
+
+SPL_BENCHMARK(ResReaderWriter)
+{
+  static const size_t NUM_ATOMS[] =
+    { 16, 256 };
+
+  const io::ResReaderWriter resIo;
+
+  for(size_t n = 0; n < 2; ++n)
+  {
+    const common::StructurePtr structure = randomStructure(NUM_ATOMS[n],
+        CellShape::TRICLINIC);
+    std::ostringstream os;
+    resIo.writeStructure(os, *structure, "bench");
+    const std::string contents = os.str();
+
+    Params params;
+    params["atoms"] = param(NUM_ATOMS[n]);
+    runner.run("ResReaderWriter/readStructure", params,
+        boost::bind(&read, boost::cref(resIo), boost::cref(contents)), 10);
+    runner.run("ResReaderWriter/writeStructure", params,
+        boost::bind(&write, boost::cref(resIo), boost::cref(*structure)), 10);
+  }
+
+  // Bulk writing of many small structures to one stream
+  static const size_t NUM_STRUCTURES = 1000;
+  io::StructuresContainer structures;
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+    structures.push_back(randomStructure(16, CellShape::TRICLINIC).release());
+
+  Params params;
+  params["atoms"] = param(16);
+  params["structures"] = param(NUM_STRUCTURES);
+  runner.run("ResReaderWriter/writeStructures", params,
+      boost::bind(&writeMany, boost::cref(resIo), boost::cref(structures)));
+}
@@ -0,0 +1,107 @@
+/*
+ * PotentialsBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <boost/bind.hpp>
+
+#include <spl/common/Structure.h>
+#include <spl/potential/LennardJones.h>
+#include <spl/potential/OptimisationSettings.h>
+#include <spl/potential/PotentialData.h>
+#include <spl/potential/TpsdGeomOptimiser.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace {
+
+static const CellShape::Value SHAPES[] =
+  { CellShape::CLUSTER, CellShape::CUBIC, CellShape::TRICLINIC };
+
+void
+addInteractions(potential::LennardJones * const lj)
+{
+  lj->addInteraction(SpeciesPair("A"), 1.0, 1.0, 12, 6, 2.5);
+}
+
+void
+evaluateLj(const potential::LennardJones & lj,
+    const common::Structure & structure)
+{
+  potential::PotentialData data(structure.getNumAtoms());
+  lj.evaluate(structure, data);
+  doNotOptimise(data.internalEnergy);
+}
+
+void
+relax(const potential::TpsdGeomOptimiser & optimiser,
+    const common::Structure & structure,
+    const potential::OptimisationSettings & settings)
+{
+  // Always start from the same structure
+  common::Structure toRelax(structure);
+  optimiser.optimise(toRelax, settings);
+  doNotOptimise(toRelax.getAtom(0).getPosition()(0));
+}
+
+}
+
+SPL_BENCHMARK(LennardJones)
+{
+  static const size_t NUM_ATOMS[] =
+    { 16, 64, 256 };
+
+  potential::LennardJones lj;
+  addInteractions(&lj);
+
+  for(size_t s = 0; s < 3; ++s)
+  {
+    for(size_t n = 0; n < 3; ++n)
+    {
+      const common::StructurePtr structure = randomStructure(NUM_ATOMS[n],
+          SHAPES[s]);
+      Params params;
+      params["shape"] = CellShape::toString(SHAPES[s]);
+      params["atoms"] = param(NUM_ATOMS[n]);
+      runner.run("LennardJones/evaluate", params,
+          boost::bind(&evaluateLj, boost::cref(lj), boost::cref(*structure)),
+          256 / NUM_ATOMS[n]);
+    }
+  }
+}
+
+SPL_BENCHMARK(TpsdGeomOptimiser)
+{
+  static const size_t NUM_ATOMS[] =
+    { 8, 32 };
+
+  potential::LennardJones * const lj = new potential::LennardJones();
+  addInteractions(lj);
+  const potential::TpsdGeomOptimiser optimiser(
+      (potential::TpsdGeomOptimiser::PotentialPtr(lj)));
+
+  potential::OptimisationSettings settings;
+  settings.maxIter = 2000;
+
+  for(size_t s = 0; s < 3; ++s)
+  {
+    for(size_t n = 0; n < 2; ++n)
+    {
+      const common::StructurePtr structure = randomStructure(NUM_ATOMS[n],
+          SHAPES[s]);
+      Params params;
+      params["shape"] = CellShape::toString(SHAPES[s]);
+      params["atoms"] = param(NUM_ATOMS[n]);
+      runner.run("TpsdGeomOptimiser/optimise", params,
+          boost::bind(&relax, boost::cref(optimiser), boost::cref(*structure),
+              boost::cref(settings)));
+    }
+  }
+}
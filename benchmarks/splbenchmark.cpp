@@ -0,0 +1,292 @@
+/*
+ * splbenchmark.cpp
+ *
+ * Usage: spl_benchmarks [--filter <substring>] [--repeats <n>] [--out <file>]
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/foreach.hpp>
+
+#include <armadillo>
+
+#include <spl/SSLib.h>
+#include <spl/common/Structure.h>
+#include <spl/common/UnitCell.h>
+#include <spl/math/Random.h>
+#include <spl/version.h>
+
+namespace {
+// Benchmarks are single threaded so a plain counter will do
+unsigned long numAllocations = 0;
+}
+
+void *
+operator new(::std::size_t size)
+{
+  ++numAllocations;
+  void * const ptr = ::std::malloc(size == 0 ? 1 : size);
+  if(!ptr)
+    throw ::std::bad_alloc();
+  return ptr;
+}
+
+void
+operator delete(void * ptr) throw ()
+{
+  ::std::free(ptr);
+}
+
+namespace spl {
+namespace benchmark {
+
+namespace {
+
+volatile double sink;
+
+void
+writeJsonString(::std::ostream & os, const ::std::string & str)
+{
+  os << '"';
+  BOOST_FOREACH(const char c, str)
+  {
+    if(c == '"' || c == '\\')
+      os << '\\';
+    os << c;
+  }
+  os << '"';
+}
+
+}
+
+Runner::Runner(const unsigned int repeats) :
+    myRepeats(::std::max(1u, repeats))
+{
+}
+
+void
+Runner::run(const ::std::string & name, const Params & params,
+    const ::boost::function< void()> & fn, const unsigned int iterations)
+{
+  namespace pt = ::boost::posix_time;
+
+  Result result;
+  result.name = name;
+  result.params = params;
+  result.iterations = ::std::max(1u, iterations);
+  result.allocations = 0.0;
+
+  // One untimed call to warm up caches
+  fn();
+
+  for(unsigned int r = 0; r < myRepeats; ++r)
+  {
+    const unsigned long allocationsStart = numAllocations;
+    const pt::ptime start = pt::microsec_clock::universal_time();
+    for(unsigned int i = 0; i < result.iterations; ++i)
+      fn();
+    const pt::time_duration elapsed = pt::microsec_clock::universal_time()
+        - start;
+    result.times.push_back(
+        static_cast< double>(elapsed.total_microseconds()) * 1e-6
+            / static_cast< double>(result.iterations));
+    if(r == 0)
+      result.allocations = static_cast< double>(numAllocations
+          - allocationsStart) / static_cast< double>(result.iterations);
+  }
+
+  ::std::cerr << name;
+  BOOST_FOREACH(const Params::const_reference p, params)
+    ::std::cerr << " " << p.first << "=" << p.second;
+  ::std::cerr << ": " << *::std::min_element(result.times.begin(),
+      result.times.end()) << " s, " << result.allocations << " allocs\n";
+
+  myResults.push_back(result);
+}
+
+void
+Runner::addMetric(const ::std::string & name, const double value)
+{
+  SSLIB_ASSERT(!myResults.empty());
+
+  ::std::cerr << "  " << name << ": " << value << "\n";
+  myResults.back().metrics[name] = value;
+}
+
+void
+Runner::writeJson(::std::ostream & os) const
+{
+  os << ::std::setprecision(9);
+  os << "{\n  \"version\": \"" << SPL_VERSION_MAJOR << "."
+      << SPL_VERSION_MINOR << "." << SPL_VERSION_PATCH << "\"";
+  os << ",\n  \"repeats\": " << myRepeats << ",\n  \"benchmarks\": [";
+  for(size_t i = 0; i < myResults.size(); ++i)
+  {
+    const Result & result = myResults[i];
+    ::std::vector< double> sorted(result.times);
+    ::std::sort(sorted.begin(), sorted.end());
+    double mean = 0.0;
+    BOOST_FOREACH(const double t, sorted)
+      mean += t;
+    mean /= static_cast< double>(sorted.size());
+
+    os << (i == 0 ? "\n" : ",\n") << "    {\n      \"name\": ";
+    writeJsonString(os, result.name);
+    os << ",\n      \"params\": {";
+    for(Params::const_iterator it = result.params.begin();
+        it != result.params.end(); ++it)
+    {
+      os << (it == result.params.begin() ? "" : ", ");
+      writeJsonString(os, it->first);
+      os << ": ";
+      writeJsonString(os, it->second);
+    }
+    os << "},\n      \"iterations\": " << result.iterations
+        << ",\n      \"min_s\": " << sorted.front()
+        << ",\n      \"median_s\": " << sorted[sorted.size() / 2]
+        << ",\n      \"mean_s\": " << mean << ",\n      \"max_s\": "
+        << sorted.back() << ",\n      \"allocations\": "
+        << result.allocations;
+    if(!result.metrics.empty())
+    {
+      os << ",\n      \"metrics\": {";
+      for(Metrics::const_iterator it = result.metrics.begin();
+          it != result.metrics.end(); ++it)
+      {
+        os << (it == result.metrics.begin() ? "" : ", ");
+        writeJsonString(os, it->first);
+        os << ": " << it->second;
+      }
+      os << "}";
+    }
+    os << "\n    }";
+  }
+  os << "\n  ]\n}\n";
+}
+
+Registry &
+registry()
+{
+  static Registry benchmarks;
+  return benchmarks;
+}
+
+Registrar::Registrar(const char * const name, const BenchmarkFunction function)
+{
+  registry().push_back(::std::make_pair(::std::string(name), function));
+}
+
+void
+doNotOptimise(const double value)
+{
+  sink = value;
+}
+
+const char *
+CellShape::toString(const Value shape)
+{
+  switch(shape)
+  {
+  case CLUSTER:
+    return "cluster";
+  case CUBIC:
+    return "cubic";
+  case TRICLINIC:
+    return "triclinic";
+  default:
+    return "unknown";
+  }
+}
+
+common::StructurePtr
+randomStructure(const size_t numAtoms, const CellShape::Value shape,
+    const double volPerAtom, const ::std::string & species)
+{
+  const double volume = volPerAtom * static_cast< double>(numAtoms);
+  common::StructurePtr structure(new common::Structure());
+  if(shape == CellShape::CUBIC)
+    structure->setUnitCell(common::UnitCell(1.0, 1.0, 1.0, 90.0, 90.0, 90.0));
+  else if(shape == CellShape::TRICLINIC)
+    structure->setUnitCell(common::UnitCell(1.0, 1.3, 0.8, 70.0, 80.0, 100.0));
+
+  if(common::UnitCell * const cell = structure->getUnitCell())
+    cell->setVolume(volume);
+
+  // Use our own generator rather than armadillo's so that we control the seed
+  const double side = ::std::pow(volume, 1.0 / 3.0);
+  ::arma::vec3 pos;
+  for(size_t i = 0; i < numAtoms; ++i)
+  {
+    for(size_t d = 0; d < 3; ++d)
+      pos(d) = math::randu< double>();
+    if(const common::UnitCell * const cell = structure->getUnitCell())
+      cell->fracToCartInplace(pos);
+    else
+      pos *= side;
+    structure->newAtom(species).setPosition(pos);
+  }
+  return structure;
+}
+
+}
+}
+
+int
+main(int argc, char * argv[])
+{
+  namespace bench = ::spl::benchmark;
+
+  ::std::string filter, outFile;
+  unsigned int repeats = 5;
+  for(int i = 1; i < argc; ++i)
+  {
+    const ::std::string arg(argv[i]);
+    if(arg == "--filter" && i + 1 < argc)
+      filter = argv[++i];
+    else if(arg == "--repeats" && i + 1 < argc)
+      repeats = ::boost::lexical_cast< unsigned int>(argv[++i]);
+    else if(arg == "--out" && i + 1 < argc)
+      outFile = argv[++i];
+    else
+    {
+      ::std::cerr << "Usage: " << argv[0]
+          << " [--filter <substring>] [--repeats <n>] [--out <file>]\n";
+      return 1;
+    }
+  }
+
+  bench::Runner runner(repeats);
+  BOOST_FOREACH(const bench::Registry::const_reference benchmark,
+      bench::registry())
+  {
+    if(!filter.empty() && benchmark.first.find(filter) == ::std::string::npos)
+      continue;
+
+    // Seed before each so results don't depend on which others were run
+    ::spl::math::seed(bench::SEED);
+    benchmark.second(runner);
+  }
+
+  if(outFile.empty())
+    runner.writeJson(::std::cout);
+  else
+  {
+    ::std::ofstream os(outFile.c_str());
+    runner.writeJson(os);
+  }
+
+  return 0;
+}
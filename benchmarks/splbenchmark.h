@@ -0,0 +1,126 @@
+/*
+ * splbenchmark.h
+ *
+ * A minimal benchmark harness.  Benchmarks are registered with
+ * SPL_BENCHMARK(Name) and time their hot paths through the Runner which
+ * collects the results and writes them out as JSON.  The harness replaces the
+ * global operator new so that the number of heap allocations per iteration
+ * is recorded alongside the times.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef SPL_BENCHMARK_H
+#define SPL_BENCHMARK_H
+
+// INCLUDES //////////////////////////////////
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <spl/common/Types.h>
+
+namespace spl {
+namespace common {
+class Structure;
+}
+
+namespace benchmark {
+
+// All benchmarks are run with the random number generator seeded with this
+static const unsigned int SEED = 1234567;
+
+typedef ::std::map< ::std::string, ::std::string> Params;
+typedef ::std::map< ::std::string, double> Metrics;
+
+class Runner
+{
+public:
+  struct Result
+  {
+    ::std::string name;
+    Params params;
+    unsigned int iterations;
+    // Wall time per iteration (in seconds) for each repeat
+    ::std::vector< double> times;
+    // Calls to operator new per iteration (taken from the first repeat)
+    double allocations;
+    // Any other figures the benchmark reports about what it measured
+    Metrics metrics;
+  };
+
+  Runner(const unsigned int repeats);
+
+  // Time calling fn iterations times, this is repeated a number of times and
+  // statistics of the time per iteration are recorded
+  void
+  run(const ::std::string & name, const Params & params,
+      const ::boost::function< void()> & fn, const unsigned int iterations = 1);
+  // Attach a figure to the result of the last run
+  void
+  addMetric(const ::std::string & name, const double value);
+
+  void
+  writeJson(::std::ostream & os) const;
+
+private:
+  const unsigned int myRepeats;
+  ::std::vector< Result> myResults;
+};
+
+typedef void
+(*BenchmarkFunction)(Runner & runner);
+typedef ::std::vector< ::std::pair< ::std::string, BenchmarkFunction> > Registry;
+
+Registry &
+registry();
+
+struct Registrar
+{
+  Registrar(const char * const name, const BenchmarkFunction function);
+};
+
+// Make sure the compiler can't throw away a result that isn't used
+void
+doNotOptimise(const double value);
+
+template< typename T>
+  ::std::string
+  param(const T & value)
+  {
+    return ::boost::lexical_cast< ::std::string>(value);
+  }
+
+// STRUCTURE GENERATION ///////////////////////
+
+struct CellShape
+{
+  enum Value
+  {
+    CLUSTER, CUBIC, TRICLINIC
+  };
+  static const char *
+  toString(const Value shape);
+};
+
+// Generate numAtoms atoms of the given species placed randomly in a cell of
+// the given shape at volPerAtom, clusters are placed in a cube of that volume
+common::StructurePtr
+randomStructure(const size_t numAtoms, const CellShape::Value shape,
+    const double volPerAtom = 1.5, const ::std::string & species = "A");
+
+}
+}
+
+#define SPL_BENCHMARK(NAME) \
+  static void NAME(::spl::benchmark::Runner & runner); \
+  static const ::spl::benchmark::Registrar NAME##Registrar(#NAME, &NAME); \
+  static void NAME(::spl::benchmark::Runner & runner)
+
+#endif /* SPL_BENCHMARK_H */
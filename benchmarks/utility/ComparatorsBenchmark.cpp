@@ -0,0 +1,337 @@
+/*
+ * ComparatorsBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/foreach.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <armadillo>
+
+#include <spl/common/Atom.h>
+#include <spl/common/Structure.h>
+#include <spl/common/UnitCell.h>
+#include <spl/io/ResReaderWriter.h>
+#include <spl/math/Random.h>
+#include <spl/utility/DistanceMatrixComparator.h>
+#include <spl/utility/FingerprintComparator.h>
+#include <spl/utility/IBufferedComparator.h>
+#include <spl/utility/Instrumentation.h>
+#include <spl/utility/SortedDistanceComparator.h>
+#include <spl/utility/UniqueStructureSet.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+namespace fs = boost::filesystem;
+
+namespace {
+
+typedef std::vector< utility::IBufferedComparator::ComparisonDataHandle> Handles;
+
+static const CellShape::Value SHAPES[] =
+  { CellShape::CLUSTER, CellShape::CUBIC, CellShape::TRICLINIC };
+
+void
+compare(const utility::IStructureComparator & comparator,
+    const common::Structure & str1, const common::Structure & str2)
+{
+  doNotOptimise(comparator.compareStructures(str1, str2));
+}
+
+// What the comparators do to each structure they're given
+void
+copyStructure(const common::Structure & structure)
+{
+  const common::StructurePtr copy(new common::Structure(structure));
+  doNotOptimise(static_cast< double>(copy->getNumAtoms()));
+}
+
+void
+compareData(const utility::FingerprintComparator & comparator,
+    const utility::FingerprintComparisonData & data1,
+    const utility::FingerprintComparisonData & data2)
+{
+  doNotOptimise(comparator.compareStructures(data1, data2));
+}
+
+void
+similarData(utility::IBufferedComparator & comparator,
+    const utility::IBufferedComparator::ComparisonDataHandle & data1,
+    const utility::IBufferedComparator::ComparisonDataHandle & data2)
+{
+  doNotOptimise(comparator.areSimilar(data1, data2) ? 1.0 : 0.0);
+}
+
+size_t
+countSimilar(utility::IBufferedComparator & comparator, const Handles & handles)
+{
+  size_t numSimilar = 0;
+  for(size_t i = 0; i < handles.size(); ++i)
+  {
+    for(size_t j = i + 1; j < handles.size(); ++j)
+    {
+      if(comparator.areSimilar(handles[i], handles[j]))
+        ++numSimilar;
+    }
+  }
+  return numSimilar;
+}
+
+void
+allPairsSimilar(utility::IBufferedComparator & comparator,
+    const Handles & handles)
+{
+  doNotOptimise(static_cast< double>(countSimilar(comparator, handles)));
+}
+
+// The full comparison, i.e. without a threshold to stop early at
+void
+allPairsCompare(utility::IBufferedComparator & comparator,
+    const Handles & handles)
+{
+  double total = 0.0;
+  for(size_t i = 0; i < handles.size(); ++i)
+  {
+    for(size_t j = i + 1; j < handles.size(); ++j)
+      total += comparator.compareStructures(handles[i], handles[j]);
+  }
+  doNotOptimise(total);
+}
+
+void
+readResFiles(const fs::path & dir, io::StructuresContainer & structures)
+{
+  if(!fs::is_directory(dir))
+    return;
+
+  std::vector< fs::path> files;
+  for(fs::directory_iterator it(dir), end; it != end; ++it)
+  {
+    if(fs::is_regular_file(it->status()) && it->path().extension() == ".res")
+      files.push_back(it->path());
+  }
+  // Directory order isn't defined
+  std::sort(files.begin(), files.end());
+
+  const io::ResReaderWriter resIo;
+  BOOST_FOREACH(const fs::path & file, files)
+    resIo.readStructures(structures, file);
+}
+
+// Move each atom the given distance in a random direction
+common::StructurePtr
+shake(const common::Structure & structure, const double distance)
+{
+  common::StructurePtr shaken(new common::Structure(structure));
+  arma::vec3 dr;
+  for(size_t i = 0; i < shaken->getNumAtoms(); ++i)
+  {
+    for(size_t d = 0; d < 3; ++d)
+      dr(d) = math::randn< double>();
+    common::Atom & atom = shaken->getAtom(i);
+    dr *= distance / arma::norm(dr, 2);
+    dr += atom.getPosition();
+    atom.setPosition(dr);
+  }
+  return shaken;
+}
+
+void
+insertAll(const utility::IStructureComparator & comparator,
+    boost::ptr_vector< common::Structure> & structures)
+{
+  utility::UniqueStructureSet< > unique(comparator);
+  for(size_t i = 0; i < structures.size(); ++i)
+    unique.insert(&structures[i]);
+  doNotOptimise(static_cast< double>(unique.size()));
+}
+
+}
+
+SPL_BENCHMARK(Comparators)
+{
+  static const size_t NUM_ATOMS = 16;
+
+  const utility::SortedDistanceComparator sortedDist;
+  const utility::DistanceMatrixComparator distMatrix(NUM_ATOMS);
+  const utility::FingerprintComparator fingerprint;
+
+  for(size_t s = 0; s < 3; ++s)
+  {
+    const common::StructurePtr str1 = randomStructure(NUM_ATOMS, SHAPES[s]);
+    const common::StructurePtr str2 = randomStructure(NUM_ATOMS, SHAPES[s]);
+    Params params;
+    params["shape"] = CellShape::toString(SHAPES[s]);
+    params["atoms"] = param(NUM_ATOMS);
+
+    runner.run("Structure/copy", params,
+        boost::bind(&copyStructure, boost::cref(*str1)), 1000);
+    runner.run("SortedDistanceComparator/compareStructures", params,
+        boost::bind(&compare, boost::cref(sortedDist), boost::cref(*str1),
+            boost::cref(*str2)), 10);
+    runner.run("DistanceMatrixComparator/compareStructures", params,
+        boost::bind(&compare, boost::cref(distMatrix), boost::cref(*str1),
+            boost::cref(*str2)));
+    runner.run("FingerprintComparator/compareStructures", params,
+        boost::bind(&compare, boost::cref(fingerprint), boost::cref(*str1),
+            boost::cref(*str2)), 10);
+
+    // Comparing precomputed fingerprints is what a buffered comparator does
+    const utility::FingerprintComparator::ComparisonDataPtr data1 =
+        fingerprint.generateComparisonData(*str1);
+    const utility::FingerprintComparator::ComparisonDataPtr data2 =
+        fingerprint.generateComparisonData(*str2);
+    runner.run("FingerprintComparator/compareData", params,
+        boost::bind(&compareData, boost::cref(fingerprint),
+            boost::cref(*data1), boost::cref(*data2)), 1000000);
+
+    // Dissimilar structures let the thresholded comparison stop early while
+    // a structure compared with itself has to go through all the data
+    const boost::shared_ptr< utility::IBufferedComparator> buffered[] =
+      { sortedDist.generateBuffered(), distMatrix.generateBuffered() };
+    const char * const names[] =
+      { "SortedDistanceComparator/areSimilarData",
+          "DistanceMatrixComparator/areSimilarData" };
+    for(size_t c = 0; c < 2; ++c)
+    {
+      const utility::IBufferedComparator::ComparisonDataHandle handle1 =
+          buffered[c]->generateComparisonData(*str1);
+      const utility::IBufferedComparator::ComparisonDataHandle handle2 =
+          buffered[c]->generateComparisonData(*str2);
+      Params pairParams = params;
+      pairParams["pair"] = "dissimilar";
+      runner.run(names[c], pairParams,
+          boost::bind(&similarData, boost::ref(*buffered[c]),
+              boost::cref(handle1), boost::cref(handle2)), 10000);
+      pairParams["pair"] = "identical";
+      runner.run(names[c], pairParams,
+          boost::bind(&similarData, boost::ref(*buffered[c]),
+              boost::cref(handle1), boost::cref(handle1)), 10000);
+    }
+  }
+}
+
+SPL_BENCHMARK(UniqueStructureSet)
+{
+  static const size_t NUM_ATOMS = 8;
+  static const size_t NUM_STRUCTURES = 50;
+
+  const utility::SortedDistanceComparator comparator;
+
+  for(size_t s = 1; s < 3; ++s)
+  {
+    boost::ptr_vector< common::Structure> structures;
+    for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+      structures.push_back(randomStructure(NUM_ATOMS, SHAPES[s]).release());
+
+    Params params;
+    params["shape"] = CellShape::toString(SHAPES[s]);
+    params["atoms"] = param(NUM_ATOMS);
+    params["structures"] = param(NUM_STRUCTURES);
+    runner.run("UniqueStructureSet/insert", params,
+        boost::bind(&insertAll, boost::cref(comparator),
+            boost::ref(structures)));
+  }
+}
+
+// How much work the thresholded comparisons skip on real structures.  The
+// fraction skipped is read from the comparators' instrumentation and timing
+// the full comparison alongside areSimilar shows what skipping it saves.
+SPL_BENCHMARK(ComparatorsDataset)
+{
+  static const size_t NUM_SUBSET = 100;
+  static const double SHAKE_DISTANCE = 0.1;
+
+  io::StructuresContainer similar;
+  readResFiles(SPL_BENCHMARK_INPUT_DIR "/utility/input/similarStructures",
+      similar);
+  if(similar.empty())
+  {
+    std::cerr << "ComparatorsDataset: no structures found, skipping\n";
+    return;
+  }
+
+  // The same structures shaken so they are no longer similar and, for
+  // reference, random ones at the same density
+  io::StructuresContainer shaken, random;
+  const double volPerAtom = similar[0].getUnitCell()->getVolume()
+      / static_cast< double>(similar[0].getNumAtoms());
+  for(size_t i = 0; i < std::min(NUM_SUBSET, similar.size()); ++i)
+  {
+    shaken.push_back(shake(similar[i], SHAKE_DISTANCE).release());
+    random.push_back(
+        randomStructure(similar[i].getNumAtoms(), CellShape::CUBIC,
+            volPerAtom).release());
+  }
+  const io::StructuresContainer * const datasets[] =
+    { &similar, &shaken, &random };
+  const char * const datasetNames[] =
+    { "similarStructures", "shaken", "random" };
+
+  const utility::SortedDistanceComparator sortedDist;
+  const utility::DistanceMatrixComparator distMatrix;
+  const utility::IStructureComparator * const comparators[] =
+    { &sortedDist, &distMatrix };
+  const std::string names[] =
+    { "SortedDistanceComparator", "DistanceMatrixComparator" };
+  const char * const skippedNames[] =
+    { "utility.SortedDistanceComparator.fractionSkipped",
+        "utility.DistanceMatrixComparator.fractionSkipped" };
+
+  for(size_t d = 0; d < 3; ++d)
+  {
+    const io::StructuresContainer & structures = *datasets[d];
+    const double numPairs = 0.5 * static_cast< double>(structures.size())
+        * static_cast< double>(structures.size() - 1);
+    Params params;
+    params["dataset"] = datasetNames[d];
+    params["structures"] = param(structures.size());
+
+    for(size_t c = 0; c < 2; ++c)
+    {
+      const boost::shared_ptr< utility::IBufferedComparator> buffered =
+          comparators[c]->generateBuffered();
+      Handles handles;
+      BOOST_FOREACH(const common::Structure & structure, structures)
+        handles.push_back(buffered->generateComparisonData(structure));
+
+      runner.run(names[c] + "/allPairsCompare", params,
+          boost::bind(&allPairsCompare, boost::ref(*buffered),
+              boost::cref(handles)));
+      runner.run(names[c] + "/allPairsSimilar", params,
+          boost::bind(&allPairsSimilar, boost::ref(*buffered),
+              boost::cref(handles)));
+
+      // Count the skipped work in a separate pass so the timings above don't
+      // include the cost of recording it
+      const bool wasEnabled = utility::instrumentation::isEnabled();
+      utility::instrumentation::reset();
+      utility::instrumentation::setEnabled(true);
+      const size_t numSimilar = countSimilar(*buffered, handles);
+      utility::instrumentation::setEnabled(wasEnabled);
+
+      runner.addMetric("fractionSimilar",
+          static_cast< double>(numSimilar) / numPairs);
+      const utility::instrumentation::Report report =
+          utility::instrumentation::getReport();
+      const utility::instrumentation::Report::Histograms::const_iterator it =
+          report.histograms.find(skippedNames[c]);
+      if(it != report.histograms.end() && it->second.count != 0)
+        runner.addMetric("fractionSkipped",
+            it->second.sum / static_cast< double>(it->second.count));
+    }
+  }
+}
@@ -0,0 +1,85 @@
+/*
+ * HeterogeneousMapBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <sstream>
+
+#include <boost/bind.hpp>
+
+#include <spl/common/Structure.h>
+#include <spl/common/StructureProperties.h>
+#include <spl/io/ResReaderWriter.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace properties = spl::common::structure_properties;
+
+namespace {
+
+void
+setProperties(common::Structure * const structure)
+{
+  utility::HeterogeneousMap & props = structure->properties();
+  props[properties::general::ENERGY_INTERNAL] = -10.0;
+  props[properties::general::ENTHALPY] = -9.5;
+  props[properties::general::PRESSURE] = 1.0;
+  props[properties::general::SPACEGROUP_SYMBOL] = "P1";
+  props[properties::general::SPACEGROUP_NUMBER] = 1;
+  props[properties::searching::TIMES_FOUND] = 1;
+}
+
+void
+readWriteProperties(common::Structure & structure)
+{
+  setProperties(&structure);
+  const utility::HeterogeneousMap & props = structure.properties();
+  doNotOptimise(
+      *props.find(properties::general::ENERGY_INTERNAL)
+          + *props.find(properties::general::ENTHALPY)
+          + *props.find(properties::general::PRESSURE));
+}
+
+void
+copyProperties(const common::Structure & structure)
+{
+  const utility::HeterogeneousMap copy(structure.properties());
+  doNotOptimise(static_cast< double>(copy.size()));
+}
+
+void
+write(const io::ResReaderWriter & resIo, const common::Structure & structure)
+{
+  std::ostringstream os;
+  resIo.writeStructure(os, structure, "bench");
+  doNotOptimise(static_cast< double>(os.str().size()));
+}
+
+}
+
+SPL_BENCHMARK(HeterogeneousMap)
+{
+  const common::StructurePtr structure = randomStructure(16,
+      CellShape::TRICLINIC);
+  setProperties(structure.get());
+
+  Params params;
+  runner.run("HeterogeneousMap/readWrite", params,
+      boost::bind(&readWriteProperties, boost::ref(*structure)), 100000);
+  runner.run("HeterogeneousMap/copy", params,
+      boost::bind(&copyProperties, boost::cref(*structure)), 100000);
+
+  // Writing res files touches several properties per structure
+  const io::ResReaderWriter resIo;
+  params["atoms"] = param(structure->getNumAtoms());
+  runner.run("HeterogeneousMap/writeRes", params,
+      boost::bind(&write, boost::cref(resIo), boost::cref(*structure)),
+      100000);
+}
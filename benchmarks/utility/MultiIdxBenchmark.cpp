@@ -0,0 +1,67 @@
+/*
+ * MultiIdxBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "splbenchmark.h"
+
+#include <boost/bind.hpp>
+
+#include <spl/utility/MultiArray.h>
+#include <spl/utility/MultiIdx.h>
+#include <spl/utility/MultiIdxRange.h>
+
+// NAMESPACES ////////////////////////////////
+using namespace spl;
+using namespace spl::benchmark;
+
+namespace {
+
+static const size_t GRID_DIMS = 4;
+static const size_t GRID_EXTENT = 12;
+
+// Visit every point of the grid, summing the array values
+template< typename Integer, size_t Dims>
+  void
+  iterateGrid(const utility::MultiIdxRange< Integer, Dims> & range,
+      const utility::MultiArray< double, Dims> & array)
+  {
+    typedef typename utility::MultiIdxRange< Integer, Dims>::const_iterator
+        Iterator;
+
+    double sum = 0.0;
+    for(Iterator it = range.begin(), end = range.end(); it != end; ++it)
+      sum += array[*it];
+    doNotOptimise(sum);
+  }
+
+}
+
+SPL_BENCHMARK(MultiIdx)
+{
+  typedef utility::MultiIdx< size_t> DynamicIdx;
+  typedef utility::MultiIdx< size_t, GRID_DIMS> FixedIdx;
+
+  const FixedIdx fixedExtents(GRID_EXTENT);
+  const DynamicIdx dynamicExtents = fixedExtents.toDynamic();
+
+  const utility::MultiIdxRange< size_t> dynamicRange(DynamicIdx(GRID_DIMS),
+      dynamicExtents);
+  const utility::MultiArray< double> dynamicArray(dynamicExtents, 1.0);
+  const utility::MultiIdxRange< size_t, GRID_DIMS> fixedRange(FixedIdx(),
+      fixedExtents);
+  const utility::MultiArray< double, GRID_DIMS> fixedArray(fixedExtents, 1.0);
+
+  Params params;
+  params["dims"] = param(GRID_DIMS);
+  params["points"] = param(fixedExtents.product());
+  runner.run("MultiIdx/iterateGrid/dynamic", params,
+      boost::bind(&iterateGrid< size_t, 0>, boost::cref(dynamicRange),
+          boost::cref(dynamicArray)), 1000);
+  runner.run("MultiIdx/iterateGrid/fixed", params,
+      boost::bind(&iterateGrid< size_t, GRID_DIMS>, boost::cref(fixedRange),
+          boost::cref(fixedArray)), 1000);
+}
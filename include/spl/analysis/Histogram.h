@@ -46,7 +46,13 @@ public:
   void insert(const double value);
   template <class InputIterator>
   void insert(InputIterator first, const InputIterator last);
+  // Bulk insert from contiguous memory, the bins are grown once up front
+  void insert(const double * const values, const size_t n);
+  // Add the counts from another histogram, e.g. one filled on another
+  // thread.  Throws if the bin widths differ.
+  void merge(const Histogram & other);
   void clear();
+  double getBinWidth() const;
   size_t numBins() const;
   unsigned int getFrequency(const size_t bin) const;
 
@@ -61,7 +67,7 @@ public:
 private:
 
   void ensureEnoughBins(const unsigned int binIndex);
-  size_t binIndex(const double value);
+  size_t binIndex(const double value) const;
   int getFullestBin() const;
 
 
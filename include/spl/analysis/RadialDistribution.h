@@ -0,0 +1,130 @@
+/*
+ * RadialDistribution.h
+ *
+ * Total and species resolved (partial) radial distribution functions, g(r),
+ * averaged over one or more structures.  Pairs within the cutoff are found
+ * with a k-d tree over the atoms and those of their periodic images that lie
+ * within the cutoff of the unit cell.  Pair distances are binned into
+ * histograms owned by each worker thread that are merged at the end.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef RADIAL_DISTRIBUTION_H
+#define RADIAL_DISTRIBUTION_H
+
+// INCLUDES ////////////
+#include "spl/SSLib.h"
+
+#include <utility>
+#include <vector>
+
+#include <boost/ptr_container/ptr_map.hpp>
+
+#include "spl/analysis/Histogram.h"
+#include "spl/common/AtomSpeciesId.h"
+
+// DEFINITION ///////////////////////
+
+namespace spl {
+
+// FORWARD DECLARATIONS ///////
+namespace common {
+class Structure;
+}
+
+namespace analysis {
+
+class RadialDistribution
+{
+public:
+  typedef ::std::vector< common::AtomSpeciesId::Value> SpeciesList;
+  typedef ::std::vector< double> Distribution;
+
+  struct Settings
+  {
+    Settings();
+
+    double cutoff;
+    double binWidth;
+    // 0 means use the number of hardware threads
+    unsigned int numThreads;
+  };
+
+  explicit
+  RadialDistribution(const Settings & settings = Settings());
+
+  // Add the pairs from one structure, the work is split over its atoms
+  void
+  add(const common::Structure & structure);
+  // Add a batch of structures, the work is split over the structures
+  void
+  add(const ::std::vector< const common::Structure *> & structures);
+  template< class InputIterator>
+    void
+    add(InputIterator first, const InputIterator last);
+
+  void
+  clear();
+
+  size_t
+  numBins() const;
+  size_t
+  numStructures() const;
+
+  // The centre of each bin
+  Distribution
+  getRadii() const;
+  // g(r) over all pairs of atoms
+  Distribution
+  getTotal() const;
+
+  // All the species seen so far in sorted order, partial distributions are
+  // indexed by position in this list
+  const SpeciesList &
+  getSpecies() const;
+  Distribution
+  getPartial(const size_t speciesA, const size_t speciesB) const;
+
+private:
+  typedef ::std::pair< common::AtomSpeciesId::Value,
+      common::AtomSpeciesId::Value> SpeciesPair;
+
+  struct PairData
+  {
+    explicit
+    PairData(const double binWidth);
+
+    // Counts for both orderings of the pair
+    Histogram counts;
+    // Sum over structures of the expected number of pairs per unit volume
+    double norm;
+  };
+  typedef ::boost::ptr_map< SpeciesPair, PairData> Pairs;
+
+  void
+  addSpecies(const SpeciesList & species);
+  Distribution
+  normalise(const Histogram & counts, const double norm) const;
+
+  const Settings mySettings;
+  SpeciesList mySpecies;
+  Pairs myPairs;
+  size_t myNumStructures;
+};
+
+template< class InputIterator>
+  void
+  RadialDistribution::add(InputIterator first, const InputIterator last)
+  {
+    ::std::vector< const common::Structure *> structures;
+    for(; first != last; ++first)
+      structures.push_back(&*first);
+    add(structures);
+  }
+
+}
+}
+
+#endif /* RADIAL_DISTRIBUTION_H */
@@ -68,12 +68,19 @@ public:
   typedef Delaunay::Point Point;
   typedef CGAL::Polyhedron_3<Kernel> Polyhedron;
 
+  // Periodic structures are triangulated with the full 3x3x3 block of images
   StructureTriangulation(const common::Structure & structure);
+  // Only replicate those images that lie within imageSkin of the unit cell.
+  // The skin should be at least as large as the longest Delaunay edge expected
+  // between an atom in the cell and its neighbours.
+  StructureTriangulation(const common::Structure & structure, const double imageSkin);
 
   const Delaunay & getTriangulation() const;
 
   AtomsList getNeighbours(const common::Atom & atom) const;
   int getCoordination(const common::Atom & atom) const;
+  // Get the coordination of every atom (indexed by atom index) in one pass
+  ::std::vector<int> getCoordinations() const;
   Polyhedron getCoordinationPolyhedron(const common::Atom & atom) const;
 
   Delaunay::Vertex_handle findVertex(const common::Atom & atom) const;
@@ -83,11 +90,16 @@ public:
 
 private:
   typedef ::std::vector<Delaunay::Vertex_handle> AtomVertexHandles;
+  typedef ::std::vector< ::std::pair<Point, VertexInfo> > PointsWithInfo;
 
   void buildTriangulation() const;
+  void generatePoints(PointsWithInfo * const points) const;
   void updateVertexHandles() const;
 
   const common::Structure & myStructure;
+  // Images within this distance of the cell are included, negative means the
+  // full 3x3x3 block
+  const double myImageSkin;
   // Acts as buffers of a sort that are lazily initialised so
   // to permit const functions to change them we make them mutable
   mutable Delaunay myTriangulation;
@@ -0,0 +1,133 @@
+/*
+ * ParallelStructureGenerator.h
+ *
+ * Generate structures from a StructureBuilder on a number of worker threads.
+ * Each worker has its own copy of the builder and its own random number
+ * stream (seeded with seed + worker index) and puts the structures it makes
+ * into a bounded queue to be consumed by the caller.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef PARALLEL_STRUCTURE_GENERATOR_H
+#define PARALLEL_STRUCTURE_GENERATOR_H
+
+// INCLUDES /////////////////////////////////
+#include "spl/SSLib.h"
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "spl/build_cell/GenerationOutcome.h"
+#include "spl/build_cell/StructureBuilder.h"
+#include "spl/common/Types.h"
+
+// FORWARD DECLARES //////////////////////////
+
+namespace spl {
+namespace common {
+class AtomSpeciesDatabase;
+class Structure;
+}
+
+namespace build_cell {
+
+class ParallelStructureGenerator : ::boost::noncopyable
+{
+public:
+  struct Settings
+  {
+    Settings();
+
+    // 0 means use the number of hardware threads
+    unsigned int numWorkers;
+    size_t queueCapacity;
+    // 0 means keep generating until stop() is called
+    size_t numStructures;
+    // Give up on a structure after this many failed attempts, abandoned
+    // structures are counted in the stats and not made up for
+    unsigned int maxAttempts;
+    unsigned int seed;
+  };
+
+  struct Stats
+  {
+    typedef ::std::map< ::std::string, size_t> Failures;
+
+    Stats();
+
+    size_t attempts;
+    size_t successes;
+    // Structures given up on after maxAttempts failures, pop() will return
+    // this many fewer than numStructures
+    size_t abandoned;
+    // The number of failed attempts for each failure message
+    Failures failures;
+  };
+
+  ParallelStructureGenerator(const StructureBuilder & builder,
+      const common::AtomSpeciesDatabase & speciesDb,
+      const Settings & settings = Settings());
+  ~ParallelStructureGenerator();
+
+  void
+  start();
+  // Stop the workers and wait for them to finish, any structures still in the
+  // queue can be retrieved with pop()
+  void
+  stop();
+
+  // Wait for the next structure, returns false once all the workers have
+  // finished and the queue is empty
+  bool
+  pop(common::StructurePtr & structureOut);
+
+  Stats
+  getStats() const;
+
+private:
+  typedef ::std::deque< common::Structure *> Queue;
+
+  void
+  work(const size_t workerIdx);
+  bool
+  claim();
+  bool
+  push(common::StructurePtr & structure);
+  void
+  record(const GenerationOutcome & outcome);
+  void
+  abandon();
+  void
+  workerFinished();
+
+  const common::AtomSpeciesDatabase & mySpeciesDb;
+  const Settings mySettings;
+  ::boost::ptr_vector< StructureBuilder> myBuilders;
+  ::boost::thread_group myWorkers;
+
+  mutable ::boost::mutex myMutex;
+  ::boost::condition_variable myNotEmpty;
+  ::boost::condition_variable myNotFull;
+  Queue myQueue;
+  bool myStopping;
+  size_t myNumActive;
+  size_t myNumClaimed;
+  Stats myStats;
+};
+
+}
+}
+
+#endif // SPL_ENABLE_THREAD_AWARE
+#endif /* PARALLEL_STRUCTURE_GENERATOR_H */
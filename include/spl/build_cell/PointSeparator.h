@@ -30,10 +30,15 @@ class Structure;
 
 namespace build_cell {
 
+// Separations are stored compactly: each point has a type and the minimum
+// separation between two points is looked up in a (small) type x type table
+// unless the pair has an explicit override.
 struct SeparationData
 {
   typedef ::arma::mat Points;
   typedef ::std::set<size_t> FixedPoints;
+  typedef ::std::vector<size_t> Types;
+  typedef ::std::map< utility::OrderedPair<size_t>, double> SeparationOverrides;
 
   SeparationData(const size_t numPoints,
       const common::DistanceCalculator & distanceCalculator);
@@ -44,11 +49,22 @@ struct SeparationData
   template <typename Label>
   void
   setSeparationsFromLabels(const ::std::vector<Label> & pointLabels,
-      ::std::map< utility::OrderedPair<Label>, double> & sepList);
+      const ::std::map< utility::OrderedPair<Label>, double> & sepList);
+
+  // Make all points the same type with the given separation
+  void
+  setUniformSeparation(const double separation);
+  // Override the separation for one pair of points
+  void
+  setSeparation(const size_t i, const size_t j, const double separation);
+  double
+  getSeparation(const size_t i, const size_t j) const;
 
   const common::DistanceCalculator & distanceCalculator;
   Points points;
-  ::arma::mat separations;
+  Types types;
+  ::arma::mat typeSeparations;
+  SeparationOverrides separationOverrides;
   FixedPoints fixedPoints;
 private:
   void
@@ -69,12 +85,20 @@ public:
 
 private:
   typedef ::std::vector< bool> FixedList;
-
+  struct SeparatePointsVisitor;
+
+  // These are templated on the distance calculator so the loops can be
+  // specialised for each type
+  template< class DistCalc>
+    bool
+    separatePoints(const DistCalc & distCalc,
+        SeparationData * const sepData) const;
   FixedList
   generateFixedList(const SeparationData & sepData) const;
-  double
-  calcMaxOverlapFraction(const SeparationData & sepData,
-      const ::arma::mat & minSepSqs, const FixedList & fixed) const;
+  template< class DistCalc>
+    double
+    calcMaxOverlapFraction(const DistCalc & distCalc,
+        const SeparationData & sepData, const FixedList & fixed) const;
 
   const size_t myMaxIterations;
   const double myTolerance;
@@ -159,8 +159,10 @@ private:
   atomInserted(BuildAtomInfo & atomInfo, common::Atom & atom);
   void
   atomRemoved(common::Atom & atom);
-  arma::mat
-  generateSepSqMatrix() const;
+  void
+  setSeparations(SeparationData * const sepData) const;
+  double
+  calcSeparation(const common::Atom & atomI, const common::Atom & atomJ) const;
 
   common::Structure & myStructure;
   const StructureContents & myIntendedContents;
@@ -20,26 +20,53 @@ namespace build_cell {
 template <typename Label>
 void
 SeparationData::setSeparationsFromLabels(const ::std::vector<Label> & pointLabels,
-    ::std::map< utility::OrderedPair<Label>, double> & sepList)
+    const ::std::map< utility::OrderedPair<Label>, double> & sepList)
 {
   typedef utility::OrderedPair<Label> LabelPair;
   typedef ::std::map< LabelPair, double> Separations;
+  typedef ::std::map< Label, size_t> LabelTypes;
 
   const size_t numPoints = points.n_cols;
-  separations.zeros();
-
   SSLIB_ASSERT(pointLabels.size() == numPoints);
 
-  for(size_t i = 0 ; i < numPoints; ++i)
+  // Each distinct label becomes a type
+  ::std::vector< Label> labels;
+  LabelTypes labelTypes;
+  for(size_t i = 0; i < numPoints; ++i)
   {
-    for(size_t j = i; j < numPoints; ++j)
+    const ::std::pair< typename LabelTypes::iterator, bool> res =
+        labelTypes.insert(::std::make_pair(pointLabels[i], labels.size()));
+    if(res.second)
+      labels.push_back(pointLabels[i]);
+    types[i] = res.first->second;
+  }
+
+  const size_t numTypes = labels.size();
+  typeSeparations.zeros(numTypes, numTypes);
+  for(size_t i = 0; i < numTypes; ++i)
+  {
+    for(size_t j = i; j < numTypes; ++j)
     {
       const typename Separations::const_iterator it =
-          sepList.find(LabelPair(pointLabels[i], pointLabels[j]));
+          sepList.find(LabelPair(labels[i], labels[j]));
       if(it != sepList.end())
-        separations(i, j) = it->second;
+        typeSeparations(i, j) = typeSeparations(j, i) = it->second;
     }
   }
+  separationOverrides.clear();
+}
+
+inline double
+SeparationData::getSeparation(const size_t i, const size_t j) const
+{
+  if(!separationOverrides.empty())
+  {
+    const SeparationOverrides::const_iterator it = separationOverrides.find(
+        utility::OrderedPair< size_t>(i, j));
+    if(it != separationOverrides.end())
+      return it->second;
+  }
+  return typeSeparations(types[i], types[j]);
 }
 
 }
@@ -22,6 +22,8 @@ namespace common {
 
 // FORWARD DECLARES ///////////////////////////
 
+// Not pooled: with many atoms per structure a pool shared between threads
+// would serialise structure building
 class Atom
 {
 public:
@@ -71,7 +73,8 @@ public:
   removeListener(Listener * const listener);
 
 private:
-  typedef ::std::set<Listener *> Listeners;
+  // Not pooled: a shared pool here would serialise atom creation across threads
+  typedef ::std::set< Listener *> Listeners;
 
   void
   sendMovedMsg();
@@ -11,7 +11,7 @@
 // INCLUDES ///////////////////////////////////
 #include "spl/common/DistanceCalculator.h"
 
-#include "spl/common/Structure.h"
+#include <armadillo>
 
 namespace spl {
 namespace common {
@@ -57,6 +57,27 @@ public:
     return true;
   }
 
+  // There is no cell so there is nothing to be saved by the wrapped versions
+  virtual inline bool
+  getDistsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< double> & outDistances,
+      const size_t maxDistances = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return ClusterDistanceCalculator::getDistsBetween(a, b, cutoff,
+        outDistances, maxDistances, maxCellMultiples);
+  }
+
+  virtual inline bool
+  getVecsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< arma::vec3> & outVectors,
+      const size_t maxVectors = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return ClusterDistanceCalculator::getVecsBetween(a, b, cutoff, outVectors,
+        maxVectors, maxCellMultiples);
+  }
+
   virtual inline bool
   isValid() const
   {
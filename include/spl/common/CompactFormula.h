@@ -0,0 +1,117 @@
+/*
+ * CompactFormula.h
+ *
+ * A fixed size representation of a formula for when many formulas need to be
+ * compared or used as keys.  Species names are interned to integer ids and
+ * the counts are kept in a small inline array sorted by id along with a
+ * precomputed hash so they can be used in hash maps.  Use AtomsFormula for
+ * anything that needs species names.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef SPL__COMMON__COMPACT_FORMULA_H_
+#define SPL__COMMON__COMPACT_FORMULA_H_
+
+// INCLUDES ///////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace spl {
+namespace common {
+
+// FORWARD DECLARES ///////////////////////////
+class AtomsFormula;
+
+class CompactFormula
+{
+public:
+  typedef unsigned int SpeciesId;
+  struct Entry
+  {
+    SpeciesId species;
+    int count;
+  };
+  typedef const Entry * const_iterator;
+  typedef const_iterator iterator; // Only const iteration allowed
+
+  static const size_t MAX_SPECIES = 8;
+
+  // Get the id of a species name, adding it to the table if it isn't there
+  static SpeciesId
+  intern(const ::std::string & species);
+  static const ::std::string &
+  speciesName(const SpeciesId id);
+
+  // Can the formula be represented i.e. has no more than MAX_SPECIES species
+  static bool
+  fits(const AtomsFormula & formula);
+
+  CompactFormula();
+  // Throws std::length_error if the formula doesn't fit
+  explicit
+  CompactFormula(const AtomsFormula & formula);
+
+  bool
+  isEmpty() const;
+  int
+  numSpecies() const;
+  int
+  total() const;
+  int
+  numberOf(const SpeciesId species) const;
+
+  // Returns false if the species is new and there is no more space
+  bool
+  add(const SpeciesId species, const int count);
+  // Throws std::length_error if the sum has too many species
+  CompactFormula &
+  operator +=(const CompactFormula & rhs);
+
+  // Divide the counts by their greatest common divisor, which is returned
+  unsigned int
+  reduce();
+
+  size_t
+  hash() const;
+  bool
+  operator ==(const CompactFormula & rhs) const;
+  bool
+  operator !=(const CompactFormula & rhs) const;
+  // An arbitrary but consistent ordering
+  bool
+  operator <(const CompactFormula & rhs) const;
+
+  const_iterator
+  begin() const;
+  const_iterator
+  end() const;
+
+  AtomsFormula
+  toFormula() const;
+  ::std::string
+  toString() const;
+
+private:
+  void
+  updateHash();
+
+  Entry myEntries[MAX_SPECIES];
+  size_t myNumSpecies;
+  size_t myHash;
+};
+
+size_t
+hash_value(const CompactFormula & formula);
+
+::std::ostream &
+operator <<(::std::ostream & os, const CompactFormula & formula);
+
+}
+}
+
+#endif /* SPL__COMMON__COMPACT_FORMULA_H_ */
@@ -15,6 +15,7 @@
 
 #include "spl/SSLibAssert.h"
 #include "spl/common/Atom.h"
+#include "spl/utility/Instrumentation.h"
 
 namespace spl {
 namespace common {
@@ -108,6 +109,28 @@ public:
         outVectors, maxVectors, maxCellMultiples);
   }
 
+  // As getDistsBetween/getVecsBetween but a and b are known to have already
+  // been wrapped into the unit cell so calculators can skip doing it per pair
+  virtual inline bool
+  getDistsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< double> & outDistances,
+      const size_t maxDistances = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return getDistsBetween(a, b, cutoff, outDistances, maxDistances,
+        maxCellMultiples);
+  }
+
+  virtual inline bool
+  getVecsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< arma::vec3> & outVectors,
+      const size_t maxVectors = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return getVecsBetween(a, b, cutoff, outVectors, maxVectors,
+        maxCellMultiples);
+  }
+
   virtual bool
   isValid() const = 0;
 
@@ -148,6 +171,19 @@ protected:
     }
     return capped;
   }
+
+  // Record an image enumeration for instrumentation
+  inline void
+  countImages(const int numImages, const bool capped) const
+  {
+    if(utility::instrumentation::isEnabled())
+    {
+      utility::instrumentation::count("distance_calculator.images", numImages);
+      if(capped)
+        utility::instrumentation::count(
+            "distance_calculator.cap_multiples_hits");
+    }
+  }
 };
 
 } // namespace common
@@ -115,6 +115,26 @@ public:
         maxVectors, maxCellMultiples);
   }
 
+  virtual inline bool
+  getDistsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< double> & outDistances,
+      const size_t maxDistances = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return myDelegate->getDistsBetweenWrapped(a, b, cutoff, outDistances,
+        maxDistances, maxCellMultiples);
+  }
+
+  virtual inline bool
+  getVecsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< arma::vec3> & outVectors,
+      const size_t maxVectors = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return myDelegate->getVecsBetweenWrapped(a, b, cutoff, outVectors,
+        maxVectors, maxCellMultiples);
+  }
+
   bool
   isValid() const
   {
@@ -126,6 +146,45 @@ public:
 
   // End from DistanceCalculator /////////////////
 
+  // Queries between atoms i and j of the structure.  These use a table of
+  // the atom positions wrapped into the unit cell that is kept until the atoms
+  // or the cell change, so each atom is wrapped once rather than per pair.
+  inline arma::vec3
+  getVecMinImg(const size_t i, const size_t j,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const;
+
+  inline double
+  getDistSqMinImg(const size_t i, const size_t j,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const;
+
+  inline bool
+  getDistsBetween(const size_t i, const size_t j, const double cutoff,
+      std::vector< double> & outDistances, const size_t maxDistances =
+          DEFAULT_MAX_OUTPUTS, const unsigned int maxCellMultiples =
+          DEFAULT_MAX_CELL_MULTIPLES) const;
+
+  inline bool
+  getVecsBetween(const size_t i, const size_t j, const double cutoff,
+      std::vector< arma::vec3> & outVectors, const size_t maxVectors =
+          DEFAULT_MAX_OUTPUTS, const unsigned int maxCellMultiples =
+          DEFAULT_MAX_CELL_MULTIPLES) const;
+
+  // The positions of all the atoms wrapped into the unit cell (or just the
+  // positions for a cluster), one per column
+  inline const arma::mat &
+  getWrappedPositions() const;
+
+  void
+  invalidateWrappedPositions();
+
+  // Call the visitor with a StaticDistanceCalculator wrapping the calculator
+  // currently being delegated to.  The visitor should have a templated
+  // operator() so that hot loops are instantiated once per calculator type
+  // with the distance calls inside them resolved statically.
+  template< class Visitor>
+    typename Visitor::result_type
+    visit(Visitor & visitor) const;
+
 private:
   struct CalculatorType
   {
@@ -141,12 +200,72 @@ private:
   bool
   setDelegate(const CalculatorType::Value calcType);
 
+  void
+  updateWrappedPositions() const;
+
   Structure & myStructure;
   spl::UniquePtr<DistanceCalculator>::Type myDelegate;
   CalculatorType::Value myDelegateType;
+
+  mutable bool myWrappedPositionsCurrent;
+  mutable arma::mat myWrappedPositions;
 };
 
+arma::vec3
+DistanceCalculatorDelegator::getVecMinImg(const size_t i, const size_t j,
+    const unsigned int maxCellMultiples) const
+{
+  const arma::mat & wrapped = getWrappedPositions();
+  return myDelegate->getVecMinImg(wrapped.unsafe_col(i), wrapped.unsafe_col(j),
+      maxCellMultiples);
+}
+
+double
+DistanceCalculatorDelegator::getDistSqMinImg(const size_t i, const size_t j,
+    const unsigned int maxCellMultiples) const
+{
+  const arma::vec3 dr = getVecMinImg(i, j, maxCellMultiples);
+  return arma::dot(dr, dr);
+}
+
+bool
+DistanceCalculatorDelegator::getDistsBetween(const size_t i, const size_t j,
+    const double cutoff, std::vector< double> & outDistances,
+    const size_t maxDistances, const unsigned int maxCellMultiples) const
+{
+  const arma::mat & wrapped = getWrappedPositions();
+  return myDelegate->getDistsBetweenWrapped(wrapped.unsafe_col(i),
+      wrapped.unsafe_col(j), cutoff, outDistances, maxDistances,
+      maxCellMultiples);
+}
+
+bool
+DistanceCalculatorDelegator::getVecsBetween(const size_t i, const size_t j,
+    const double cutoff, std::vector< arma::vec3> & outVectors,
+    const size_t maxVectors, const unsigned int maxCellMultiples) const
+{
+  const arma::mat & wrapped = getWrappedPositions();
+  return myDelegate->getVecsBetweenWrapped(wrapped.unsafe_col(i),
+      wrapped.unsafe_col(j), cutoff, outVectors, maxVectors, maxCellMultiples);
+}
+
+const arma::mat &
+DistanceCalculatorDelegator::getWrappedPositions() const
+{
+  if(!myWrappedPositionsCurrent)
+    updateWrappedPositions();
+  return myWrappedPositions;
+}
+
+// Visit any distance calculator.  Delegators and the concrete calculators get
+// the static treatment, anything else is visited using virtual calls.
+template< class Visitor>
+  typename Visitor::result_type
+  visitDistanceCalculator(const DistanceCalculator & calc, Visitor & visitor);
+
 }
 } // Close the namespace
 
+#include "spl/common/detail/DistanceCalculatorDelegator.h"
+
 #endif /* DISTANCE_CALCULATOR_DELEGATOR_H */
@@ -0,0 +1,95 @@
+/*
+ * GeometrySnapshot.h
+ *
+ * A read-only copy of just the geometry of a structure: its unit cell (if
+ * any), the atom positions and their species.  This is much cheaper to take
+ * than a copy of the Structure as there are no atoms, properties or
+ * listeners to copy, and primitive reduction, volume scaling and Niggli
+ * reduction are applied to the snapshot directly.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef GEOMETRY_SNAPSHOT_H
+#define GEOMETRY_SNAPSHOT_H
+
+// INCLUDES ///////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <armadillo>
+
+#include "spl/common/AtomSpeciesId.h"
+#include "spl/common/DistanceCalculator.h"
+
+namespace spl {
+namespace common {
+
+// FORWARD DECLARATIONS ///////
+class Structure;
+class UnitCell;
+
+class GeometrySnapshot : ::boost::noncopyable
+{
+public:
+  typedef ::std::vector< AtomSpeciesId::Value> SpeciesList;
+
+  // If primitive is true take the primitive cell of the structure instead
+  // (found using the structure's symmetry cache)
+  explicit
+  GeometrySnapshot(const Structure & structure, const bool primitive = false);
+  ~GeometrySnapshot();
+
+  size_t
+  getNumAtoms() const;
+  // NULL for clusters
+  const UnitCell *
+  getUnitCell() const;
+  // Cartesian positions wrapped into the unit cell, one per column
+  const ::arma::mat &
+  getPositions() const;
+  const SpeciesList &
+  getSpecies() const;
+  const DistanceCalculator &
+  getDistanceCalculator() const;
+
+  // Scale the volume by the given factor keeping fractional positions fixed,
+  // does nothing for clusters
+  void
+  scale(const double scaleFactor);
+  // Choose the Niggli reduced lattice vectors, this doesn't change the lattice
+  // and hence any of the distances
+  bool
+  niggliReduce();
+
+  // All the distances between atoms i and j (including periodic images)
+  // within the cutoff
+  bool
+  getDistsBetween(const size_t i, const size_t j, const double cutoff,
+      ::std::vector< double> & outDistances, const size_t maxDistances =
+          DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples =
+          DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const;
+
+private:
+  void
+  wrapPositions();
+  void
+  updateDistanceCalculator();
+
+  // WARNING: Order is important, the distance calculator refers to the cell
+  ::boost::scoped_ptr< UnitCell> myCell;
+  ::boost::scoped_ptr< DistanceCalculator> myDistanceCalculator;
+  ::arma::mat myPositions;
+  SpeciesList mySpecies;
+};
+
+}
+}
+
+#endif /* GEOMETRY_SNAPSHOT_H */
@@ -11,6 +11,9 @@
 // INCLUDES ///////////////////////////////////
 #include "spl/SSLib.h"
 
+#include <cmath>
+#include <vector>
+
 #include <boost/noncopyable.hpp>
 
 #include <armadillo>
@@ -52,6 +55,18 @@ public:
       const size_t maxVectors = DEFAULT_MAX_OUTPUTS,
       const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const;
 
+  virtual bool
+  getDistsBetweenWrapped(const ::arma::vec3 & r1, const ::arma::vec3 & r2,
+      const double cutoff, ::std::vector< double> & outDistances,
+      const size_t maxDistances = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const;
+
+  virtual bool
+  getVecsBetweenWrapped(const ::arma::vec3 & r1, const ::arma::vec3 & r2,
+      const double cutoff, ::std::vector< ::arma::vec3> & outVectors,
+      const size_t maxVectors = DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const;
+
   virtual bool
   isValid() const;
 
@@ -85,6 +100,115 @@ private:
   common::UnitCell * myUnitCell;
 };
 
+// Hot methods are defined here so that they can be inlined when called
+// statically (see StaticDistanceCalculator)
+inline ::arma::vec3
+OrthoCellDistanceCalculator::getVecMinImg(const ::arma::vec3 & r1,
+    const ::arma::vec3 & r2, const unsigned int /*maxCellMultiples*/) const
+{
+  using ::std::floor;
+
+  const UnitCell & cell = *myUnitCell;
+
+  const ::arma::mat33 & fracMtx = cell.getFracMtx();
+  const ::arma::mat33 & orthoMtx = cell.getOrthoMtx();
+
+  ::arma::vec3 r12 = r2 - r1;
+
+  r12 = fracMtx * r12;
+  r12[0] -= floor(r12[0] + 0.5);
+  r12[1] -= floor(r12[1] + 0.5);
+  r12[2] -= floor(r12[2] + 0.5);
+  r12 = orthoMtx * r12;
+
+  return r12;
+}
+
+inline bool
+OrthoCellDistanceCalculator::getVecsBetween(const ::arma::vec3 & r1,
+    const ::arma::vec3 & r2, const double cutoff,
+    ::std::vector< ::arma::vec3> & outVectors, const size_t maxValues,
+    const unsigned int maxCellMultiples) const
+{
+  const UnitCell & cell = *myUnitCell;
+  return OrthoCellDistanceCalculator::getVecsBetweenWrapped(cell.wrapVec(r1),
+      cell.wrapVec(r2), cutoff, outVectors, maxValues, maxCellMultiples);
+}
+
+inline bool
+OrthoCellDistanceCalculator::getVecsBetweenWrapped(const ::arma::vec3 & r1,
+    const ::arma::vec3 & r2, double cutoff,
+    ::std::vector< ::arma::vec3> & outVectors, const size_t maxValues,
+    const unsigned int maxCellMultiples) const
+{
+  using ::std::floor;
+
+  // The cutoff has to be positive
+  cutoff = ::std::abs(cutoff);
+  const double cutoffSq = cutoff * cutoff;
+
+  const ::arma::vec3 r12 = r2 - r1;
+  const double (&params)[6] = myUnitCell->getLatticeParams();
+
+  const double rDotA = ::arma::dot(r12, myANorm);
+  const double rDotB = ::arma::dot(r12, myBNorm);
+  const double rDotC = ::arma::dot(r12, myCNorm);
+
+  // Maximum multiples of cell vectors we need to go to
+  int A_min = -static_cast< int>(floor((cutoff + rDotA) * myARecip));
+  int A_max = static_cast< int>(floor((cutoff - rDotA) * myARecip));
+  int B_min = -static_cast< int>(floor((cutoff + rDotB) * myBRecip));
+  int B_max = static_cast< int>(floor((cutoff - rDotB) * myBRecip));
+  int C_min = -static_cast< int>(floor((cutoff + rDotC) * myCRecip));
+  int C_max = static_cast< int>(floor((cutoff - rDotC) * myCRecip));
+
+  // Check if there are any vectors that will be within the cutoff
+  if(A_min > A_max || B_min > B_max || C_min > C_max)
+    return true;
+
+  bool problemDuringCalculation = false;
+  problemDuringCalculation |= capMultiples(A_min, A_max, maxCellMultiples);
+  problemDuringCalculation |= capMultiples(B_min, B_max, maxCellMultiples);
+  problemDuringCalculation |= capMultiples(C_min, C_max, maxCellMultiples);
+  countImages((A_max - A_min + 1) * (B_max - B_min + 1) * (C_max - C_min + 1),
+      problemDuringCalculation);
+
+  // Loop variables
+  size_t numVectors = 0;
+  ::arma::vec3 dR, outVec;
+  double r_x, r_y, r_z, aSq, bSq, testDistSq;
+  for(int a = A_min; a <= A_max; ++a)
+  {
+    r_x = a * params[0] + rDotA;
+    aSq = r_x * r_x;
+    for(int b = B_min; b <= B_max; ++b)
+    {
+      r_y = b * params[1] + rDotB;
+      bSq = r_y * r_y;
+      if(aSq + bSq < cutoffSq)
+      {
+        for(int c = C_min; c <= C_max; ++c)
+        {
+          r_z = c * params[2] + rDotC;
+          testDistSq = aSq + bSq + r_z * r_z;
+
+          if(testDistSq < cutoffSq)
+          {
+            outVec[0] = r_x;
+            outVec[1] = r_y;
+            outVec[2] = r_z;
+            outVectors.push_back(outVec);
+            if(++numVectors >= maxValues)
+              return false;
+          }
+        }
+      }
+    }
+  }
+
+  return !problemDuringCalculation;
+}
+
 } // namespace common
 } // namespace spl
 
@@ -0,0 +1,212 @@
+/*
+ * StaticDistanceCalculator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef STATIC_DISTANCE_CALCULATOR_H
+#define STATIC_DISTANCE_CALCULATOR_H
+
+// INCLUDES ///////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <vector>
+
+#include <armadillo>
+
+#include "spl/common/DistanceCalculator.h"
+
+namespace spl {
+namespace common {
+
+// A thin wrapper around a concrete distance calculator that calls through to
+// its methods non-virtually.  Code that is templated on this wrapper (see
+// DistanceCalculatorDelegator::visit) gets the calculator methods inlined
+// into its loops rather than paying for a virtual call per pair.
+template< class Calc>
+  class StaticDistanceCalculator
+  {
+  public:
+    typedef Calc CalculatorType;
+
+    explicit
+    StaticDistanceCalculator(const Calc & calc) :
+        myCalc(calc)
+    {
+    }
+
+    inline arma::vec3
+    getVecMinImg(const arma::vec3 & a, const arma::vec3 & b,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.Calc::getVecMinImg(a, b, maxCellMultiples);
+    }
+
+    inline double
+    getDistSqMinImg(const arma::vec3 & a, const arma::vec3 & b,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      const arma::vec3 dr = getVecMinImg(a, b, maxCellMultiples);
+      return arma::dot(dr, dr);
+    }
+
+    inline double
+    getDistMinImg(const arma::vec3 & a, const arma::vec3 & b,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return std::sqrt(getDistSqMinImg(a, b, maxCellMultiples));
+    }
+
+    inline bool
+    getDistsBetween(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< double> & outDistances,
+        const size_t maxDistances = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.Calc::getDistsBetween(a, b, cutoff, outDistances,
+          maxDistances, maxCellMultiples);
+    }
+
+    inline bool
+    getVecsBetween(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< arma::vec3> & outVectors,
+        const size_t maxVectors = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.Calc::getVecsBetween(a, b, cutoff, outVectors, maxVectors,
+          maxCellMultiples);
+    }
+
+    inline bool
+    getDistsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< double> & outDistances,
+        const size_t maxDistances = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.Calc::getDistsBetweenWrapped(a, b, cutoff, outDistances,
+          maxDistances, maxCellMultiples);
+    }
+
+    inline bool
+    getVecsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< arma::vec3> & outVectors,
+        const size_t maxVectors = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.Calc::getVecsBetweenWrapped(a, b, cutoff, outVectors,
+          maxVectors, maxCellMultiples);
+    }
+
+    const Calc &
+    get() const
+    {
+      return myCalc;
+    }
+
+  private:
+    const Calc & myCalc;
+  };
+
+// Fallback for calculators whose concrete type isn't known, calls are virtual
+template< >
+  class StaticDistanceCalculator< DistanceCalculator>
+  {
+  public:
+    typedef DistanceCalculator CalculatorType;
+
+    explicit
+    StaticDistanceCalculator(const DistanceCalculator & calc) :
+        myCalc(calc)
+    {
+    }
+
+    inline arma::vec3
+    getVecMinImg(const arma::vec3 & a, const arma::vec3 & b,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.getVecMinImg(a, b, maxCellMultiples);
+    }
+
+    inline double
+    getDistSqMinImg(const arma::vec3 & a, const arma::vec3 & b,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.getDistSqMinImg(a, b, maxCellMultiples);
+    }
+
+    inline double
+    getDistMinImg(const arma::vec3 & a, const arma::vec3 & b,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.getDistMinImg(a, b, maxCellMultiples);
+    }
+
+    inline bool
+    getDistsBetween(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< double> & outDistances,
+        const size_t maxDistances = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.getDistsBetween(a, b, cutoff, outDistances, maxDistances,
+          maxCellMultiples);
+    }
+
+    inline bool
+    getVecsBetween(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< arma::vec3> & outVectors,
+        const size_t maxVectors = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.getVecsBetween(a, b, cutoff, outVectors, maxVectors,
+          maxCellMultiples);
+    }
+
+    inline bool
+    getDistsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< double> & outDistances,
+        const size_t maxDistances = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.getDistsBetweenWrapped(a, b, cutoff, outDistances,
+          maxDistances, maxCellMultiples);
+    }
+
+    inline bool
+    getVecsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+        const double cutoff, std::vector< arma::vec3> & outVectors,
+        const size_t maxVectors = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+        const unsigned int maxCellMultiples =
+            DistanceCalculator::DEFAULT_MAX_CELL_MULTIPLES) const
+    {
+      return myCalc.getVecsBetweenWrapped(a, b, cutoff, outVectors,
+          maxVectors, maxCellMultiples);
+    }
+
+    const DistanceCalculator &
+    get() const
+    {
+      return myCalc;
+    }
+
+  private:
+    const DistanceCalculator & myCalc;
+  };
+
+}
+}
+
+#endif /* STATIC_DISTANCE_CALCULATOR_H */
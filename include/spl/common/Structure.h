@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <ostream>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/optional.hpp>
@@ -25,10 +26,13 @@
 #include "spl/common/AtomSpeciesId.h"
 #include "spl/common/DistanceCalculatorDelegator.h"
 #include "spl/common/StructureProperties.h"
+#include "spl/common/SymmetryCache.h"
 #include "spl/common/Types.h"
 #include "spl/common/UnitCell.h"
+#include "spl/math/KdTree.h"
 #include "spl/utility/HasProperties.h"
 #include "spl/utility/NamedProperty.h"
+#include "spl/utility/PoolAllocated.h"
 
 std::ostream &
 operator<<(std::ostream & os, const spl::common::Structure & p);
@@ -42,7 +46,9 @@ namespace common {
 class AtomsFormula;
 class DistanceCalculator;
 
-class Structure : public utility::HasProperties, Atom::Listener
+class Structure : public utility::HasProperties,
+    public utility::PoolAllocated< Structure>, Atom::Listener,
+    UnitCell::UnitCellListener
 {
   typedef boost::ptr_vector< Atom> AtomsContainer;
 public:
@@ -50,6 +56,9 @@ public:
   typedef AtomsContainer::iterator AtomIterator;
   typedef utility::NamedProperty< utility::HeterogeneousMap> VisibleProperty;
 
+  // Absolute tolerance used when searching for the primitive cell
+  static const double PRIMITIVE_TOLERANCE;
+
   explicit
   Structure();
   explicit
@@ -121,14 +130,41 @@ public:
   AtomsFormula
   getComposition() const;
 
-  const DistanceCalculator &
+  const DistanceCalculatorDelegator &
   getDistanceCalculator() const;
 
+  // NEIGHBOURS //////////////////////////////////////////
+  // Get the indices of the atoms within radius of a point (minimum image
+  // distance for periodic structures).  Clusters use a k-d tree that is
+  // rebuilt lazily after the atoms change.  Returns the number found.
+  size_t
+  getNeighbours(const ::arma::vec3 & point, const double radius,
+      ::std::vector< size_t> * const neighbours) const;
+  // As above but centred on an atom, the atom itself is not included
+  size_t
+  getNeighbours(const size_t atomIdx, const double radius,
+      ::std::vector< size_t> * const neighbours) const;
+  // Get the indices of the k atoms nearest to a point, closest first
+  size_t
+  getNearestNeighbours(const ::arma::vec3 & point, const size_t k,
+      ::std::vector< size_t> * const neighbours) const;
+  size_t
+  getNearestNeighbours(const size_t atomIdx, const size_t k,
+      ::std::vector< size_t> * const neighbours) const;
+
   boost::optional< std::string>
   getVisibleProperty(const VisibleProperty & property) const;
   void
   setVisibleProperty(VisibleProperty & property, const std::string & value);
 
+  // SYMMETRY ////////////////////////////////////////////
+  // Results of spglib analysis at the given absolute tolerance.  These are
+  // memoised until the atoms or unit cell change, see SymmetryCache.
+  const SymmetryCache::Dataset *
+  getSymmetryDataset(const double tolerance) const;
+  const SymmetryCache::Primitive *
+  getPrimitiveCell(const double tolerance) const;
+
   bool
   makePrimitive();
 
@@ -147,8 +183,22 @@ private:
   virtual void
   onAtomDestroyed(Atom * const atom);
 
+  virtual void
+  onUnitCellChanged(UnitCell & unitCell);
+  virtual void
+  onUnitCellVolumeChanged(UnitCell & unitCell, const double oldVol,
+      const double newVol);
+  virtual void
+  onUnitCellDestroyed();
+
   void
   updatePosBuffer() const;
+  void
+  invalidatePositions();
+  const math::KdTree &
+  getNeighbourIndex() const;
+  void
+  applyPrimitive(const SymmetryCache::Primitive & primitive);
 
   /** The name of this structure, set by calling code */
   std::string myName;
@@ -166,6 +216,12 @@ private:
 
   mutable DistanceCalculatorDelegator myDistanceCalculator;
 
+  // Spatial index used for neighbour queries on clusters
+  mutable bool myNeighbourIndexCurrent;
+  mutable math::KdTree myNeighbourIndex;
+
+  SymmetryCache mySymmetry;
+
   friend class Atom;
 };
 
@@ -0,0 +1,92 @@
+/*
+ * SymmetryCache.h
+ *
+ * Memoised spglib results for a structure.  The owning structure is
+ * responsible for calling invalidate() whenever its atoms or unit cell change.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef SYMMETRY_CACHE_H
+#define SYMMETRY_CACHE_H
+
+// INCLUDES /////////////////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include <armadillo>
+
+#include "spl/common/AtomSpeciesId.h"
+
+// FORWARD DECLARES ////////////////////////////////
+
+namespace spl {
+namespace common {
+class Structure;
+
+class SymmetryCache
+{
+public:
+  struct Dataset
+  {
+    int spacegroupNumber;
+    ::std::string iucSymbol;
+    ::std::string hallSymbol;
+    ::std::vector< ::arma::mat33> rotations;
+    ::std::vector< ::arma::vec3> translations;
+    // For each atom the index of the symmetry equivalent atom it maps onto
+    ::std::vector< int> equivalentAtoms;
+  };
+
+  struct Primitive
+  {
+    // Orthogonalisation matrix of the primitive cell (lattice vectors are
+    // columns)
+    ::arma::mat33 lattice;
+    // Fractional positions of the primitive atoms, one per column
+    ::arma::mat positions;
+    ::std::vector< AtomSpeciesId::Value> species;
+  };
+
+  // Get the spglib dataset of the structure analysed at the given (absolute)
+  // tolerance.  Returns NULL if the structure has no unit cell or atoms.
+  const Dataset *
+  getDataset(const Structure & structure, const double tolerance) const;
+  // Get the primitive cell of the structure found at the given tolerance.
+  // Returns NULL if no primitive cell could be found.
+  const Primitive *
+  getPrimitive(const Structure & structure, const double tolerance) const;
+
+  void
+  invalidate();
+
+private:
+  // The structure packed in the form that spglib expects
+  struct Input
+  {
+    double lattice[3][3];
+    ::std::vector< double> positions;
+    ::std::vector< int> species;
+    ::std::vector< AtomSpeciesId::Value> speciesList;
+  };
+  typedef ::std::map< double, ::boost::optional< Dataset> > Datasets;
+  typedef ::std::map< double, ::boost::optional< Primitive> > Primitives;
+
+  const Input &
+  getInput(const Structure & structure) const;
+
+  mutable ::boost::optional< Input> myInput;
+  mutable Datasets myDatasets;
+  mutable Primitives myPrimitives;
+};
+
+}
+}
+
+#endif /* SYMMETRY_CACHE_H */
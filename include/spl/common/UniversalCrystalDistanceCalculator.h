@@ -9,6 +9,9 @@
 #define UNIVERSAL_CRYSTAL_DISTANCE_CALCULATOR_H
 
 // INCLUDES ///////////////////////////////////
+#include <cmath>
+#include <vector>
+
 #include <boost/noncopyable.hpp>
 
 #include "spl/common/DistanceCalculator.h"
@@ -46,6 +49,28 @@ public:
       const size_t maxVectors = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
       const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const;
 
+  // Wrapped positions need no special treatment but do give a shorter
+  // separation and hence a smaller image search
+  virtual inline bool
+  getDistsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< double> & outDistances,
+      const size_t maxDistances = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return UniversalCrystalDistanceCalculator::getDistsBetween(a, b, cutoff,
+        outDistances, maxDistances, maxCellMultiples);
+  }
+
+  virtual inline bool
+  getVecsBetweenWrapped(const arma::vec3 & a, const arma::vec3 & b,
+      const double cutoff, std::vector< arma::vec3> & outVectors,
+      const size_t maxVectors = DistanceCalculator::DEFAULT_MAX_OUTPUTS,
+      const unsigned int maxCellMultiples = DEFAULT_MAX_CELL_MULTIPLES) const
+  {
+    return UniversalCrystalDistanceCalculator::getVecsBetween(a, b, cutoff,
+        outVectors, maxVectors, maxCellMultiples);
+  }
+
   virtual bool
   isValid() const;
 
@@ -73,11 +98,17 @@ private:
     arma::vec3 aCrossBHat;
     arma::vec3 bCrossCHat;
     arma::vec3 aCrossCHat;
+
+    // A reduced basis spanning the same lattice (columns are the vectors),
+    // this keeps minimum image searches to a handful of images even for
+    // very skewed cells.
+    arma::mat33 reducedOrtho;
+    arma::mat33 reducedFrac;
+    // The number of reduced cell plane repetitions per unit length along each
+    // reduced vector direction (the reciprocal of the plane spacing)
+    double reducedRepetitionsPerLength[3];
   };
 
-  double
-  getNumPlaneRepetitionsToBoundSphere(const arma::vec3 & planeVec1,
-      const arma::vec3 & planeVec2, const double radius) const;
   inline double
   getNumPlaneRepetitionsToBoundSphere(const double radius, const double volume,
       const double crossLen) const
@@ -97,6 +128,122 @@ private:
   Cache myCache;
 };
 
+// Hot methods are defined here so that they can be inlined when called
+// statically (see StaticDistanceCalculator)
+inline ::arma::vec3
+UniversalCrystalDistanceCalculator::getVecMinImg(const arma::vec3 & a,
+    const arma::vec3 & b, const unsigned int maxCellMultiples) const
+{
+  // Wrap the separation into the reduced cell centred on the origin, for
+  // all but the most pathological cells this is already the minimum image
+  arma::vec3 frac = myCache.reducedFrac * (b - a);
+  frac -= arma::floor(frac + 0.5);
+  const arma::vec3 dR = myCache.reducedOrtho * frac;
+  double minModDRSq = dot(dR, dR);
+  const double minModDR = std::sqrt(minModDRSq);
+
+  // Maximum multiple of reduced cell vectors we need to go to.  As the wrapped
+  // fractional coordinates are at most 0.5 any closer image has to be within
+  // minModDR + 0.5 plane spacings along each direction.
+  int A_max = static_cast< int>(std::floor(
+      minModDR * myCache.reducedRepetitionsPerLength[0] + 0.5));
+  int B_max = static_cast< int>(std::floor(
+      minModDR * myCache.reducedRepetitionsPerLength[1] + 0.5));
+  int C_max = static_cast< int>(std::floor(
+      minModDR * myCache.reducedRepetitionsPerLength[2] + 0.5));
+
+  bool problemDuringCalculation = false;
+  problemDuringCalculation |= capMultiples(A_max, maxCellMultiples);
+  problemDuringCalculation |= capMultiples(B_max, maxCellMultiples);
+  problemDuringCalculation |= capMultiples(C_max, maxCellMultiples);
+  countImages((2 * A_max + 1) * (2 * B_max + 1) * (2 * C_max + 1),
+      problemDuringCalculation);
+
+  // Loop variables
+  arma::vec3 minDR = dR;
+  double modDRSq;
+  arma::vec3 nA, nAPlusNB, dRImg;
+  for(int a = -A_max; a <= A_max; ++a)
+  {
+    nA = a * myCache.reducedOrtho.col(0);
+    for(int b = -B_max; b <= B_max; ++b)
+    {
+      nAPlusNB = nA + b * myCache.reducedOrtho.col(1);
+      for(int c = -C_max; c <= C_max; ++c)
+      {
+        dRImg = nAPlusNB + c * myCache.reducedOrtho.col(2) + dR;
+
+        modDRSq = dot(dRImg, dRImg);
+        if(modDRSq < minModDRSq)
+        {
+          minModDRSq = modDRSq;
+          minDR = dRImg;
+        }
+      }
+    }
+  }
+
+  return minDR;
+}
+
+inline bool
+UniversalCrystalDistanceCalculator::getVecsBetween(const arma::vec3 & a,
+    const arma::vec3 & b, const double cutoff,
+    std::vector< arma::vec3> & outValues, const size_t maxValues,
+    const unsigned int maxCellMultiples) const
+{
+  const UnitCell & cell = *myUnitCell;
+  const double vol = cell.getVolume();
+  const arma::vec3 dR = b - a;
+
+  int A_max = static_cast< int>(std::floor(
+      getNumPlaneRepetitionsToBoundSphere(
+          cutoff + std::abs(arma::dot(dR, myCache.bCrossCHat)), vol,
+          myCache.bCrossCLen)));
+  int B_max = static_cast< int>(std::floor(
+      getNumPlaneRepetitionsToBoundSphere(
+          cutoff + std::abs(arma::dot(dR, myCache.aCrossCHat)), vol,
+          myCache.aCrossCLen)));
+  int C_max = static_cast< int>(std::floor(
+      getNumPlaneRepetitionsToBoundSphere(
+          cutoff + std::abs(arma::dot(dR, myCache.aCrossBHat)), vol,
+          myCache.aCrossBLen)));
+
+  bool problemDuringCalculation = false;
+  problemDuringCalculation |= capMultiples(A_max, maxCellMultiples);
+  problemDuringCalculation |= capMultiples(B_max, maxCellMultiples);
+  problemDuringCalculation |= capMultiples(C_max, maxCellMultiples);
+  countImages((2 * A_max + 1) * (2 * B_max + 1) * (2 * C_max + 1),
+      problemDuringCalculation);
+
+  const double cutoffSq = cutoff * cutoff;
+  arma::vec3 outVec;
+  size_t numFound = 0;
+  arma::vec3 rA, rAB;
+  for(int a = -A_max; a <= A_max; ++a)
+  {
+    rA = a * myCache.A;
+    for(int b = -B_max; b <= B_max; ++b)
+    {
+      rAB = rA + b * myCache.B;
+      for(int c = -C_max; c <= C_max; ++c)
+      {
+        outVec = rAB + c * myCache.C + dR;
+
+        if(arma::dot(outVec, outVec) < cutoffSq)
+        {
+          outValues.push_back(outVec);
+          if(++numFound >= maxValues)
+            return false;
+        }
+      }
+    }
+  }
+
+  // Completed successfully
+  return !problemDuringCalculation;
+}
+
 } // namespace common
 } // namespace spl
 
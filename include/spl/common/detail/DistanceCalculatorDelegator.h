@@ -0,0 +1,67 @@
+/*
+ * DistanceCalculatorDelegator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef DISTANCE_CALCULATOR_DELEGATOR_DETAIL_H
+#define DISTANCE_CALCULATOR_DELEGATOR_DETAIL_H
+
+// INCLUDES ///////////////////////////////////
+#include "spl/common/ClusterDistanceCalculator.h"
+#include "spl/common/OrthoCellDistanceCalculator.h"
+#include "spl/common/StaticDistanceCalculator.h"
+#include "spl/common/UniversalCrystalDistanceCalculator.h"
+
+namespace spl {
+namespace common {
+
+template< class Visitor>
+  typename Visitor::result_type
+  DistanceCalculatorDelegator::visit(Visitor & visitor) const
+  {
+    switch(myDelegateType)
+    {
+    case CalculatorType::CLUSTER:
+      return visitor(
+          StaticDistanceCalculator< ClusterDistanceCalculator>(
+              static_cast< const ClusterDistanceCalculator &>(*myDelegate)));
+    case CalculatorType::ORTHO_CELL:
+      return visitor(
+          StaticDistanceCalculator< OrthoCellDistanceCalculator>(
+              static_cast< const OrthoCellDistanceCalculator &>(*myDelegate)));
+    case CalculatorType::UNIVERSAL_CRYSTAL:
+      return visitor(
+          StaticDistanceCalculator< UniversalCrystalDistanceCalculator>(
+              static_cast< const UniversalCrystalDistanceCalculator &>(*myDelegate)));
+    default:
+      return visitor(StaticDistanceCalculator< DistanceCalculator>(*myDelegate));
+    }
+  }
+
+template< class Visitor>
+  typename Visitor::result_type
+  visitDistanceCalculator(const DistanceCalculator & calc, Visitor & visitor)
+  {
+    if(const DistanceCalculatorDelegator * const delegator =
+        dynamic_cast< const DistanceCalculatorDelegator *>(&calc))
+      return delegator->visit(visitor);
+    if(const ClusterDistanceCalculator * const cluster =
+        dynamic_cast< const ClusterDistanceCalculator *>(&calc))
+      return visitor(StaticDistanceCalculator< ClusterDistanceCalculator>(*cluster));
+    if(const OrthoCellDistanceCalculator * const ortho =
+        dynamic_cast< const OrthoCellDistanceCalculator *>(&calc))
+      return visitor(StaticDistanceCalculator< OrthoCellDistanceCalculator>(*ortho));
+    if(const UniversalCrystalDistanceCalculator * const universal =
+        dynamic_cast< const UniversalCrystalDistanceCalculator *>(&calc))
+      return visitor(
+          StaticDistanceCalculator< UniversalCrystalDistanceCalculator>(*universal));
+
+    return visitor(StaticDistanceCalculator< DistanceCalculator>(calc));
+  }
+
+}
+}
+
+#endif /* DISTANCE_CALCULATOR_DELEGATOR_DETAIL_H */
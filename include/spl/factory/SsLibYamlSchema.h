@@ -164,11 +164,13 @@ SCHEMER_MAP(CastepSchema, Castep)
 struct ExternalOptimiser
 {
   std::string exe;
+  bool persistent;
 };
 
 SCHEMER_MAP(ExternalOptimiserType, ExternalOptimiser)
 {
   element("exe", &ExternalOptimiser::exe);
+  element("persistent", &ExternalOptimiser::persistent)->defaultValue(false);
 }
 
 struct Optimiser
@@ -51,6 +51,18 @@ writeToStream(std::ostream & out, const double num,
 ::std::string
 toString(const double num, const unsigned digitsAfterDecimal);
 
+// Append the number exactly as toString() would format it, only going
+// through a stream for numbers that can't be formatted exactly without one
+void
+appendFixed(std::string * const buffer, const double num,
+    const unsigned digitsAfterDecimal);
+// Append the number as a stream with the given precision would format it
+void
+appendGeneral(std::string * const buffer, const double num,
+    const int precision);
+void
+appendUnsigned(std::string * const buffer, unsigned long num);
+
 }
 }
 
@@ -13,6 +13,13 @@
 #include "spl/io/IStructureReader.h"
 #include "spl/io/IStructureWriter.h"
 
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/foreach.hpp>
+
 // FORWARD DECLARATIONS ////////////////////////////////////
 
 namespace spl {
@@ -31,6 +38,27 @@ public:
   virtual void
   writeStructure(spl::common::Structure & str,
       const ResourceLocator & locator) const;
+  // Write a structure in res format to a stream, the default name is used
+  // in the title if the structure doesn't have one.
+  void
+  writeStructure(std::ostream & os, const common::Structure & str,
+      const std::string & defaultName = "") const;
+  // Append a structure in res format to a buffer
+  void
+  writeStructure(std::string * const buffer, const common::Structure & str,
+      const std::string & defaultName = "") const;
+
+  // Write each structure to <dir>/<name>.res where the name is that of the
+  // structure (or a unique name if it doesn't have one)
+  template< typename StructuresRange>
+    void
+    writeStructures(StructuresRange & structures,
+        const boost::filesystem::path & dir) const;
+  // Write the structures one after another to a stream
+  template< typename StructuresRange>
+    void
+    writeStructures(std::ostream & os,
+        const StructuresRange & structures) const;
 
   // From IStructureReader //
 
@@ -41,6 +69,10 @@ public:
   readStructures(StructuresContainer & outStructures,
       const ResourceLocator & resourceLocator) const;
 
+  // Read a single res format structure from a stream
+  spl::common::types::StructurePtr
+  readStructure(std::istream & is) const;
+
   virtual std::vector< std::string>
   getSupportedFileExtensions() const;
 
@@ -59,8 +91,37 @@ private:
 
   void
   writeTitle(std::ostream & os, const common::Structure & structure) const;
+
+  void
+  writeToDirectory(const std::vector< common::Structure *> & structures,
+      const boost::filesystem::path & dir) const;
+  void
+  writeToStream(std::ostream & os,
+      const std::vector< const common::Structure *> & structures) const;
 };
 
+template< typename StructuresRange>
+  void
+  ResReaderWriter::writeStructures(StructuresRange & structures,
+      const boost::filesystem::path & dir) const
+  {
+    std::vector< common::Structure *> toWrite;
+    BOOST_FOREACH(common::Structure & structure, structures)
+      toWrite.push_back(&structure);
+    writeToDirectory(toWrite, dir);
+  }
+
+template< typename StructuresRange>
+  void
+  ResReaderWriter::writeStructures(std::ostream & os,
+      const StructuresRange & structures) const
+  {
+    std::vector< const common::Structure *> toWrite;
+    BOOST_FOREACH(const common::Structure & structure, structures)
+      toWrite.push_back(&structure);
+    writeToStream(os, toWrite);
+  }
+
 }
 }
 
@@ -0,0 +1,100 @@
+/*
+ * SplIndex.h
+ *
+ * A sidecar index (<file>.idx) of the byte range of each entry under the
+ * structures key of an SPL YAML file so that a single structure can be read
+ * without parsing the whole file.  The index records the size and
+ * modification time (to the nanosecond, where the platform has it) of the
+ * file it was built from and is ignored if these don't match.  If an id
+ * appears more than once the last entry is the one indexed.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef SPL__IO__SPL_INDEX_H_
+#define SPL__IO__SPL_INDEX_H_
+
+// INCLUDES /////////////////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+namespace spl {
+namespace io {
+
+class SplIndex
+{
+public:
+  struct Range
+  {
+    Range();
+    Range(const size_t offset_, const size_t length_);
+    size_t offset;
+    size_t length;
+  };
+  typedef ::std::vector< ::std::pair< ::std::string, Range> > Entries;
+
+  static ::boost::filesystem::path
+  indexPath(const ::boost::filesystem::path & filepath);
+  // Delete the index of the file, if there is one
+  static void
+  remove(const ::boost::filesystem::path & filepath);
+
+  explicit
+  SplIndex(const ::boost::filesystem::path & filepath);
+
+  // Load the index if it exists and is up to date
+  bool
+  loadIfFresh();
+  // Build the index by scanning the file, this doesn't write anything
+  bool
+  build();
+  // Write the index out next to the file, stamped with the state of the file
+  // when it was loaded or built
+  bool
+  save() const;
+
+  const Range *
+  find(const ::std::string & id) const;
+
+  // Add entries that have just been appended to the file, the index must
+  // have been loaded before the file was changed
+  void
+  appended(const Entries & entries);
+
+private:
+  typedef ::std::map< ::std::string, Range> Ranges;
+
+  struct FileStamp
+  {
+    FileStamp();
+    bool
+    operator ==(const FileStamp & rhs) const;
+
+    size_t size;
+    ::std::time_t modified;
+    long modifiedNanoseconds;
+  };
+
+  bool
+  getFileStamp(FileStamp * const stamp) const;
+  void
+  writeHeader(::std::ostream & os, const FileStamp & stamp) const;
+
+  const ::boost::filesystem::path myFilepath;
+  Ranges myRanges;
+  FileStamp myStamp;
+  bool myLoaded;
+};
+
+}
+}
+
+#endif /* SPL__IO__SPL_INDEX_H_ */
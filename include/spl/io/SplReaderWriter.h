@@ -15,6 +15,8 @@
 
 #include <vector>
 
+#include <boost/foreach.hpp>
+
 #include "spl/io/StructureYamlGenerator.h"
 
 // FORWARD DECLARATIONS ////////////////////////////////////
@@ -28,6 +30,18 @@ public:
   static const unsigned int DIGITS_AFTER_DECIMAL;
   static const std::string DEFAULT_EXTENSION;
 
+  SplReaderWriter();
+
+  // In append mode structures are added to the end of the file, as a new
+  // YAML document, without reading it.  Ids are not checked so writing a
+  // structure with an existing id leaves both entries in the file until it is
+  // compacted, when reading the last entry for an id is the one used.  Files
+  // that don't end in a block of structures are rewritten as usual.
+  void
+  setAppend(const bool append);
+  bool
+  getAppend() const;
+
   // Write a structure out to disk.
   // The user can supply their own species database, however it is up to them
   // to make sure that the implementation is thread safe if necessary.
@@ -35,6 +49,25 @@ public:
   writeStructure(spl::common::Structure & str,
       const ResourceLocator & locator) const;
 
+  // Write a range of structures to one file in a single pass, each structure
+  // is given an id from its name (or a unique name) and the id of the
+  // locator is ignored
+  template< typename StructuresRange>
+    void
+    writeStructures(StructuresRange & structures,
+        const ResourceLocator & locator) const;
+
+  // Rewrite the file as a single document keeping only the last entry for
+  // each structure id
+  bool
+  compact(const ResourceLocator & locator) const;
+  // Build (if needed) and save the index of the file so that structures can be
+  // read by id without parsing the whole file.  Writing, appending and
+  // compacting keep the index up to date and reading by id rebuilds a stale
+  // one so this is only needed for files changed by something else.
+  bool
+  updateIndex(const ResourceLocator & locator) const;
+
   // From IStructureReader //
   virtual spl::common::types::StructurePtr
   readStructure(const ResourceLocator & resourceLocator) const;
@@ -49,8 +82,30 @@ public:
 
   virtual bool
   multiStructureSupport() const;
+
+private:
+  typedef ::std::vector< common::Structure *> Structures;
+
+  void
+  write(const Structures & structures, const ResourceLocator & locator) const;
+  bool
+  append(const Structures & structures, const ResourceLocator & locator) const;
+
+  bool myAppend;
 };
 
+template< typename StructuresRange>
+  void
+  SplReaderWriter::writeStructures(StructuresRange & structures,
+      const ResourceLocator & locator) const
+  {
+    Structures toWrite;
+    BOOST_FOREACH(common::Structure & structure, structures)
+      toWrite.push_back(&structure);
+    if(!toWrite.empty())
+      write(toWrite, ResourceLocator(locator.path()));
+  }
+
 }
 }
 
@@ -15,6 +15,9 @@
 
 #include <vector>
 
+#include <boost/filesystem/path.hpp>
+#include <boost/foreach.hpp>
+
 // FORWARD DECLARATIONS ////////////////////////////////////
 
 namespace spl {
@@ -33,6 +36,22 @@ public:
   virtual void
   writeStructure(spl::common::Structure & str,
       const ResourceLocator & locator) const;
+  // Append a structure in xyz format to a buffer
+  void
+  writeStructure(std::string * const buffer, const common::Structure & str,
+      const std::string & defaultName = "") const;
+
+  // Write each structure to <dir>/<name>.xyz where the name is that of the
+  // structure (or a unique name if it doesn't have one)
+  template< typename StructuresRange>
+    void
+    writeStructures(StructuresRange & structures,
+        const boost::filesystem::path & dir) const;
+  // Write the structures one after another to a stream as a multi-frame xyz
+  template< typename StructuresRange>
+    void
+    writeStructures(std::ostream & os,
+        const StructuresRange & structures) const;
 
   virtual common::types::StructurePtr readStructure(
     const ResourceLocator & resourceLocator
@@ -54,8 +73,37 @@ public:
 private:
   void
   readAtoms(std::istream * const is, common::Structure * const structure) const;
+
+  void
+  writeToDirectory(const std::vector< common::Structure *> & structures,
+      const boost::filesystem::path & dir) const;
+  void
+  writeToStream(std::ostream & os,
+      const std::vector< const common::Structure *> & structures) const;
 };
 
+template< typename StructuresRange>
+  void
+  XyzReaderWriter::writeStructures(StructuresRange & structures,
+      const boost::filesystem::path & dir) const
+  {
+    std::vector< common::Structure *> toWrite;
+    BOOST_FOREACH(common::Structure & structure, structures)
+      toWrite.push_back(&structure);
+    writeToDirectory(toWrite, dir);
+  }
+
+template< typename StructuresRange>
+  void
+  XyzReaderWriter::writeStructures(std::ostream & os,
+      const StructuresRange & structures) const
+  {
+    std::vector< const common::Structure *> toWrite;
+    BOOST_FOREACH(const common::Structure & structure, structures)
+      toWrite.push_back(&structure);
+    writeToStream(os, toWrite);
+  }
+
 }
 }
 
@@ -0,0 +1,94 @@
+/*
+ * KdTree.h
+ *
+ * A static 3D k-d tree over a set of points supporting radius and k-nearest
+ * neighbour queries.  Does not know about periodicity.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef KD_TREE_H
+#define KD_TREE_H
+
+// INCLUDES ////////////
+#include "spl/SSLib.h"
+
+#include <vector>
+
+#include <armadillo>
+
+// DEFINITION ///////////////////////
+
+namespace spl {
+namespace math {
+
+class KdTree
+{
+public:
+  static const size_t MAX_LEAF_SIZE;
+
+  KdTree();
+
+  // Build the tree from a 3xN matrix of points, any existing tree is discarded
+  void
+  build(const arma::mat & points);
+  void
+  clear();
+
+  size_t
+  size() const;
+  bool
+  empty() const;
+
+  // Get the indices of all points that are within radius of the query point.
+  // Indices are appended to the output in no particular order.  Returns the
+  // number of points found.
+  size_t
+  radiusQuery(const arma::vec3 & point, const double radius,
+      std::vector< size_t> * const indices) const;
+
+  // Get the indices of the k points nearest to the query point sorted by
+  // increasing distance, optionally with their squared distances.  Returns the
+  // number of points found which may be less than k.
+  size_t
+  nearestQuery(const arma::vec3 & point, const size_t k,
+      std::vector< size_t> * const indices,
+      std::vector< double> * const distsSq = NULL) const;
+
+private:
+  struct Node
+  {
+    // Range into myIndices spanned by this node
+    size_t begin;
+    size_t end;
+    // Children, or zero for a leaf (the root can never be a child)
+    size_t left;
+    size_t right;
+    unsigned int axis;
+    double split;
+  };
+  typedef std::pair< double, size_t> DistIndex;
+  class CompareAxis;
+
+  size_t
+  buildNode(const size_t begin, const size_t end);
+  void
+  radiusQuery(const size_t nodeIdx, const double * const point,
+      const double radiusSq, std::vector< size_t> * const indices) const;
+  void
+  nearestQuery(const size_t nodeIdx, const double * const point,
+      const size_t k, std::vector< DistIndex> * const heap) const;
+
+  inline double
+  distSq(const size_t idx, const double * const point) const;
+
+  arma::mat myPoints;
+  std::vector< size_t> myIndices;
+  std::vector< Node> myNodes;
+};
+
+}
+}
+
+#endif /* KD_TREE_H */
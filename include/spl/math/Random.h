@@ -21,8 +21,14 @@
 namespace spl {
 namespace math {
 
+// Seed the random number generators.  When thread aware each thread has its
+// own generator and these are all (re)seeded with distinct seeds derived from
+// this one, the first thread to use a generator gets the seed itself.  Should
+// not be called while other threads are generating numbers.
 void seed();
 void seed(const unsigned int randSeed);
+// Seed only the generator of the calling thread
+void seedThread(const unsigned int randSeed);
 
 template <typename T>
 T randu();
@@ -29,6 +29,9 @@ public:
   template <class InputIterator>
   void insert(InputIterator first, InputIterator last);
 
+  // Combine with statistics gathered separately e.g. on another thread
+  void merge(const GenericRunningStats & other);
+
   int num() const;
   bool empty() const;
 
@@ -47,6 +50,16 @@ private:
   T myMax;
 };
 
+// Merging and the bulk insert combine variances with Chan et al.'s pairwise
+// formula.  Single inserts do NOT use Welford's update: they sum the
+// deviations from a shift (the first value, or the mean after a merge) and
+// the variance is worked out from those sums when asked for.  This avoids a
+// division per value, roughly 3x faster in the comparator hot path, at the
+// cost of some precision: the relative error of the variance is about
+// machine epsilon times (1 + ((mean - shift) / stdDev)^2) where Welford's
+// would be about epsilon.  It only matters if the first value is many
+// standard deviations from the mean, in which case use the bulk insert, which
+// shifts by the mean of the values it is given.
 class RunningStats
 {
 public:
@@ -56,6 +69,12 @@ public:
 
   template <class InputIterator>
   void insert(InputIterator first, InputIterator last);
+  // Bulk insert from contiguous memory, the per value loops have no
+  // dependencies between iterations other than reductions so they vectorise
+  void insert(const double * const values, const size_t n);
+
+  // Combine with statistics gathered separately e.g. on another thread
+  void merge(const RunningStats & other);
 
   unsigned int num() const;
 
@@ -66,13 +85,25 @@ public:
   double sum() const;
   double sqSum() const;
   double rms() const;
+  // Population variance
+  double variance() const;
+  double stdDev() const;
+
+  void clear();
 
 private:
+  // Sum of squared deviations from the mean
+  double m2() const;
+
   unsigned int myNum;
   double mySum;
   double mySqSum;
   double myMin;
   double myMax;
+  double myShift;
+  // Sums of (x - shift) and (x - shift)^2
+  double myShiftedSum;
+  double myShiftedSqSum;
 };
 
 template <class InputIterator>
@@ -92,7 +123,6 @@ template< typename T>
 void
 GenericRunningStats<T>::insert(const T & x)
 {
-  ++myNum;
   if(!empty())
   {
     mySum += x;
@@ -101,6 +131,7 @@ GenericRunningStats<T>::insert(const T & x)
   }
   else
     mySum = myMin = myMax = x;
+  ++myNum;
 }
 
 template <typename T>
@@ -111,6 +142,23 @@ void GenericRunningStats<T>::insert(InputIterator first, InputIterator last)
     insert(*it);
 }
 
+template <typename T>
+void GenericRunningStats<T>::merge(const GenericRunningStats & other)
+{
+  if(other.empty())
+    return;
+  if(empty())
+  {
+    *this = other;
+    return;
+  }
+
+  myNum += other.myNum;
+  mySum += other.mySum;
+  myMin = ::std::min(myMin, other.myMin);
+  myMax = ::std::max(myMax, other.myMax);
+}
+
 template< typename T>
 int
 GenericRunningStats<T>::num() const
@@ -34,7 +34,9 @@ namespace detail {
 template< typename T, bool isIntegral = boost::is_integral< T>::value>
   struct Rand;
 
-extern boost::mt19937 mt19937;
+// The generator used by the calling thread
+boost::mt19937 &
+generator();
 
 // Specialisations
 template< typename T>
@@ -43,25 +45,18 @@ template< typename T>
     static T
     getUniform(const T to)
     {
-#ifdef SSLIB_USE_BOOST_OLD_RANDOM
-      const boost::uniform_int< T> dist(0, to);
-      boost::variate_generator<boost::mt19937&, boost::uniform_int< T> > gen(mt19937, dist);
-      return gen();
-#else
-      const boost::random::uniform_int_distribution< T> dist(0, to);
-      return dist(mt19937);
-#endif
+      return getUniform(0, to);
     }
     static T
     getUniform(const T from, const T to)
     {
 #ifdef SSLIB_USE_BOOST_OLD_RANDOM
       const boost::uniform_int< T> dist(from, to);
-      boost::variate_generator<boost::mt19937&, boost::uniform_int< T> > gen(mt19937, dist);
+      boost::variate_generator<boost::mt19937&, boost::uniform_int< T> > gen(generator(), dist);
       return gen();
 #else
       const boost::random::uniform_int_distribution< T> dist(from, to);
-      return dist(mt19937);
+      return dist(generator());
 #endif
     }
   };
@@ -69,32 +64,23 @@ template< typename T>
 template< typename T>
   struct Rand< T, false>
   {
-    static boost::normal_distribution< T> normal;
-#ifdef SSLIB_USE_BOOST_OLD_RANDOM
-    static const boost::uniform_real< T> uniform;
-    static boost::variate_generator< boost::mt19937 &, boost::uniform_real< T> > uniformGenerator;
-    static boost::variate_generator< boost::mt19937 &, boost::normal_distribution< T> > normalGenerator;
-#else
-    static const boost::random::uniform_real_distribution< T> uniform;
-#endif
-
     static T
     getUniform()
     {
 #ifdef SSLIB_USE_BOOST_OLD_RANDOM
-      return uniformGenerator();
+      const boost::uniform_real< T> uniform(0.0, 1.0);
+      boost::variate_generator< boost::mt19937 &, boost::uniform_real< T> > gen(
+          generator(), uniform);
+      return gen();
 #else
-      return uniform(mt19937);
+      const boost::random::uniform_real_distribution< T> uniform(0.0, 1.0);
+      return uniform(generator());
 #endif
     }
     static T
     getUniform(const T to)
     {
-#ifdef SSLIB_USE_BOOST_OLD_RANDOM
-      return uniformGenerator() * to;
-#else
-      return uniform(mt19937) * to;
-#endif
+      return getUniform() * to;
     }
     static T
     getUniform(const T from, const T to)
@@ -104,11 +90,7 @@ template< typename T>
     static T
     getNormal()
     {
-#ifdef SSLIB_USE_BOOST_OLD_RANDOM
-      return normalGenerator();
-#else
-      return normal(mt19937);
-#endif
+      return getNormal(0.0, 1.0);
     }
     static T
     getNormal(const T mean, const T variance)
@@ -116,45 +98,20 @@ template< typename T>
       boost::normal_distribution< T> normal(mean, variance);
 #ifdef SSLIB_USE_BOOST_OLD_RANDOM
       boost::variate_generator<boost::mt19937&, boost::normal_distribution< T> >
-      normalGen(mt19937, normal);
-      normalGen();
+      normalGen(generator(), normal);
+      return normalGen();
 #else
-      return normal(mt19937);
+      return normal(generator());
 #endif
     }
   };
 
-template< typename T>
-  boost::normal_distribution< T> Rand< T, false>::normal(0.0, 1.0);
-#ifdef SSLIB_USE_BOOST_OLD_RANDOM
-template< typename T>
-  const boost::uniform_real<T> Rand< T, false>::uniform(0.0, 1.0);
-template< typename T>
-  boost::variate_generator< boost::mt19937 &, boost::uniform_real< T> >
-  Rand< T, false>::uniformGenerator(mt19937, uniform);
-template< typename T>
-  boost::variate_generator< boost::mt19937 &, boost::normal_distribution< T> >
-  Rand< T, false>::normalGenerator(mt19937, normal);
-#else
-template< typename T>
-  const boost::random::uniform_real_distribution< T> Rand< T, false>::uniform(
-      0.0, 1.0);
-#endif
-
 } // namespace detail
 
-inline void
-seed(const unsigned int randSeed)
-{
-  std::srand(randSeed);
-  detail::mt19937.seed(randSeed);
-}
-
 inline void
 seed()
 {
-  std::srand(static_cast< unsigned int>(time(NULL)));
-  detail::mt19937.seed(static_cast< unsigned int>(time(NULL)));
+  seed(static_cast< unsigned int>(time(NULL)));
 }
 
 template< typename T>
@@ -0,0 +1,67 @@
+/*
+ * PipedProcess.h
+ *
+ * A child process whose stdin and stdout are connected to us by pipes so
+ * that it can be kept alive and talked to over many requests.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef PIPED_PROCESS_H
+#define PIPED_PROCESS_H
+
+// INCLUDES /////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+// FORWARD DECLARES ////////////////////////////////
+
+// DEFINES ////////////////////////////////////////
+
+namespace spl {
+namespace os {
+
+class PipedProcess : boost::noncopyable
+{
+public:
+  PipedProcess();
+  ~PipedProcess();
+
+  // Launch the process, the first entry is the executable.  Returns false if
+  // the process couldn't be started or one is already running.
+  bool
+  start(const ::std::vector< ::std::string> & exeAndArgv);
+  bool
+  isRunning() const;
+  // Close the pipes (signalling EOF to the child) and wait for it to exit.
+  // Returns the exit code of the child or -1 if it didn't exit normally.
+  int
+  stop();
+
+  // Write all of the data to the child's stdin
+  bool
+  write(const ::std::string & data);
+  // Read exactly numBytes from the child's stdout
+  bool
+  read(::std::string * const data, const size_t numBytes);
+  // Read up to (but not including) the next newline from the child's stdout
+  bool
+  readLine(::std::string * const line);
+
+private:
+  void
+  closePipes();
+
+  int myPid;
+  int myToChild;
+  int myFromChild;
+};
+
+}
+}
+
+#endif /* PIPED_PROCESS_H */
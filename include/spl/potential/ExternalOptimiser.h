@@ -14,8 +14,15 @@
 
 #ifdef SPL_USE_YAML
 
+#include <istream>
+#include <ostream>
 #include <string>
 
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <boost/thread/mutex.hpp>
+#endif
+
+#include "spl/os/PipedProcess.h"
 #include "spl/potential/GeomOptimiser.h"
 #include "spl/io/ResReaderWriter.h"
 
@@ -25,12 +32,27 @@ namespace spl {
 // FORWARD DECLARATIONS ////////////////////////////////////
 
 namespace potential {
-class OptResults;
+struct OptResults;
 
+// Optimise structures using an external program.  By default the program is
+// run once per optimisation as:
+//   [runCommand] [settings yaml] [structure res]
+// and is expected to append the results to the settings file and overwrite
+// the structure file with the optimised structure.
+//
+// In persistent mode the run command is launched once and kept alive.  Each
+// optimisation then sends two frames to its stdin: the settings yaml and the
+// structure in res format.  The program should reply on stdout with two
+// frames: the results yaml and the optimised structure in res format (which
+// may be empty if the optimisation failed).  A frame is the payload length in
+// bytes as a decimal number followed by a newline and then the payload
+// itself.  When the optimiser is destroyed stdin is closed and the program
+// should exit.
 class ExternalOptimiser : public GeomOptimiser
 {
 public:
-  ExternalOptimiser(const std::string & runCommand);
+  ExternalOptimiser(const std::string & runCommand, const bool persistent =
+      false);
   virtual
   ~ExternalOptimiser()
   {
@@ -43,15 +65,39 @@ public:
   optimise(common::Structure & structure, OptimisationData & data,
       const OptimisationSettings & options) const;
 
+  bool
+  isPersistent() const;
+
 private:
+  OptimisationOutcome
+  optimiseInWorker(common::Structure & structure, OptimisationData & data,
+      const OptimisationSettings & options) const;
   void
   writeSettings(const std::string & filename,
       const OptimisationSettings & settings) const;
+  void
+  writeSettings(std::ostream & os, const OptimisationSettings & settings) const;
   bool
   readResults(const std::string & filename, OptResults * const results) const;
+  bool
+  readResults(std::istream & is, OptResults * const results) const;
+  bool
+  writeFrame(const std::string & payload) const;
+  bool
+  readFrame(std::string * const payload) const;
+  void
+  copyResults(const OptResults & results, OptimisationData * const data) const;
 
   const std::string myRunCommand;
+  const bool myPersistent;
   const io::ResReaderWriter myResReaderWriter;
+
+  // The worker is started lazily on the first optimisation
+  mutable os::PipedProcess myWorker;
+#ifdef SPL_ENABLE_THREAD_AWARE
+  // Only one optimisation at a time can talk to the worker
+  mutable boost::mutex myWorkerMutex;
+#endif
 };
 
 }
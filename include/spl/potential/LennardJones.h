@@ -98,9 +98,18 @@ public:
 
 private:
   typedef GenericPotentialEvaluator< LennardJones> Evaluator;
+  struct EvaluatePairsVisitor;
 
   static const double MIN_SEPARATION_SQ;
 
+  // Accumulate the energy, forces and stress from all pairs.  Templated on
+  // the distance calculator so the loop is specialised for each type.
+  // Returns true if there was a problem getting all the interaction vectors.
+  template< class DistCalc>
+    bool
+    evaluatePairs(const DistCalc & distCalc,
+        const common::Structure & structure, PotentialData & data) const;
+
   std::pair< double, double>
   evaluate(const double r, const Params & params) const;
 
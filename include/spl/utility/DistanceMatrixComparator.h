@@ -90,13 +90,20 @@ private:
   bool
   areComparable(const DataTyp & str1Data, const DataTyp & str2Data) const;
 
+  // The methods below stop as soon as the distance can't be below the
+  // threshold in which case the returned lower bound is at least the threshold
+
+  double
+  compare(const DataTyp & str1Data, const DataTyp & str2Data,
+      const double threshold) const;
+
   double
-  compareStructuresFull(const DataTyp & str1Data,
-      const DataTyp & str2Data) const;
+  compareStructuresFull(const DataTyp & str1Data, const DataTyp & str2Data,
+      const double threshold) const;
 
   double
-  compareStructuresFast(const DataTyp & str1Data,
-      const DataTyp & str2Data) const;
+  compareStructuresFast(const DataTyp & str1Data, const DataTyp & str2Data,
+      const double threshold) const;
 
   const size_t myFastComparisonAtomsLimit;
   const double myTolerance;
@@ -0,0 +1,132 @@
+/*
+ * FingerprintComparator.h
+ *
+ * Compares structures using fixed length fingerprints made up of one block
+ * per pair of species.  Each block is the smoothed partial radial
+ * distribution function minus one, sampled on a regular grid up to the
+ * cutoff, so two fingerprints with the same species have the same length and
+ * can be compared with a single pass over contiguous memory.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef FINGERPRINT_COMPARATOR_H
+#define FINGERPRINT_COMPARATOR_H
+
+// INCLUDES /////////////////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "spl/common/AtomSpeciesId.h"
+#include "spl/utility/IStructureComparator.h"
+
+namespace spl {
+// FORWARD DECLARATIONS ////////////////////////////////////
+namespace common {
+class Structure;
+}
+
+namespace utility {
+
+struct FingerprintMetric
+{
+  enum Value
+  {
+    // Half of one minus the cosine similarity, in the range [0, 1]
+    COSINE,
+    // Euclidean distance divided by the square root of the fingerprint length
+    EUCLIDEAN
+  };
+};
+
+class FingerprintComparisonData
+{
+public:
+  typedef ::std::vector< float> Fingerprint;
+
+  FingerprintComparisonData(const common::Structure & structure,
+      const double cutoff, const double binWidth, const double smearing,
+      const bool volumeAgnostic);
+
+  // Sorted, the fingerprint has a block for each pair (i <= j) in this order
+  ::std::vector< common::AtomSpeciesId::Value> species;
+  Fingerprint fingerprint;
+  // Euclidean norm of the fingerprint
+  float norm;
+};
+
+class FingerprintComparator : public IStructureComparator
+{
+public:
+  typedef FingerprintComparisonData DataTyp;
+  typedef IBufferedComparator BufferedTyp;
+  typedef ::spl::UniquePtr< DataTyp>::Type ComparisonDataPtr;
+
+  static const double DEFAULT_TOLERANCE;
+  static const double DEFAULT_CUTOFF;
+  static const double DEFAULT_BIN_WIDTH;
+  static const double DEFAULT_SMEARING;
+
+  struct ConstructionInfo
+  {
+    ConstructionInfo()
+    {
+      tolerance = DEFAULT_TOLERANCE;
+      cutoff = DEFAULT_CUTOFF;
+      binWidth = DEFAULT_BIN_WIDTH;
+      smearing = DEFAULT_SMEARING;
+      volumeAgnostic = false;
+      metric = FingerprintMetric::COSINE;
+    }
+    double tolerance;
+    double cutoff;
+    double binWidth;
+    // Standard deviation of the Gaussian each distance is smeared by
+    double smearing;
+    // Scale structures to unit volume per atom before fingerprinting
+    bool volumeAgnostic;
+    FingerprintMetric::Value metric;
+  };
+
+  FingerprintComparator();
+  FingerprintComparator(const ConstructionInfo & info);
+
+  // From IStructureComparator ////////////////
+
+  virtual double
+  compareStructures(const spl::common::Structure & str1,
+      const spl::common::Structure & str2) const;
+  virtual bool
+  areSimilar(const spl::common::Structure & str1,
+      const spl::common::Structure & str2) const;
+  virtual ::boost::shared_ptr< BufferedTyp>
+  generateBuffered() const;
+  // Only the Euclidean distance is a metric
+  virtual bool
+  isMetric() const;
+
+  // End from IStructureComparator /////////////
+
+  // Methods needed to conform to expectations laid out by GenericBufferedComparator ///
+  double
+  compareStructures(const FingerprintComparisonData & data1,
+      const FingerprintComparisonData & data2) const;
+  bool
+  areSimilar(const FingerprintComparisonData & data1,
+      const FingerprintComparisonData & data2) const;
+  ComparisonDataPtr
+  generateComparisonData(const ::spl::common::Structure & str) const;
+  // End conformation methods //////////////
+
+private:
+  const ConstructionInfo myInfo;
+};
+
+}
+}
+
+#endif /* FINGERPRINT_COMPARATOR_H */
@@ -1,6 +1,10 @@
 /*
  * HeterogeneousMap.h
  *
+ * Values are stored in a vector sorted by key.  The common types (double,
+ * int, unsigned int, string and mat33) are stored inline, anything else is
+ * held in a boost::any.  Inserting or erasing a value may invalidate pointers
+ * to the other values in the map.
  *
  *  Created on: Aug 17, 2011
  *      Author: Martin Uhrin
@@ -11,11 +15,14 @@
 
 // INCLUDES /////////////////////////////////////////////
 
-#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/any.hpp>
-#include <boost/iterator/iterator_facade.hpp>
-#include <boost/utility.hpp>
+#include <boost/variant.hpp>
+
+#include <armadillo>
 
 #include "spl/utility/HeterogeneousMapKey.h"
 
@@ -24,9 +31,16 @@
 namespace spl {
 namespace utility {
 
+namespace detail {
+typedef ::boost::variant< double, int, unsigned int, ::std::string,
+    ::arma::mat33, ::boost::any> HeterogeneousMapValue;
+template< typename T, bool Inline>
+  struct HeterogeneousMapValueAccess;
+}
+
 class HeterogeneousMap
 {
-  typedef std::map< KeyId *, boost::any> AnyMap;
+  typedef detail::HeterogeneousMapValue Value;
 public:
 
   template< typename Type>
@@ -86,16 +100,37 @@ public:
   clear();
 
 private:
+  struct Entry
+  {
+    Entry(KeyId * const key_, const Value & value_) :
+        key(key_), value(value_)
+    {
+    }
+    KeyId * key;
+    Value value;
+  };
+  typedef std::vector< Entry> Entries;
+
+  template< typename T>
+    static Value
+    makeValue(const T & value);
+
+  Entries::iterator
+  lowerBound(const KeyId * const key);
+  Entries::const_iterator
+  lowerBound(const KeyId * const key) const;
+  Value *
+  findValue(const KeyId * const key);
+  const Value *
+  findValue(const KeyId * const key) const;
 
-  std::pair< AnyMap::iterator, bool>
-  insert(const AnyMap::value_type & value);
-  std::pair< AnyMap::iterator, bool>
-  insert(const AnyMap::value_type & value, const bool overwrite);
+  std::pair< Entries::iterator, bool>
+  insert(KeyId * const key, const Value & value, const bool overwrite);
 
   size_t
   eraseNoNotify(KeyId & key);
 
-  AnyMap myAnyMap;
+  Entries myEntries;
 
   friend KeyId::~KeyId();
 };
@@ -43,6 +43,13 @@ public:
 		const spl::common::Structure & str2) const = 0;
 
   virtual ::boost::shared_ptr<IBufferedComparator> generateBuffered() const = 0;
+
+  // Does compareStructures satisfy the triangle inequality?  Indices that
+  // prune using distances rely on this.
+  virtual bool isMetric() const
+  {
+    return false;
+  }
 };
 
 }
@@ -0,0 +1,146 @@
+/*
+ * Instrumentation.h
+ *
+ * Lightweight named timers, counters and histograms.  Recording is off by
+ * default and can be switched on at runtime with setEnabled() or by setting
+ * the SPL_INSTRUMENTATION environment variable.  If SPL_INSTRUMENTATION_REPORT
+ * is set to a path the report is written there at exit (YAML if the path ends
+ * in .yaml or .yml, JSON otherwise).
+ *
+ * Values are accumulated per thread, without locking, and only merged when a
+ * report is requested.  Names should be string literals.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef SPL__UTILITY__INSTRUMENTATION_H_
+#define SPL__UTILITY__INSTRUMENTATION_H_
+
+// INCLUDES /////////////////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <map>
+#include <ostream>
+#include <string>
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <boost/atomic.hpp>
+#endif
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace spl {
+namespace utility {
+namespace instrumentation {
+
+namespace detail {
+#ifdef SPL_ENABLE_THREAD_AWARE
+extern ::boost::atomic< bool> enabled;
+#else
+extern bool enabled;
+#endif
+}
+
+inline bool
+isEnabled()
+{
+#ifdef SPL_ENABLE_THREAD_AWARE
+  return detail::enabled.load(::boost::memory_order_relaxed);
+#else
+  return detail::enabled;
+#endif
+}
+
+// Can be called at any time, threads see the change on their next record
+void
+setEnabled(const bool enabled);
+
+// Add n to the named counter
+void
+count(const char * const name, const long long n = 1);
+// Record a duration (in seconds) against the named timer
+void
+addTime(const char * const name, const double seconds);
+// Add a value to the named histogram
+void
+sample(const char * const name, const double value);
+
+struct TimerStats
+{
+  TimerStats();
+
+  void
+  add(const double seconds);
+  void
+  merge(const TimerStats & other);
+
+  long long calls;
+  double total;
+  double min;
+  double max;
+};
+
+// Values are binned by powers of two, bin i holds values in [2^(i-1), 2^i)
+// and all values <= 0 go into the lowest bin
+struct HistogramStats
+{
+  typedef ::std::map< int, long long> Bins;
+
+  HistogramStats();
+
+  void
+  add(const double value);
+  void
+  merge(const HistogramStats & other);
+
+  long long count;
+  double sum;
+  double min;
+  double max;
+  Bins bins;
+};
+
+struct Report
+{
+  typedef ::std::map< ::std::string, long long> Counters;
+  typedef ::std::map< ::std::string, TimerStats> Timers;
+  typedef ::std::map< ::std::string, HistogramStats> Histograms;
+
+  void
+  writeJson(::std::ostream & os) const;
+  void
+  writeYaml(::std::ostream & os) const;
+
+  Counters counters;
+  Timers timers;
+  Histograms histograms;
+};
+
+// Merge the values from all threads
+Report
+getReport();
+// Clear the values from all threads
+void
+reset();
+
+// Records the time between construction and destruction if instrumentation
+// was enabled at construction
+class ScopedTimer : ::boost::noncopyable
+{
+public:
+  explicit
+  ScopedTimer(const char * const name);
+  ~ScopedTimer();
+
+private:
+  const char * const myName;
+  const bool myEnabled;
+  ::boost::posix_time::ptime myStart;
+};
+
+}
+}
+}
+
+#endif /* SPL__UTILITY__INSTRUMENTATION_H_ */
@@ -1,7 +1,7 @@
 /*
  * MultiArray.h
  *
- * Array of runtime dimension.
+ * Array of runtime dimension, or of compile time dimension if Dims is given.
  *
  *  Created on: Aug 17, 2011
  *      Author: Martin Uhrin
@@ -13,6 +13,9 @@
 // INCLUDES /////////////////////////////////////////////
 #include "spl/SSLib.h"
 
+#include <vector>
+
+#include "spl/SSLibAssert.h"
 #include "spl/utility/MultiIdx.h"
 
 // FORWARD DECLARATIONS ////////////////////////////////////
@@ -20,8 +23,11 @@
 namespace spl {
 namespace utility {
 
+template <typename Typ, size_t Dims = 0>
+class MultiArray;
+
 template <typename Typ>
-class MultiArray
+class MultiArray<Typ, 0>
 {
 public:
 
@@ -62,7 +68,7 @@ myData(NULL),
 myDimTotals(NULL)
 {
 	// Make sure we're being asked to create an array larger than 0!
-	SSE_ASSERT(myExtents.dims() > 0);
+	SSLIB_ASSERT(myExtents.dims() > 0);
 
   init();
 }
@@ -83,7 +89,7 @@ template <typename Typ>
 MultiArray<Typ>::~MultiArray()
 {
 	if(myDimTotals)
-		delete myDimTotals;
+		delete [] myDimTotals;
 	if(myData)
 		delete [] myData;
 }
@@ -146,6 +152,82 @@ void MultiArray<Typ>::init()
 	myData = new Typ[myTotal];
 }
 
+// Fixed number of dimensions, indexed by MultiIdx<size_t, Dims> so that no
+// index arithmetic needs to go through the heap
+template <typename Typ, size_t Dims>
+class MultiArray
+{
+public:
+  typedef MultiIdx<size_t, Dims> Index;
+
+  explicit MultiArray(const Index & extents);
+  MultiArray(const Index & extents, const Typ & initialVal);
+
+  const Index & getExtents() const
+  {
+    return myExtents;
+  }
+
+  void fill(const Typ & value)
+  {
+    ::std::fill(myData.begin(), myData.end(), value);
+  }
+
+  // Accessors
+  Typ & operator[](const Index & idx)
+  {
+    return myData[globalIdx(idx)];
+  }
+  const Typ & operator[](const Index & idx) const
+  {
+    return myData[globalIdx(idx)];
+  }
+
+private:
+  void init();
+
+  size_t globalIdx(const Index & idx) const
+  {
+    size_t global = 0;
+    for(size_t i = 0; i < Dims; ++i)
+      global += myDimTotals[i] * idx[i];
+    return global;
+  }
+
+  const Index myExtents;
+  Index myDimTotals;
+  ::std::vector<Typ> myData;
+};
+
+template <typename Typ, size_t Dims>
+MultiArray<Typ, Dims>::MultiArray(const Index & extents):
+myExtents(extents)
+{
+  init();
+}
+
+template <typename Typ, size_t Dims>
+MultiArray<Typ, Dims>::MultiArray(const Index & extents,
+    const Typ & initialVal):
+myExtents(extents)
+{
+  init();
+  fill(initialVal);
+}
+
+template <typename Typ, size_t Dims>
+void MultiArray<Typ, Dims>::init()
+{
+  // Same convention as the runtime version: zero extents are ignored
+  size_t total = 1;
+  for(size_t i = 0; i < Dims; ++i)
+  {
+    myDimTotals[i] = myExtents[i] != 0 ? total : 0;
+    total *= (myExtents[i] != 0 ? myExtents[i] : 1);
+  }
+  myData.resize(total);
+}
+
 }}
 
 #endif /* MULTI_ARRAY_H */
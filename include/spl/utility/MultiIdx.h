@@ -1,7 +1,9 @@
 /*
  * MultiIdx.h
  *
- * An index in discreet n-space where n can be specified at runtime.
+ * An index in discreet n-space.  By default n is specified at runtime and the
+ * coordinates are stored on the heap, giving a non-zero Dims fixes n at
+ * compile time and stores the coordinates inline.
  *
  *  Created on: Aug 17, 2011
  *      Author: Martin Uhrin
@@ -13,7 +15,10 @@
 // INCLUDES /////////////////////////////////////////////
 #include "spl/SSLib.h"
 
+#include <algorithm>
+#include <cstring>
 #include <limits>
+#include <ostream>
 #include <stdexcept>
 
 #include <boost/scoped_array.hpp>
@@ -27,8 +32,12 @@
 namespace spl {
 namespace utility {
 
-template <typename Integer = unsigned int>
-class MultiIdx
+template <typename Integer = unsigned int, size_t Dims = 0>
+class MultiIdx;
+
+// Runtime number of dimensions
+template <typename Integer>
+class MultiIdx<Integer, 0>
 {
 public:
 
@@ -517,8 +526,229 @@ bool MultiIdx<Integer>::resize(const size_t dims)
   return true;
 }
 
+// Fixed number of dimensions.  The coordinates live inside the object so
+// copying, comparing and doing arithmetic on indices never allocates and the
+// loops have a constant trip count that the compiler can unroll.
+template <typename Integer, size_t Dims>
+class MultiIdx
+{
+public:
+  /** All coordinates start at zero */
+  MultiIdx();
+  /** All coordinates start at initialVal */
+  explicit MultiIdx(const Integer initialVal);
+  /** Copy the coordinates of a runtime index with the same dimension */
+  explicit MultiIdx(const MultiIdx<Integer> & dynamic);
+
+  /** Reset back to the origin */
+  void reset();
+
+  void fill(const Integer value);
+
+  Integer min() const;
+  Integer max() const;
+  Integer sum() const;
+  Integer product() const;
+
+  // Operators ///
+  Integer & operator[](const size_t dim)
+  {
+    SSLIB_ASSERT(dim < Dims);
+    return myIdx[dim];
+  }
+  const Integer & operator[](const size_t dim) const
+  {
+    SSLIB_ASSERT(dim < Dims);
+    return myIdx[dim];
+  }
+
+  MultiIdx operator +(const MultiIdx & rhs) const;
+  MultiIdx operator -(const MultiIdx & rhs) const;
+  MultiIdx & operator +=(const MultiIdx & rhs);
+  MultiIdx & operator -=(const MultiIdx & rhs);
+  bool operator ==(const MultiIdx & rhs) const;
+  bool operator !=(const MultiIdx & rhs) const;
+  bool operator <=(const MultiIdx & rhs) const;
+  bool operator >(const MultiIdx & rhs) const;
+
+  size_t dims() const
+  {
+    return Dims;
+  }
+
+  MultiIdx<Integer> toDynamic() const;
+
+private:
+  Integer myIdx[Dims];
+};
+
+template <typename Integer, size_t Dims>
+MultiIdx<Integer, Dims>::MultiIdx()
+{
+  reset();
 }
+
+template <typename Integer, size_t Dims>
+MultiIdx<Integer, Dims>::MultiIdx(const Integer initialVal)
+{
+  fill(initialVal);
 }
 
-#endif /* MULTI_IDX_H */
+template <typename Integer, size_t Dims>
+MultiIdx<Integer, Dims>::MultiIdx(const MultiIdx<Integer> & dynamic)
+{
+  if(dynamic.dims() != Dims)
+    throw ::std::logic_error("Multi index dimension mismatch");
+  for(size_t i = 0; i < Dims; ++i)
+    myIdx[i] = dynamic[i];
+}
+
+template <typename Integer, size_t Dims>
+void MultiIdx<Integer, Dims>::reset()
+{
+  fill(0);
+}
 
+template <typename Integer, size_t Dims>
+void MultiIdx<Integer, Dims>::fill(const Integer value)
+{
+  for(size_t i = 0; i < Dims; ++i)
+    myIdx[i] = value;
+}
+
+template <typename Integer, size_t Dims>
+Integer MultiIdx<Integer, Dims>::min() const
+{
+  Integer min = myIdx[0];
+  for(size_t i = 1; i < Dims; ++i)
+    min = ::std::min(min, myIdx[i]);
+  return min;
+}
+
+template <typename Integer, size_t Dims>
+Integer MultiIdx<Integer, Dims>::max() const
+{
+  Integer max = myIdx[0];
+  for(size_t i = 1; i < Dims; ++i)
+    max = ::std::max(max, myIdx[i]);
+  return max;
+}
+
+template <typename Integer, size_t Dims>
+Integer MultiIdx<Integer, Dims>::sum() const
+{
+  Integer sum = 0;
+  for(size_t i = 0; i < Dims; ++i)
+    sum += myIdx[i];
+  return sum;
+}
+
+template <typename Integer, size_t Dims>
+Integer MultiIdx<Integer, Dims>::product() const
+{
+  Integer product = 1;
+  for(size_t i = 0; i < Dims; ++i)
+    product *= myIdx[i];
+  return product;
+}
+
+template <typename Integer, size_t Dims>
+MultiIdx<Integer, Dims> MultiIdx<Integer, Dims>::operator+(
+    const MultiIdx & rhs) const
+{
+  MultiIdx result(*this);
+  result += rhs;
+  return result;
+}
+
+template <typename Integer, size_t Dims>
+MultiIdx<Integer, Dims> MultiIdx<Integer, Dims>::operator-(
+    const MultiIdx & rhs) const
+{
+  MultiIdx result(*this);
+  result -= rhs;
+  return result;
+}
+
+template <typename Integer, size_t Dims>
+MultiIdx<Integer, Dims> & MultiIdx<Integer, Dims>::operator+=(
+    const MultiIdx & rhs)
+{
+  for(size_t i = 0; i < Dims; ++i)
+    myIdx[i] += rhs.myIdx[i];
+  return *this;
+}
+
+template <typename Integer, size_t Dims>
+MultiIdx<Integer, Dims> & MultiIdx<Integer, Dims>::operator-=(
+    const MultiIdx & rhs)
+{
+  for(size_t i = 0; i < Dims; ++i)
+    myIdx[i] -= rhs.myIdx[i];
+  return *this;
+}
+
+template <typename Integer, size_t Dims>
+bool MultiIdx<Integer, Dims>::operator==(const MultiIdx & rhs) const
+{
+  for(size_t i = 0; i < Dims; ++i)
+  {
+    if(myIdx[i] != rhs.myIdx[i])
+      return false;
+  }
+  return true;
+}
+
+template <typename Integer, size_t Dims>
+bool MultiIdx<Integer, Dims>::operator!=(const MultiIdx & rhs) const
+{
+  return !(*this == rhs);
+}
+
+template <typename Integer, size_t Dims>
+bool MultiIdx<Integer, Dims>::operator<=(const MultiIdx & rhs) const
+{
+  for(size_t i = 0; i < Dims; ++i)
+  {
+    if(myIdx[i] > rhs.myIdx[i])
+      return false;
+  }
+  return true;
+}
+
+template <typename Integer, size_t Dims>
+bool MultiIdx<Integer, Dims>::operator>(const MultiIdx & rhs) const
+{
+  return !(*this <= rhs);
+}
+
+template <typename Integer, size_t Dims>
+MultiIdx<Integer> MultiIdx<Integer, Dims>::toDynamic() const
+{
+  MultiIdx<Integer> dynamic(Dims);
+  for(size_t i = 0; i < Dims; ++i)
+    dynamic[i] = myIdx[i];
+  return dynamic;
+}
+
+template <typename Integer, size_t Dims>
+inline MultiIdx<Integer, Dims> operator-(const MultiIdx<Integer, Dims> & rhs)
+{
+  MultiIdx<Integer, Dims> negation;
+  return negation -= rhs;
+}
+
+template <typename Integer, size_t Dims>
+inline ::std::ostream & operator <<(
+  ::std::ostream & os,
+  const MultiIdx<Integer, Dims> & rhs)
+{
+  for(size_t i = 0; i < Dims; ++i)
+    os << rhs[i] << " ";
+  return os;
+}
+
+}
+}
+
+#endif /* MULTI_IDX_H */
@@ -1,7 +1,8 @@
 /*
  * MultiIdxRange.h
  *
- * Range in multidimensional index space.
+ * Range in multidimensional index space, Dims has the same meaning as for
+ * MultiIdx.
  *
  *  Created on: Aug 17, 2011
  *      Author: Martin Uhrin
@@ -30,27 +31,28 @@
 namespace spl {
 namespace utility {
 
-template< typename Integer>
+template< typename Integer, size_t Dims = 0>
   class MultiIdxRange;
 
 namespace utility_detail {
 
-template< typename Integer>
+template< typename Integer, size_t Dims>
   class ConstMultiIdxIterator : public ::boost::iterator_facade<
-      ConstMultiIdxIterator< Integer>, const MultiIdx< Integer>,
-      ::boost::random_access_traversal_tag, const MultiIdx< Integer> &,
-      MultiIdx< Integer> >
+      ConstMultiIdxIterator< Integer, Dims>, const MultiIdx< Integer, Dims>,
+      ::boost::random_access_traversal_tag, const MultiIdx< Integer, Dims> &,
+      MultiIdx< Integer, Dims> >
   {
-    typedef ::boost::iterator_facade< ConstMultiIdxIterator< Integer>,
-        const MultiIdx< Integer>, ::boost::random_access_traversal_tag,
-        const MultiIdx< Integer> &, MultiIdx< Integer> > base_t;
+    typedef ::boost::iterator_facade< ConstMultiIdxIterator< Integer, Dims>,
+        const MultiIdx< Integer, Dims>, ::boost::random_access_traversal_tag,
+        const MultiIdx< Integer, Dims> &, MultiIdx< Integer, Dims> > base_t;
 
   public:
     typedef typename base_t::value_type value_type;
     typedef typename base_t::difference_type difference_type;
     typedef typename base_t::reference reference;
 
-    ConstMultiIdxIterator(value_type x, const MultiIdxRange< Integer> & range) :
+    ConstMultiIdxIterator(value_type x,
+        const MultiIdxRange< Integer, Dims> & range) :
         myValue(x), myRange(range)
     {
     }
@@ -102,7 +104,7 @@ template< typename Integer>
     }
 
     difference_type
-    distance_to(const ConstMultiIdxIterator< Integer> & other) const
+    distance_to(const ConstMultiIdxIterator< Integer, Dims> & other) const
     {
       return other.myValue - myValue;
     }
@@ -120,23 +122,23 @@ template< typename Integer>
     }
 
     value_type myValue;
-    const MultiIdxRange< Integer> & myRange;
+    const MultiIdxRange< Integer, Dims> & myRange;
 
     friend class ::boost::iterator_core_access;
   };
 
 } // namespace utility_details
 
-template< typename Integer>
+template< typename Integer, size_t Dims>
   class MultiIdxRange : public ::boost::iterator_range<
-      utility_detail::ConstMultiIdxIterator< Integer> >
+      utility_detail::ConstMultiIdxIterator< Integer, Dims> >
   {
-    typedef utility_detail::ConstMultiIdxIterator< Integer> iterator_t;
+    typedef utility_detail::ConstMultiIdxIterator< Integer, Dims> iterator_t;
     typedef ::boost::iterator_range< iterator_t> base_t;
 
   public:
-    MultiIdxRange(const MultiIdx< Integer> & first,
-        const MultiIdx< Integer> & last) :
+    MultiIdxRange(const MultiIdx< Integer, Dims> & first,
+        const MultiIdx< Integer, Dims> & last) :
         base_t(iterator_t(first, *this), iterator_t(last, *this)), myBegin(
             first), myEnd(last)
     {
@@ -151,8 +153,8 @@ template< typename Integer>
 
   private:
 
-    const MultiIdx< Integer> myBegin;
-    const MultiIdx< Integer> myEnd;
+    const MultiIdx< Integer, Dims> myBegin;
+    const MultiIdx< Integer, Dims> myEnd;
 
 #if SSLIB_USE_CPP11
     friend class iterator_t;
@@ -160,7 +162,7 @@ template< typename Integer>
     // Sadly can't use iterator_t typedef here as this behaviour is not supported
     // until C++11.
     // See e.g.: http://stackoverflow.com/questions/392120/why-cant-i-declare-a-friend-through-a-typedef
-    friend class utility_detail::ConstMultiIdxIterator< Integer>;
+    friend class utility_detail::ConstMultiIdxIterator< Integer, Dims>;
 #endif
   };
 
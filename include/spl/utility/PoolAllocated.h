@@ -0,0 +1,90 @@
+/*
+ * PoolAllocated.h
+ *
+ * Base class that gives a type class-level operator new/delete backed by a
+ * pool of fixed size blocks shared by all instances of that type.  This makes
+ * creating and destroying many short-lived objects (e.g. the Structures of
+ * discarded build attempts) cheap as, once warmed up, no calls to the system
+ * allocator are needed.  Freed blocks are kept by the pool for reuse rather
+ * than being returned to the system.
+ *
+ * With SPL_ENABLE_THREAD_AWARE the pool is guarded by a mutex that all
+ * threads share so only use this for types made once per structure, not
+ * per atom.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef SPL__UTILITY__POOL_ALLOCATED_H_
+#define SPL__UTILITY__POOL_ALLOCATED_H_
+
+// INCLUDES /////////////////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <new>
+
+#include <boost/pool/singleton_pool.hpp>
+
+namespace spl {
+namespace utility {
+
+namespace detail {
+#ifdef SPL_ENABLE_THREAD_AWARE
+typedef ::boost::details::pool::default_mutex PoolMutex;
+#else
+typedef ::boost::details::pool::null_mutex PoolMutex;
+#endif
+}
+
+template< typename T>
+  class PoolAllocated
+  {
+    struct PoolTag
+    {
+    };
+    // T is incomplete when the base is instantiated so the pool type is only
+    // named in the member functions
+    template< typename U>
+      struct Pool
+      {
+        typedef ::boost::singleton_pool< PoolTag, sizeof(U),
+            ::boost::default_user_allocator_new_delete, detail::PoolMutex> Type;
+      };
+  public:
+    static void *
+    operator new(const size_t size)
+    {
+      // Derived types that are bigger than T can't use the pool
+      if(size != sizeof(T))
+        return ::operator new(size);
+
+      void * const ptr = Pool< T>::Type::malloc();
+      if(!ptr)
+        throw ::std::bad_alloc();
+      return ptr;
+    }
+    static void
+    operator delete(void * const ptr, const size_t size)
+    {
+      if(!ptr)
+        return;
+      if(size != sizeof(T))
+        ::operator delete(ptr);
+      else
+        Pool< T>::Type::free(ptr);
+    }
+
+  protected:
+    PoolAllocated()
+    {
+    }
+    ~PoolAllocated()
+    {
+    }
+  };
+
+}
+}
+
+#endif /* SPL__UTILITY__POOL_ALLOCATED_H_ */
@@ -0,0 +1,140 @@
+/*
+ * SimilarityIndex.h
+ *
+ * An index over a set of structures that answers "which are the k most
+ * similar to this one?" without comparing against every entry.  Structures
+ * are first partitioned by reduced composition, as structures of different
+ * compositions are never similar, and each partition is a vantage point tree
+ * that uses the triangle inequality on comparator distances to prune.  The
+ * pruning is only valid if the comparator distance is a metric so for
+ * comparators that don't report one (see IStructureComparator::isMetric)
+ * each partition is scanned in full.  Entries at a distance of zero from a
+ * vantage point are kept with it so that duplicates, which are common when
+ * deduplicating, cost no extra comparisons and don't unbalance the tree.
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#ifndef SIMILARITY_INDEX_H
+#define SIMILARITY_INDEX_H
+
+// INCLUDES /////////////////////////////////////////////
+#include "spl/SSLib.h"
+
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/ptr_container/ptr_map.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "spl/common/AtomsFormula.h"
+#include "spl/common/CompactFormula.h"
+#include "spl/utility/IBufferedComparator.h"
+#include "spl/utility/UtilityFwd.h"
+
+namespace spl {
+// FORWARD DECLARATIONS ////////////////////////////////////
+namespace common {
+class Structure;
+}
+
+namespace utility {
+
+class SimilarityIndex : ::boost::noncopyable
+{
+public:
+  typedef size_t Id;
+  // Distance to the query and the id of the matching entry
+  typedef ::std::pair< double, Id> Match;
+  typedef ::std::vector< Match> Matches;
+
+  // Leaves are split once they hold more than this many entries
+  static const size_t MAX_LEAF_SIZE;
+
+  explicit
+  SimilarityIndex(IStructureComparatorPtr comparator);
+  explicit
+  SimilarityIndex(const IStructureComparator & comparator);
+  ~SimilarityIndex();
+
+  // Add a structure, the returned id is used to refer to it from then on
+  Id
+  insert(const common::Structure & structure);
+  // Returns false if there is no entry with that id
+  bool
+  erase(const Id id);
+  void
+  clear();
+
+  size_t
+  size() const;
+  bool
+  empty() const;
+
+  // Get up to k entries with the same composition as the structure that are
+  // within maxDistance of it, sorted by increasing distance
+  Matches
+  findNearest(const common::Structure & structure, const size_t k,
+      const double maxDistance = ::std::numeric_limits< double>::max());
+
+  // The number of comparator calls made by the last findNearest
+  size_t
+  getNumComparisons() const;
+
+private:
+  typedef IBufferedComparator::ComparisonDataHandle ComparisonDataHandle;
+
+  struct Entry
+  {
+    Id id;
+    ComparisonDataHandle data;
+    // Erased entries may stay on as vantage points until the tree is rebuilt
+    bool erased;
+  };
+  struct Node;
+  class Partition;
+  typedef ::boost::ptr_map< common::CompactFormula, Partition> Partitions;
+  // Compositions with too many species to be a CompactFormula
+  typedef ::boost::ptr_map< common::AtomsFormula, Partition> LargePartitions;
+  // The partition each entry is in
+  typedef ::std::map< Id, common::CompactFormula> Ids;
+  typedef ::std::map< Id, common::AtomsFormula> LargeIds;
+
+  static common::AtomsFormula
+  partitionKey(const common::Structure & structure);
+
+  template< typename Key>
+    void
+    insert(::boost::ptr_map< Key, Partition> & partitions,
+        ::std::map< Id, Key> & ids, const Key & key, const Id id,
+        const common::Structure & structure);
+  template< typename Key>
+    bool
+    erase(::boost::ptr_map< Key, Partition> & partitions,
+        ::std::map< Id, Key> & ids, const Id id);
+  template< typename Key>
+    void
+    findNearest(::boost::ptr_map< Key, Partition> & partitions,
+        const Key & key, const common::Structure & structure, const size_t k,
+        const double maxDistance, Matches * const best);
+
+  // WARNING: Order is important, the owned comparator must come first
+  IStructureComparatorPtr myOwnedComparator;
+  const ::boost::shared_ptr< IBufferedComparator> myComparator;
+  const bool myPrune;
+  Partitions myPartitions;
+  LargePartitions myLargePartitions;
+  Ids myIds;
+  LargeIds myLargeIds;
+  Id myNextId;
+  size_t myNumComparisons;
+};
+
+}
+}
+
+#endif /* SIMILARITY_INDEX_H */
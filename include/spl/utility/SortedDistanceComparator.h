@@ -123,10 +123,20 @@ private:
 
   static const size_t MAX_CELL_MULTIPLES;
 
-  void
+  // Stops as soon as the distance can't be below the threshold in which case
+  // the returned lower bound is at least the threshold
+  double
+  compare(const SortedDistanceComparisonData & dist1,
+      const SortedDistanceComparisonData & dist2,
+      const double threshold) const;
+
+  // Stops once the sum of squares in deltaStats reaches maxSqSum, returns the
+  // number of distances visited
+  size_t
   calcProperties(math::RunningStats & deltaStats, const DistancesVec & dist1,
       const StridedIndexAdapter< size_t> & adapt1, const DistancesVec & dist2,
-      const StridedIndexAdapter< size_t> & adapt2) const;
+      const StridedIndexAdapter< size_t> & adapt2,
+      const double maxSqSum) const;
 
   const bool myScaleVolumes;
   const bool myUsePrimitive;
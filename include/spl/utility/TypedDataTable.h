@@ -1,6 +1,10 @@
 /*
  * TypedDataTable.h
  *
+ * Values are stored by column, each column having a contiguous vector of
+ * values indexed by row id, so that sorting by or aggregating over a column
+ * only touches that column's values.
+ *
  *  Created on: Aug 17, 2011
  *      Author: Martin Uhrin
  */
@@ -11,13 +15,15 @@
 
 // INCLUDES /////////////////////////////////////////////
 
+#include <map>
+#include <set>
+#include <string>
 #include <vector>
 
 #include <boost/format.hpp> 
 #include <boost/optional.hpp>
 #include <boost/noncopyable.hpp>
-
-#include "spl/utility/HeterogeneousMap.h"
+#include <boost/ptr_container/ptr_map.hpp>
 
 namespace spl {
 namespace utility {
@@ -29,6 +35,33 @@ class TypedDataTable;
 namespace detail {
 template <typename T, typename TableKey>
 class ColumnComparator;
+
+// The values of one column in one table
+class ColumnData : private ::boost::noncopyable
+{
+public:
+  virtual ~ColumnData() {}
+  virtual void resize(const size_t numRows) = 0;
+  virtual void clear(const size_t rowId) = 0;
+};
+
+template <typename T>
+class TypedColumnData : public ColumnData
+{
+public:
+  struct Cell
+  {
+    Cell(): value(), hasValue(false) {}
+    T value;
+    bool hasValue;
+  };
+  typedef ::std::vector<Cell> Cells;
+
+  virtual void resize(const size_t numRows);
+  virtual void clear(const size_t rowId);
+
+  Cells cells;
+};
 }
 
 template <typename TableKey>
@@ -36,7 +69,7 @@ class Column : private ::boost::noncopyable
 {
 public:
   Column(const ::std::string & name);
-  virtual ~Column() {}
+  virtual ~Column();
 
   const ::std::string & getName() const;
   
@@ -50,7 +83,16 @@ public:
     const TableKey & tableKey) const = 0;
 
 private:
+  typedef ::std::set<TypedDataTable<TableKey> *> Tables;
+
+  void insertedIntoTable(TypedDataTable<TableKey> & table) const;
+  void removedFromTable(TypedDataTable<TableKey> & table) const;
+
   const ::std::string myName;
+  // The tables that hold values for this column
+  mutable Tables myTables;
+
+  friend class TypedDataTable<TableKey>;
 };
 
 template <typename T, typename TableKey>
@@ -69,27 +111,22 @@ public:
     ::boost::format & formatter,
     const TypedDataTable<TableKey> & table,
     const TableKey & tableKey) const;
-
-private:
-
-  typedef Key<T> MapKey;
-
-  MapKey & getKey();
-  const MapKey & getKey() const;
-
-  MapKey myKey;
-
-  friend class TypedDataTable<TableKey>;
 };
 
 template <typename Key>
 class TypedDataTable : private ::boost::noncopyable
 {
-  typedef ::spl::utility::HeterogeneousMap Row;
-  typedef ::std::map<Key, Row> Table;
+public:
+  typedef size_t RowId;
+private:
+  typedef ::std::map<Key, RowId> Rows;
+  typedef ::boost::ptr_map<const Column<Key> *, detail::ColumnData> Columns;
 public:
   typedef ::std::vector<Key> SortedKeys;
-  typedef typename Table::iterator RowIterator;
+  // Iterates over (key, row id) pairs in key order
+  typedef typename Rows::iterator RowIterator;
+
+  ~TypedDataTable();
 
   template <typename T>
   void set(const Key & key, TypedColumn<T, Key> & column, const T & value);
@@ -100,22 +137,53 @@ public:
   template <typename T>
   const T * get(const Key & key, const TypedColumn<T, Key> & column) const;
 
+  template <typename T>
+  T * get(const RowId rowId, const TypedColumn<T, Key> & column);
+
+  template <typename T>
+  const T * get(const RowId rowId, const TypedColumn<T, Key> & column) const;
+
   RowIterator beginRows();
   RowIterator endRows();
   RowIterator findRow(const Key & key);
   void eraseRow(RowIterator pos);
   void eraseRow(const Key & key);
 
+  // Keys of the rows that have a value in the column, sorted by that value,
+  // followed by those that don't
   template <typename T>
   void getAscending(SortedKeys & sortedKeys, const TypedColumn<T, Key> & column) const;
 
   template <typename T>
   void getDescending(SortedKeys & sortedKeys, const TypedColumn<T, Key> & column) const;
 
+  // Copy out all the values in the column, in row id order
+  template <typename T>
+  void getValues(::std::vector<T> & values, const TypedColumn<T, Key> & column) const;
+
   size_t size() const;
 
 private:
-  Table myTable;
+  template <typename T>
+  detail::TypedColumnData<T> * getColumnData(const TypedColumn<T, Key> & column);
+  template <typename T>
+  const detail::TypedColumnData<T> * getColumnData(const TypedColumn<T, Key> & column) const;
+
+  RowId insertRow(const Key & key);
+
+  template <typename T>
+  void getSorted(SortedKeys & sortedKeys, const TypedColumn<T, Key> & column,
+      const bool descending) const;
+
+  void eraseColumnNoNotify(const Column<Key> & column);
+
+  Rows myRows;
+  // The key of each row id, NULL if the row id is free
+  ::std::vector<const Key *> myRowKeys;
+  ::std::vector<RowId> myFreeRowIds;
+  Columns myColumns;
+
+  friend class Column<Key>;
 };
 
 }
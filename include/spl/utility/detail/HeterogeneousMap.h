@@ -10,24 +10,87 @@
 #define HETEROGENEOUS_MAP_DETAIL_H
 
 // INCLUDES /////////////////////////////////////////////
+#include <boost/mpl/contains.hpp>
+#include <boost/mpl/vector.hpp>
 
 // FORWARD DECLARATIONS ////////////////////////////////////
 
 namespace spl {
 namespace utility {
+namespace detail {
+
+typedef ::boost::mpl::vector< double, int, unsigned int, ::std::string,
+    ::arma::mat33> HeterogeneousMapInlineTypes;
+
+template< typename T>
+  struct HeterogeneousMapValueAccess< T, true>
+  {
+    static HeterogeneousMapValue
+    make(const T & value)
+    {
+      return HeterogeneousMapValue(value);
+    }
+    static T *
+    get(HeterogeneousMapValue & value)
+    {
+      return ::boost::get< T>(&value);
+    }
+    static const T *
+    get(const HeterogeneousMapValue & value)
+    {
+      return ::boost::get< T>(&value);
+    }
+  };
+
+template< typename T>
+  struct HeterogeneousMapValueAccess< T, false>
+  {
+    static HeterogeneousMapValue
+    make(const T & value)
+    {
+      return HeterogeneousMapValue(::boost::any(value));
+    }
+    static T *
+    get(HeterogeneousMapValue & value)
+    {
+      ::boost::any * const any = ::boost::get< ::boost::any>(&value);
+      return any ? ::boost::any_cast< T>(any) : NULL;
+    }
+    static const T *
+    get(const HeterogeneousMapValue & value)
+    {
+      const ::boost::any * const any = ::boost::get< ::boost::any>(&value);
+      return any ? ::boost::any_cast< T>(any) : NULL;
+    }
+  };
+
+template< typename T>
+  struct HeterogeneousMapAccess : HeterogeneousMapValueAccess< T,
+      ::boost::mpl::contains< HeterogeneousMapInlineTypes, T>::value>
+  {
+  };
+
+}
+
+template< typename T>
+  HeterogeneousMap::Value
+  HeterogeneousMap::makeValue(const T & value)
+  {
+    return detail::HeterogeneousMapAccess< T>::make(value);
+  }
 
 template< typename T>
   bool
   HeterogeneousMap::insert(Key< T> & key, T value)
   {
-    return insert(AnyMap::value_type(key.getId(), value)).second;
+    return insert(key.getId(), makeValue(value), false).second;
   }
 
 template< typename T>
   bool
   HeterogeneousMap::insert(value_type< T> & x)
   {
-    return insert(AnyMap::value_type(x.first.getId(), x.second)).second;
+    return insert(x.first.getId(), makeValue(x.second), false).second;
   }
 
 template< typename T>
@@ -39,9 +102,9 @@ template< typename T>
     if(!value)
     {
       // Insert default value
-      ::std::pair< AnyMap::iterator, bool> result = insert(
-          AnyMap::value_type(key.getId(), T()));
-      value = ::boost::any_cast< T>(&result.first->second);
+      const ::std::pair< Entries::iterator, bool> result = insert(key.getId(),
+          makeValue(T()), false);
+      value = detail::HeterogeneousMapAccess< T>::get(result.first->value);
     }
 
     return *value;
@@ -51,46 +114,23 @@ template< typename T>
   T *
   HeterogeneousMap::find(const Key< T> & key)
   {
-    // NOTE: Have to use const_cast<> here as we have a type of const KeyId * but the
-    // map key is actually of type KeyId *.  In this case the cast is safe to do as we
-    // guarantee that we will not modify the key.
-    const AnyMap::iterator it = myAnyMap.find(
-        const_cast< KeyId *>(key.getId()));
-
-    if(it == myAnyMap.end())
-      return NULL;
-
-    return ::boost::any_cast< T>(&it->second);
+    Value * const value = findValue(key.getId());
+    return value ? detail::HeterogeneousMapAccess< T>::get(*value) : NULL;
   }
 
 template< typename T>
   const T *
   HeterogeneousMap::find(const Key< T> & key) const
   {
-    // NOTE: Have to use const_cast<> here as we have a type of const KeyId * but the
-    // map key is actually of type KeyId *.  In this case the cast is safe to do as we
-    // guarantee that we will not modify the key.
-    const AnyMap::const_iterator it = myAnyMap.find(
-        const_cast< KeyId *>(key.getId()));
-
-    if(it == myAnyMap.end())
-      return NULL;
-
-    return ::boost::any_cast< T>(&it->second);
+    const Value * const value = findValue(key.getId());
+    return value ? detail::HeterogeneousMapAccess< T>::get(*value) : NULL;
   }
 
 template< typename T>
   size_t
   HeterogeneousMap::erase(Key< T> & key)
   {
-    const AnyMap::iterator it = myAnyMap.find(key.getId());
-
-    if(it == myAnyMap.end())
-      return 0;
-
-    myAnyMap.erase(it);
-    key.getId()->removedFromMap(*this);
-    return 1;
+    return erase(*key.getId());
   }
 
 }
@@ -10,25 +10,63 @@
 #define TYPED_DATA_TABLE_DETAIL_H
 
 // INCLUDES /////////////////////////////////////////////
+#include <algorithm>
 #include <functional>
 #include <sstream>
 
-#include <boost/iterator/indirect_iterator.hpp>
+#include <boost/foreach.hpp>
 
 namespace spl {
 namespace utility {
 
+namespace detail {
+
+template <typename T>
+void TypedColumnData<T>::resize(const size_t numRows)
+{
+  cells.resize(numRows);
+}
+
+template <typename T>
+void TypedColumnData<T>::clear(const size_t rowId)
+{
+  if(rowId < cells.size())
+    cells[rowId] = Cell();
+}
+
+}
+
 template <typename TableKey>
 Column<TableKey>::Column(const ::std::string & name):
 myName(name)
 {}
 
+template <typename TableKey>
+Column<TableKey>::~Column()
+{
+  // Remove our values from all the tables
+  BOOST_FOREACH(TypedDataTable<TableKey> * const table, myTables)
+    table->eraseColumnNoNotify(*this);
+}
+
 template <typename TableKey>
 const ::std::string & Column<TableKey>::getName() const
 {
   return myName;
 }
 
+template <typename TableKey>
+void Column<TableKey>::insertedIntoTable(TypedDataTable<TableKey> & table) const
+{
+  myTables.insert(&table);
+}
+
+template <typename TableKey>
+void Column<TableKey>::removedFromTable(TypedDataTable<TableKey> & table) const
+{
+  myTables.erase(&table);
+}
+
 template <typename T, typename TableKey>
 TypedColumn<T, TableKey>::TypedColumn(const ::std::string & name):
 Column<TableKey>(name)
@@ -66,184 +104,296 @@ bool TypedColumn<T, TableKey>::feedFormatter(
   return true;
 }
 
-template <typename T, typename TableKey>
-typename TypedColumn<T, TableKey>::MapKey &
-TypedColumn<T, TableKey>::getKey()
-{
-  return myKey;
-}
-
-template <typename T, typename TableKey>
-const typename TypedColumn<T, TableKey>::MapKey &
-TypedColumn<T, TableKey>::getKey() const
+template <typename Key>
+TypedDataTable<Key>::~TypedDataTable()
 {
-  return myKey;
+  for(typename Columns::iterator it = myColumns.begin(); it != myColumns.end();
+      ++it)
+    it->first->removedFromTable(*this);
 }
 
 template <typename Key>
 template <typename T>
 void TypedDataTable<Key>::set(const Key & key, TypedColumn<T, Key> & column, const T & value)
 {
-  myTable[key][column.getKey()] = value;
+  const RowId rowId = insertRow(key);
+
+  detail::TypedColumnData<T> * data = getColumnData(column);
+  if(!data)
+  {
+    const Column<Key> * const columnPtr = &column;
+    data = new detail::TypedColumnData<T>();
+    myColumns.insert(columnPtr, data);
+    column.insertedIntoTable(*this);
+  }
+  if(data->cells.size() < myRowKeys.size())
+    data->resize(myRowKeys.size());
+
+  typename detail::TypedColumnData<T>::Cell & cell = data->cells[rowId];
+  cell.value = value;
+  cell.hasValue = true;
 }
 
 template <typename Key>
 template <typename T>
 T * TypedDataTable<Key>::get(const Key & key, const TypedColumn<T, Key> & column)
 {
-  const typename Table::iterator rowIt = myTable.find(key);
+  const typename Rows::const_iterator rowIt = myRows.find(key);
 
-  if(rowIt == myTable.end())
+  if(rowIt == myRows.end())
     return NULL;
 
-  return rowIt->second.find(column.getKey());
+  return get(rowIt->second, column);
 }
 
 template <typename Key>
 template <typename T>
 const T * TypedDataTable<Key>::get(const Key & key, const TypedColumn<T, Key> & column) const
 {
-  const typename Table::const_iterator rowIt = myTable.find(key);
+  const typename Rows::const_iterator rowIt = myRows.find(key);
 
-  if(rowIt == myTable.end())
+  if(rowIt == myRows.end())
     return NULL;
 
-  return rowIt->second.find(column.getKey());
+  return get(rowIt->second, column);
+}
+
+template <typename Key>
+template <typename T>
+T * TypedDataTable<Key>::get(const RowId rowId, const TypedColumn<T, Key> & column)
+{
+  detail::TypedColumnData<T> * const data = getColumnData(column);
+
+  if(!data || rowId >= data->cells.size() || !data->cells[rowId].hasValue)
+    return NULL;
+
+  return &data->cells[rowId].value;
+}
+
+template <typename Key>
+template <typename T>
+const T * TypedDataTable<Key>::get(const RowId rowId, const TypedColumn<T, Key> & column) const
+{
+  const detail::TypedColumnData<T> * const data = getColumnData(column);
+
+  if(!data || rowId >= data->cells.size() || !data->cells[rowId].hasValue)
+    return NULL;
+
+  return &data->cells[rowId].value;
 }
 
 template <typename Key>
 typename TypedDataTable<Key>::RowIterator
 TypedDataTable<Key>::beginRows()
 {
-  return myTable.begin();
+  return myRows.begin();
 }
 
 template <typename Key>
 typename TypedDataTable<Key>::RowIterator
 TypedDataTable<Key>::endRows()
 {
-  return myTable.end();
+  return myRows.end();
 }
 
 template <typename Key>
 typename TypedDataTable<Key>::RowIterator
 TypedDataTable<Key>::findRow(const Key & key)
 {
-  return myTable.find(key);
+  return myRows.find(key);
 }
 
 template <typename Key>
 void TypedDataTable<Key>::eraseRow(RowIterator pos)
 {
-  return myTable.erase(pos);
+  const RowId rowId = pos->second;
+  for(typename Columns::iterator it = myColumns.begin(); it != myColumns.end();
+      ++it)
+    it->second->clear(rowId);
+
+  myRowKeys[rowId] = NULL;
+  myFreeRowIds.push_back(rowId);
+  myRows.erase(pos);
 }
 
 template <typename Key>
 void TypedDataTable<Key>::eraseRow(const Key & key)
 {
-  myTable.erase(myTable.find(key));
+  const RowIterator it = myRows.find(key);
+  if(it != myRows.end())
+    eraseRow(it);
 }
 
-
 template <typename Key>
 template <typename T>
 void TypedDataTable<Key>::getAscending(SortedKeys & sortedKeys, const TypedColumn<T, Key> & column) const
 {
-  typedef detail::ColumnComparator<T, Key> Comparator;
+  getSorted(sortedKeys, column, false);
+}
 
-  // Empty the container and copy all the current keys
-  sortedKeys.clear();
-  sortedKeys.reserve(myTable.size());
-  typename SortedKeys::iterator insertPoint = sortedKeys.end();
-  BOOST_FOREACH(const typename Table::value_type & entry, myTable)
+template <typename Key>
+template <typename T>
+void TypedDataTable<Key>::getDescending(SortedKeys & sortedKeys, const TypedColumn<T, Key> & column) const
+{
+  getSorted(sortedKeys, column, true);
+}
+
+template <typename Key>
+template <typename T>
+void TypedDataTable<Key>::getValues(::std::vector<T> & values, const TypedColumn<T, Key> & column) const
+{
+  typedef typename detail::TypedColumnData<T>::Cell Cell;
+
+  values.clear();
+  const detail::TypedColumnData<T> * const data = getColumnData(column);
+  if(!data)
+    return;
+
+  values.reserve(myRows.size());
+  BOOST_FOREACH(const Cell & cell, data->cells)
   {
-    if(get(entry.first, column))
-      insertPoint = sortedKeys.insert(insertPoint, entry.first) + 1;
-    else
-      insertPoint = sortedKeys.insert(insertPoint, entry.first);
+    if(cell.hasValue)
+      values.push_back(cell.value);
   }
+}
 
-  // Sort using the custom comparator
-  ::std::sort(sortedKeys.begin(), insertPoint, Comparator(*this, column));
+template <typename Key>
+size_t TypedDataTable<Key>::size() const
+{
+  return myRows.size();
 }
 
 template <typename Key>
 template <typename T>
-void TypedDataTable<Key>::getDescending(SortedKeys & sortedKeys, const TypedColumn<T, Key> & column) const
+detail::TypedColumnData<T> *
+TypedDataTable<Key>::getColumnData(const TypedColumn<T, Key> & column)
+{
+  const typename Columns::iterator it = myColumns.find(&column);
+  if(it == myColumns.end())
+    return NULL;
+  return static_cast<detail::TypedColumnData<T> *>(it->second);
+}
+
+template <typename Key>
+template <typename T>
+const detail::TypedColumnData<T> *
+TypedDataTable<Key>::getColumnData(const TypedColumn<T, Key> & column) const
+{
+  const typename Columns::const_iterator it = myColumns.find(&column);
+  if(it == myColumns.end())
+    return NULL;
+  return static_cast<const detail::TypedColumnData<T> *>(it->second);
+}
+
+template <typename Key>
+typename TypedDataTable<Key>::RowId
+TypedDataTable<Key>::insertRow(const Key & key)
+{
+  const typename Rows::iterator rowIt = myRows.find(key);
+  if(rowIt != myRows.end())
+    return rowIt->second;
+
+  RowId rowId;
+  if(myFreeRowIds.empty())
+  {
+    rowId = myRowKeys.size();
+    myRowKeys.push_back(NULL);
+  }
+  else
+  {
+    rowId = myFreeRowIds.back();
+    myFreeRowIds.pop_back();
+  }
+  myRowKeys[rowId] = &myRows.insert(::std::make_pair(key, rowId)).first->first;
+  return rowId;
+}
+
+template <typename Key>
+template <typename T>
+void TypedDataTable<Key>::getSorted(SortedKeys & sortedKeys, const TypedColumn<T, Key> & column,
+    const bool descending) const
 {
   typedef detail::ColumnComparator<T, Key> Comparator;
+  typedef typename detail::TypedColumnData<T>::Cells Cells;
 
-  // Empty the container and copy all the current keys
   sortedKeys.clear();
-  sortedKeys.reserve(myTable.size());
-  typename SortedKeys::iterator insertPoint = sortedKeys.end();
-  BOOST_FOREACH(const typename Table::value_type & entry, myTable)
+  sortedKeys.reserve(myRows.size());
+
+  // Sort the ids of the rows that have values using just the column's cells
+  const detail::TypedColumnData<T> * const data = getColumnData(column);
+  ::std::vector<RowId> rowIds;
+  if(data)
   {
-    if(get(entry.first, column))
-      insertPoint = sortedKeys.insert(insertPoint, entry.first) + 1;
-    else
-      insertPoint = sortedKeys.insert(insertPoint, entry.first);
+    const Cells & cells = data->cells;
+    rowIds.reserve(myRows.size());
+    for(RowId i = 0; i < cells.size(); ++i)
+    {
+      if(cells[i].hasValue)
+        rowIds.push_back(i);
+    }
+    ::std::sort(rowIds.begin(), rowIds.end(), Comparator(cells, descending));
   }
 
-  // Sort using the custom comparator
-  ::std::sort(sortedKeys.begin(), insertPoint, Comparator(*this, column, true));
+  BOOST_FOREACH(const RowId rowId, rowIds)
+    sortedKeys.push_back(*myRowKeys[rowId]);
+  // Now the rows without a value
+  BOOST_FOREACH(typename Rows::const_reference row, myRows)
+  {
+    if(!data || row.second >= data->cells.size()
+        || !data->cells[row.second].hasValue)
+      sortedKeys.push_back(row.first);
+  }
 }
 
 template <typename Key>
-size_t TypedDataTable<Key>::size() const
+void TypedDataTable<Key>::eraseColumnNoNotify(const Column<Key> & column)
 {
-  return myTable.size();
+  const typename Columns::iterator it = myColumns.find(&column);
+  if(it != myColumns.end())
+    myColumns.erase(it);
 }
 
 namespace detail {
 
 template <typename T, typename TableKey>
-class ColumnComparator : public ::std::binary_function<const TableKey &, const TableKey &, bool>
+class ColumnComparator : public ::std::binary_function<size_t, size_t, bool>
 {
 public:
-  ColumnComparator(const TypedDataTable<TableKey> & table, const TypedColumn<T, TableKey> & column);
-  ColumnComparator(const TypedDataTable<TableKey> & table, const TypedColumn<T, TableKey> & column, const bool reverseComparison);
+  typedef typename TypedColumnData<T>::Cells Cells;
 
-  bool operator()(const TableKey & key1, const TableKey & key2);
+  ColumnComparator(const Cells & cells);
+  ColumnComparator(const Cells & cells, const bool reverseComparison);
+
+  bool operator()(const size_t row1, const size_t row2) const;
 private:
-  const TypedDataTable<TableKey> & myTable;
-  const TypedColumn<T, TableKey> & myColumn;
+  const Cells & myCells;
   const bool myReverseComparison;
 };
 
 template <typename T, typename TableKey>
-ColumnComparator<T, TableKey>::ColumnComparator(
-  const TypedDataTable<TableKey> & table,
-  const TypedColumn<T, TableKey> & column):
-myTable(table),
-myColumn(column),
+ColumnComparator<T, TableKey>::ColumnComparator(const Cells & cells):
+myCells(cells),
 myReverseComparison(false)
 {}
 
 template <typename T, typename TableKey>
 ColumnComparator<T, TableKey>::ColumnComparator(
-  const TypedDataTable<TableKey> & table,
-  const TypedColumn<T, TableKey> & column,
+  const Cells & cells,
   const bool reverseComparison):
-myTable(table),
-myColumn(column),
+myCells(cells),
 myReverseComparison(reverseComparison)
 {}
 
 template <typename T, typename TableKey>
-bool ColumnComparator<T, TableKey>::operator()(const TableKey & key1, const TableKey & key2)
+bool ColumnComparator<T, TableKey>::operator()(const size_t row1, const size_t row2) const
 {
-  const T * const v1 = myTable.get(key1, myColumn);
-  const T * const v2 = myTable.get(key2, myColumn);
-
-  if(!v1 || !v2)
-    return false; // Can't compare as we don't have one or more values
+  const T & v1 = myCells[row1].value;
+  const T & v2 = myCells[row2].value;
 
   // NOTE: Need to use < and > operators as we need a comparator that produces strict weak ordering
-  return myReverseComparison ? *v1 > *v2 : *v1 < *v2;
+  return myReverseComparison ? v1 > v2 : v1 < v2;
 }
 
-
 }
 
 }
@@ -10,11 +10,14 @@
 #ifdef SPL_USE_CGAL
 
 #include <list>
+#include <map>
 
 #include <boost/foreach.hpp>
+#include <boost/unordered_map.hpp>
 
 #include <CGAL/Delaunay_d.h>
 
+#include "spl/common/CompactFormula.h"
 #include "spl/common/StructureProperties.h"
 
 //#define DEBUG_CONVEX_HULL_GENERATOR
@@ -22,6 +25,24 @@
 namespace spl {
 namespace analysis {
 
+namespace {
+
+// Keep the entry if it is the lowest at its composition so far
+template< typename LowestMap>
+  void
+  keepLowest(LowestMap & lowest, const typename LowestMap::key_type & composition,
+      ConvexHull::HullEntry * const entry, const int convexDim)
+  {
+    const typename LowestMap::iterator it = lowest.find(composition);
+    if(it == lowest.end())
+      lowest[composition] = entry;
+    else if((*entry->getPoint())[convexDim]
+        < (*it->second->getPoint())[convexDim])
+      it->second = entry;
+  }
+
+}
+
 const ConvexHull::HullTraits::FT ConvexHull::FT_ZERO(0);
 const ConvexHull::HullTraits::RT ConvexHull::RT_ZERO(0);
 
@@ -397,7 +418,10 @@ ConvexHull::generateHull() const
 {
   SSLIB_ASSERT(canGenerate());
 
-  typedef ::std::map< common::AtomsFormula, HullEntry *> LowestEnergy;
+  typedef ::boost::unordered_map< common::CompactFormula, HullEntry *>
+      LowestEnergy;
+  // For the (rare) compositions with too many species for a CompactFormula
+  typedef ::std::map< common::AtomsFormula, HullEntry *> LowestEnergyLarge;
   // Need to allow multiple structures with the same formation enthalpy so long
   // as they have different compositions
   typedef ::std::multimap< HullTraits::FT, HullEntry *> SortedEntries;
@@ -405,7 +429,7 @@ ConvexHull::generateHull() const
   // To make calculating the hull faster and remove redundant points
   // first get the set of points with the lowest energy at composition coordinate
   LowestEnergy lowest;
-  LowestEnergy::iterator it;
+  LowestEnergyLarge lowestLarge;
   BOOST_FOREACH(HullEntries::reference entry, myEntries)
   {
     const PointD & p = generateHullPoint(entry);
@@ -413,16 +437,17 @@ ConvexHull::generateHull() const
 
     if(p[dims() - 1] <= FT_ZERO)
     {
-      common::AtomsFormula composition = entry.getComposition();
-      composition.reduce();
-      it = lowest.find(composition);
-      if(it == lowest.end())
-        lowest[composition] = &entry;
+      if(common::CompactFormula::fits(entry.getComposition()))
+      {
+        common::CompactFormula composition(entry.getComposition());
+        composition.reduce();
+        keepLowest(lowest, composition, &entry, dims() - 1);
+      }
       else
       {
-        // If this point is lower in energy then replace the old one
-        if(p[dims() - 1] < (*it->second->getPoint())[dims() - 1])
-          it->second = &entry;
+        common::AtomsFormula composition(entry.getComposition());
+        composition.reduce();
+        keepLowest(lowestLarge, composition, &entry, dims() - 1);
       }
     }
   }
@@ -435,6 +460,12 @@ ConvexHull::generateHull() const
         ::std::make_pair((*entry.second->getPoint())[dims() - 1],
             entry.second));
   }
+  BOOST_FOREACH(LowestEnergyLarge::reference entry, lowestLarge)
+  {
+    sortedEntries.insert(
+        ::std::make_pair((*entry.second->getPoint())[dims() - 1],
+            entry.second));
+  }
 
   myHull.reset(new Hull(myHullDims));
   // Put in the endpoints first
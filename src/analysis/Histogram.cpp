@@ -9,6 +9,8 @@
 
 #include <cmath>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 
 #include <boost/foreach.hpp>
 
@@ -28,11 +30,43 @@ void Histogram::insert(const double value)
   ++myBins[idx];
 }
 
+void Histogram::insert(const double * const values, const size_t n)
+{
+  if(n == 0)
+    return;
+
+  double maxValue = values[0];
+  for(size_t i = 1; i < n; ++i)
+    maxValue = values[i] > maxValue ? values[i] : maxValue;
+  ensureEnoughBins(binIndex(maxValue));
+
+  for(size_t i = 0; i < n; ++i)
+    ++myBins[binIndex(values[i])];
+}
+
+void Histogram::merge(const Histogram & other)
+{
+  if(::std::abs(myBinWidth - other.myBinWidth)
+      > ::std::numeric_limits<double>::epsilon() * ::std::abs(myBinWidth))
+    throw ::std::invalid_argument("Can't merge histograms with different bin widths");
+
+  if(other.myBins.empty())
+    return;
+  ensureEnoughBins(other.myBins.size() - 1);
+  for(size_t i = 0; i < other.myBins.size(); ++i)
+    myBins[i] += other.myBins[i];
+}
+
 void Histogram::clear()
 {
   myBins.clear();
 }
 
+double Histogram::getBinWidth() const
+{
+  return myBinWidth;
+}
+
 size_t Histogram::numBins() const
 {
   return myBins.size();
@@ -102,7 +136,7 @@ void Histogram::ensureEnoughBins(const unsigned int binIndex)
     myBins.resize(binIndex + 1);
 }
 
-size_t Histogram::binIndex(const double value)
+size_t Histogram::binIndex(const double value) const
 {
   return static_cast<size_t>(::std::floor(value / myBinWidth));
 }
@@ -0,0 +1,462 @@
+/*
+ * RadialDistribution.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "spl/analysis/RadialDistribution.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <boost/thread/thread.hpp>
+#endif
+
+#include "spl/common/Constants.h"
+#include "spl/common/Structure.h"
+#include "spl/common/UnitCell.h"
+#include "spl/math/KdTree.h"
+
+// NAMESPACES ////////////////////////////////
+
+namespace spl {
+namespace analysis {
+
+namespace {
+
+typedef RadialDistribution::SpeciesList SpeciesList;
+
+size_t
+speciesIndex(const SpeciesList & species,
+    const common::AtomSpeciesId::Value & value)
+{
+  return ::std::lower_bound(species.begin(), species.end(), value)
+      - species.begin();
+}
+
+// Histograms and scratch space belonging to one thread
+struct Worker : ::boost::noncopyable
+{
+  Worker(const size_t numSpecies, const double binWidth) :
+      distances(numSpecies)
+  {
+    // One histogram for each ordered pair of species
+    for(size_t i = 0; i < numSpecies * numSpecies; ++i)
+      histograms.push_back(new Histogram(binWidth));
+  }
+
+  ::boost::ptr_vector< Histogram> histograms;
+  ::std::vector< size_t> neighbours;
+  // Distances to neighbours of each species from the current atom
+  ::std::vector< ::std::vector< double> > distances;
+};
+
+// The atoms of a structure along with those periodic images that are within
+// the cutoff of the unit cell.  The atoms themselves come first so an atom
+// index is also its point index.
+class PairSearch : ::boost::noncopyable
+{
+public:
+  PairSearch(const common::Structure & structure, const SpeciesList & species,
+      const double cutoff);
+
+  size_t
+  numAtoms() const
+  {
+    return myNumAtoms;
+  }
+
+  // Bin the distances from the atom to all points within the cutoff
+  void
+  accumulate(const size_t atomIdx, Worker * const worker) const;
+
+private:
+  void
+  addImages(const common::Structure & structure, const common::UnitCell & cell,
+      const SpeciesList & species);
+
+  const double myCutoff;
+  const size_t myNumSpecies;
+  size_t myNumAtoms;
+  ::arma::mat myPoints;
+  ::std::vector< size_t> mySpecies;
+  math::KdTree myTree;
+};
+
+PairSearch::PairSearch(const common::Structure & structure,
+    const SpeciesList & species, const double cutoff) :
+    myCutoff(cutoff), myNumSpecies(species.size()), myNumAtoms(
+        structure.getNumAtoms())
+{
+  if(myNumAtoms == 0)
+    return;
+
+  const common::UnitCell * const cell = structure.getUnitCell();
+  if(cell)
+    addImages(structure, *cell, species);
+  else
+  {
+    structure.getAtomPositions(myPoints);
+    for(size_t i = 0; i < myNumAtoms; ++i)
+      mySpecies.push_back(
+          speciesIndex(species, structure.getAtom(i).getSpecies()));
+  }
+  myTree.build(myPoints);
+}
+
+void
+PairSearch::addImages(const common::Structure & structure,
+    const common::UnitCell & cell, const SpeciesList & species)
+{
+  const ::arma::mat33 & orthoMtx = cell.getOrthoMtx();
+
+  // The cutoff expressed as a fraction of the spacing between lattice planes
+  // in each direction and the number of image shells needed to cover it
+  double fracSkin[3];
+  int maxShell[3];
+  for(size_t i = 0; i < 3; ++i)
+  {
+    const ::arma::vec3 planeNormal = ::arma::cross(orthoMtx.col((i + 1) % 3),
+        orthoMtx.col((i + 2) % 3));
+    fracSkin[i] = myCutoff * ::arma::norm(planeNormal, 2) / cell.getVolume();
+    maxShell[i] = static_cast< int>(::std::ceil(fracSkin[i]));
+  }
+
+  ::arma::mat fracs;
+  structure.getAtomPositions(fracs);
+  cell.cartsToFracInplace(fracs);
+  fracs -= ::arma::floor(fracs);
+
+  ::std::vector< size_t> atomSpecies(myNumAtoms);
+  for(size_t i = 0; i < myNumAtoms; ++i)
+    atomSpecies[i] = speciesIndex(species, structure.getAtom(i).getSpecies());
+
+  // Gather the images in fractional coordinates, the untranslated atoms first
+  ::std::vector< double> imageFracs(fracs.memptr(),
+      fracs.memptr() + 3 * myNumAtoms);
+  mySpecies = atomSpecies;
+  int n[3];
+  for(n[0] = -maxShell[0]; n[0] <= maxShell[0]; ++n[0])
+  {
+    for(n[1] = -maxShell[1]; n[1] <= maxShell[1]; ++n[1])
+    {
+      for(n[2] = -maxShell[2]; n[2] <= maxShell[2]; ++n[2])
+      {
+        if(n[0] == 0 && n[1] == 0 && n[2] == 0)
+          continue;
+
+        for(size_t atomIdx = 0; atomIdx < myNumAtoms; ++atomIdx)
+        {
+          // Is this image within the cutoff of the cell?
+          bool inSkin = true;
+          for(size_t d = 0; inSkin && d < 3; ++d)
+          {
+            const double f = fracs(d, atomIdx) + n[d];
+            inSkin = f >= -fracSkin[d] && f <= 1.0 + fracSkin[d];
+          }
+          if(!inSkin)
+            continue;
+
+          for(size_t d = 0; d < 3; ++d)
+            imageFracs.push_back(fracs(d, atomIdx) + n[d]);
+          mySpecies.push_back(atomSpecies[atomIdx]);
+        }
+      }
+    }
+  }
+
+  myPoints = ::arma::mat(&imageFracs[0], 3, mySpecies.size());
+  cell.fracsToCartInplace(myPoints);
+}
+
+void
+PairSearch::accumulate(const size_t atomIdx, Worker * const worker) const
+{
+  const ::arma::vec3 pos = myPoints.col(atomIdx);
+
+  worker->neighbours.clear();
+  myTree.radiusQuery(pos, myCutoff, &worker->neighbours);
+
+  for(size_t i = 0; i < worker->neighbours.size(); ++i)
+  {
+    const size_t pointIdx = worker->neighbours[i];
+    if(pointIdx == atomIdx)
+      continue;
+
+    const double * const point = myPoints.colptr(pointIdx);
+    const double dx = point[0] - pos(0), dy = point[1] - pos(1), dz =
+        point[2] - pos(2);
+    worker->distances[mySpecies[pointIdx]].push_back(
+        ::std::sqrt(dx * dx + dy * dy + dz * dz));
+  }
+
+  const size_t first = mySpecies[atomIdx] * myNumSpecies;
+  for(size_t s = 0; s < myNumSpecies; ++s)
+  {
+    ::std::vector< double> & distances = worker->distances[s];
+    if(!distances.empty())
+    {
+      worker->histograms[first + s].insert(&distances[0], distances.size());
+      distances.clear();
+    }
+  }
+}
+
+typedef ::boost::function< void
+(Worker &, const size_t)> WorkFunction;
+
+void
+doWork(Worker * const worker, const size_t first, const size_t stride,
+    const size_t numItems, const WorkFunction & work)
+{
+  for(size_t i = first; i < numItems; i += stride)
+    work(*worker, i);
+}
+
+void
+runWorkers(::boost::ptr_vector< Worker> & workers, const size_t numItems,
+    const WorkFunction & work)
+{
+#ifdef SPL_ENABLE_THREAD_AWARE
+  if(workers.size() > 1)
+  {
+    ::boost::thread_group threads;
+    for(size_t i = 0; i < workers.size(); ++i)
+      threads.create_thread(
+          ::boost::bind(&doWork, &workers[i], i, workers.size(), numItems,
+              ::boost::cref(work)));
+    threads.join_all();
+    return;
+  }
+#endif
+  doWork(&workers[0], 0, 1, numItems, work);
+}
+
+void
+accumulateAtom(const PairSearch & search, Worker & worker,
+    const size_t atomIdx)
+{
+  search.accumulate(atomIdx, &worker);
+}
+
+void
+accumulateStructure(
+    const ::std::vector< const common::Structure *> & structures,
+    const SpeciesList & species, const double cutoff, Worker & worker,
+    const size_t structureIdx)
+{
+  const PairSearch search(*structures[structureIdx], species, cutoff);
+  for(size_t i = 0; i < search.numAtoms(); ++i)
+    search.accumulate(i, &worker);
+}
+
+}
+
+RadialDistribution::Settings::Settings() :
+    cutoff(10.0), binWidth(0.05), numThreads(0)
+{
+}
+
+RadialDistribution::PairData::PairData(const double binWidth) :
+    counts(binWidth), norm(0.0)
+{
+}
+
+RadialDistribution::RadialDistribution(const Settings & settings) :
+    mySettings(settings), myNumStructures(0)
+{
+  SSLIB_ASSERT(mySettings.cutoff > 0.0);
+  SSLIB_ASSERT(mySettings.binWidth > 0.0);
+}
+
+void
+RadialDistribution::add(const common::Structure & structure)
+{
+  add(::std::vector< const common::Structure *>(1, &structure));
+}
+
+void
+RadialDistribution::add(
+    const ::std::vector< const common::Structure *> & structures)
+{
+  if(structures.empty())
+    return;
+
+  // Index the species in this batch and work out how many pairs of each an
+  // ideal gas would have per unit volume
+  SpeciesList species;
+  for(size_t i = 0; i < structures.size(); ++i)
+    structures[i]->getAtomSpecies(::std::back_inserter(species));
+  ::std::sort(species.begin(), species.end());
+  species.erase(::std::unique(species.begin(), species.end()), species.end());
+  const size_t numSpecies = species.size();
+
+  ::std::vector< double> norms(numSpecies * numSpecies, 0.0);
+  for(size_t i = 0; i < structures.size(); ++i)
+  {
+    const common::UnitCell * const cell = structures[i]->getUnitCell();
+    const double volume = cell ? cell->getVolume() : 1.0;
+    for(size_t a = 0; a < numSpecies; ++a)
+    {
+      const double numA = structures[i]->getNumAtomsOfSpecies(species[a]);
+      for(size_t b = 0; b < numSpecies; ++b)
+        norms[a * numSpecies + b] += numA
+            * structures[i]->getNumAtomsOfSpecies(species[b]) / volume;
+    }
+  }
+
+  unsigned int numThreads = 1;
+#ifdef SPL_ENABLE_THREAD_AWARE
+  numThreads = mySettings.numThreads;
+  if(numThreads == 0)
+    numThreads = ::std::max(1u, ::boost::thread::hardware_concurrency());
+#endif
+
+  ::boost::ptr_vector< Worker> workers;
+  if(structures.size() == 1)
+  {
+    // Split a single structure up by atom
+    const PairSearch search(*structures[0], species, mySettings.cutoff);
+    for(size_t i = 0; i < ::std::min< size_t>(numThreads, search.numAtoms());
+        ++i)
+      workers.push_back(new Worker(numSpecies, mySettings.binWidth));
+    if(!workers.empty())
+      runWorkers(workers, search.numAtoms(),
+          ::boost::bind(&accumulateAtom, ::boost::cref(search), _1, _2));
+  }
+  else
+  {
+    for(size_t i = 0; i < ::std::min< size_t>(numThreads, structures.size());
+        ++i)
+      workers.push_back(new Worker(numSpecies, mySettings.binWidth));
+    runWorkers(workers, structures.size(),
+        ::boost::bind(&accumulateStructure, ::boost::cref(structures),
+            ::boost::cref(species), mySettings.cutoff, _1, _2));
+  }
+
+  // Reduce the per thread histograms, both orderings of a pair go together
+  addSpecies(species);
+  for(size_t a = 0; a < numSpecies; ++a)
+  {
+    for(size_t b = 0; b < numSpecies; ++b)
+    {
+      const SpeciesPair key(::std::min(species[a], species[b]),
+          ::std::max(species[a], species[b]));
+      Pairs::iterator it = myPairs.find(key);
+      if(it == myPairs.end())
+      {
+        SpeciesPair insertKey(key);
+        it = myPairs.insert(insertKey, new PairData(mySettings.binWidth)).first;
+      }
+      it->second->norm += norms[a * numSpecies + b];
+      for(size_t w = 0; w < workers.size(); ++w)
+        it->second->counts.merge(workers[w].histograms[a * numSpecies + b]);
+    }
+  }
+  myNumStructures += structures.size();
+}
+
+void
+RadialDistribution::clear()
+{
+  mySpecies.clear();
+  myPairs.clear();
+  myNumStructures = 0;
+}
+
+size_t
+RadialDistribution::numBins() const
+{
+  return static_cast< size_t>(::std::ceil(
+      mySettings.cutoff / mySettings.binWidth));
+}
+
+size_t
+RadialDistribution::numStructures() const
+{
+  return myNumStructures;
+}
+
+RadialDistribution::Distribution
+RadialDistribution::getRadii() const
+{
+  Distribution radii(numBins());
+  for(size_t i = 0; i < radii.size(); ++i)
+    radii[i] = (static_cast< double>(i) + 0.5) * mySettings.binWidth;
+  return radii;
+}
+
+RadialDistribution::Distribution
+RadialDistribution::getTotal() const
+{
+  Histogram counts(mySettings.binWidth);
+  double norm = 0.0;
+  for(Pairs::const_iterator it = myPairs.begin(); it != myPairs.end(); ++it)
+  {
+    counts.merge(it->second->counts);
+    norm += it->second->norm;
+  }
+  return normalise(counts, norm);
+}
+
+const RadialDistribution::SpeciesList &
+RadialDistribution::getSpecies() const
+{
+  return mySpecies;
+}
+
+RadialDistribution::Distribution
+RadialDistribution::getPartial(const size_t speciesA,
+    const size_t speciesB) const
+{
+  SSLIB_ASSERT(speciesA < mySpecies.size());
+  SSLIB_ASSERT(speciesB < mySpecies.size());
+
+  const SpeciesPair key(
+      ::std::min(mySpecies[speciesA], mySpecies[speciesB]),
+      ::std::max(mySpecies[speciesA], mySpecies[speciesB]));
+  const Pairs::const_iterator it = myPairs.find(key);
+  if(it == myPairs.end())
+    return Distribution(numBins(), 0.0);
+  return normalise(it->second->counts, it->second->norm);
+}
+
+void
+RadialDistribution::addSpecies(const SpeciesList & species)
+{
+  SpeciesList merged;
+  ::std::set_union(mySpecies.begin(), mySpecies.end(), species.begin(),
+      species.end(), ::std::back_inserter(merged));
+  mySpecies.swap(merged);
+}
+
+RadialDistribution::Distribution
+RadialDistribution::normalise(const Histogram & counts,
+    const double norm) const
+{
+  Distribution g(numBins(), 0.0);
+  if(norm == 0.0)
+    return g;
+
+  const size_t numFilled = ::std::min(g.size(), counts.numBins());
+  for(size_t i = 0; i < numFilled; ++i)
+  {
+    const double rLower = static_cast< double>(i) * mySettings.binWidth;
+    const double rUpper = rLower + mySettings.binWidth;
+    const double shellVolume = 4.0 * common::constants::PI
+        * (rUpper * rUpper * rUpper - rLower * rLower * rLower) / 3.0;
+    g[i] = static_cast< double>(counts.getFrequency(i))
+        / (norm * shellVolume);
+  }
+  return g;
+}
+
+}
+}
@@ -9,6 +9,7 @@
 
 #ifdef SPL_USE_CGAL
 
+#include <cmath>
 #include <iterator>
 
 #include <boost/foreach.hpp>
@@ -27,9 +28,19 @@ namespace analysis {
 
 StructureTriangulation::StructureTriangulation(const common::Structure & structure):
     myStructure(structure),
+    myImageSkin(-1.0),
     myTriangulationCurrent(false)
 {}
 
+StructureTriangulation::StructureTriangulation(const common::Structure & structure,
+    const double imageSkin):
+    myStructure(structure),
+    myImageSkin(imageSkin),
+    myTriangulationCurrent(false)
+{
+  SSLIB_ASSERT(imageSkin >= 0.0);
+}
+
 const StructureTriangulation::Delaunay & StructureTriangulation::getTriangulation() const
 {
   if(!myTriangulationCurrent)
@@ -66,6 +77,27 @@ int StructureTriangulation::getCoordination(const common::Atom & atom) const
   return vertexHandles.size();
 }
 
+::std::vector<int> StructureTriangulation::getCoordinations() const
+{
+  ::std::vector<int> coordinations(myStructure.getNumAtoms(), 0);
+
+  // Each finite edge contributes to the coordination of its end points
+  // that are in the original cell
+  const Delaunay & triangulation = getTriangulation();
+  for(Delaunay::Finite_edges_iterator it = triangulation.finite_edges_begin(),
+      end = triangulation.finite_edges_end(); it != end; ++it)
+  {
+    const VertexInfo & info1 = it->first->vertex(it->second)->info();
+    const VertexInfo & info2 = it->first->vertex(it->third)->info();
+    if(info1.isInOriginalCell())
+      ++coordinations[info1.atomIndex];
+    if(info2.isInOriginalCell())
+      ++coordinations[info2.atomIndex];
+  }
+
+  return coordinations;
+}
+
 StructureTriangulation::Polyhedron StructureTriangulation::getCoordinationPolyhedron(const common::Atom & atom) const
 {
   SSLIB_DIE_NOT_IMPLEMENTED();
@@ -92,45 +124,102 @@ void StructureTriangulation::buildTriangulation() const
 {
   myTriangulation.clear();
 
-  const common::UnitCell * cell = myStructure.getUnitCell();
+  // Generate all the points up front and insert them as a range, this lets
+  // CGAL spatially sort them first which is much faster than inserting them
+  // one at a time
+  PointsWithInfo points;
+  generatePoints(&points);
+  myTriangulation.insert(points.begin(), points.end());
 
-  // Now insert the basis + images (if periodic) into the triangulation
-  for(size_t atomIdx = 0; atomIdx < myStructure.getNumAtoms(); ++atomIdx)
+  // Finally cache the atom vertex handles
+  updateVertexHandles();
+  myTriangulationCurrent = true;
+}
+
+void StructureTriangulation::generatePoints(PointsWithInfo * const points) const
+{
+  const size_t numAtoms = myStructure.getNumAtoms();
+  const common::UnitCell * const cell = myStructure.getUnitCell();
+  if(!cell)
   {
-    const ::arma::vec3 & pos = myStructure.getAtom(atomIdx).getPosition();
-    if(cell)
+    points->reserve(numAtoms);
+    VertexInfo info;
+    for(size_t atomIdx = 0; atomIdx < numAtoms; ++atomIdx)
     {
-      ::arma::vec3 iA, iAPlusJB;
-      for(int i = -1; i <= 1; ++i)
+      info.atomIndex = atomIdx;
+      points->push_back(::std::make_pair(
+          math::armaToCgal<Kernel>(myStructure.getAtom(atomIdx).getPosition()), info));
+    }
+    return;
+  }
+
+  const ::arma::mat33 & orthoMtx = cell->getOrthoMtx();
+
+  // The skin expressed as a fraction of the spacing between lattice planes
+  // in each direction and the number of image shells needed to cover it
+  double fracSkin[3];
+  int maxShell[3];
+  for(size_t i = 0; i < 3; ++i)
+  {
+    if(myImageSkin < 0.0)
+    {
+      fracSkin[i] = 1.0;
+      maxShell[i] = 1;
+    }
+    else
+    {
+      const ::arma::vec3 planeNormal = ::arma::cross(orthoMtx.col((i + 1) % 3),
+          orthoMtx.col((i + 2) % 3));
+      fracSkin[i] = myImageSkin * ::arma::norm(planeNormal, 2) / cell->getVolume();
+      maxShell[i] = static_cast<int>(::std::ceil(fracSkin[i]));
+    }
+  }
+
+  points->reserve(numAtoms * (2 * maxShell[0] + 1) * (2 * maxShell[1] + 1)
+      * (2 * maxShell[2] + 1));
+
+  ::arma::mat fracs;
+  myStructure.getAtomPositions(fracs);
+  cell->cartsToFracInplace(fracs);
+
+  VertexInfo info;
+  ::arma::vec3 wrapped, offset;
+  int n[3];
+  for(size_t atomIdx = 0; atomIdx < numAtoms; ++atomIdx)
+  {
+    info.atomIndex = atomIdx;
+    for(size_t d = 0; d < 3; ++d)
+      wrapped(d) = fracs(d, atomIdx) - ::std::floor(fracs(d, atomIdx));
+
+    for(n[0] = -maxShell[0]; n[0] <= maxShell[0]; ++n[0])
+    {
+      for(n[1] = -maxShell[1]; n[1] <= maxShell[1]; ++n[1])
       {
-        iA = static_cast<double>(i) * cell->getAVec();
-        for(int j = -1; j <= 1; ++j)
+        for(n[2] = -maxShell[2]; n[2] <= maxShell[2]; ++n[2])
         {
-          iAPlusJB = iA + static_cast<double>(j) * cell->getBVec();
-          for(int k = -1; k <= 1; ++k)
+          // Is this image within the skin surrounding the cell?
+          bool inSkin = true;
+          for(size_t d = 0; inSkin && d < 3; ++d)
+          {
+            const double f = wrapped(d) + n[d];
+            inSkin = f >= -fracSkin[d] && f <= 1.0 + fracSkin[d];
+          }
+          if(!inSkin)
+            continue;
+
+          // Images are of the atom wrapped into the cell so that cell
+          // position (0, 0, 0) really is the one inside the cell
+          for(size_t d = 0; d < 3; ++d)
           {
-            const Delaunay::Vertex_handle vh =
-              myTriangulation.insert(
-                math::armaToCgal<Kernel>(pos + iAPlusJB + static_cast<double>(k) * cell->getCVec())
-              );
-            vh->info().atomIndex = atomIdx;
-            vh->info().cellPosition[0] = i;
-            vh->info().cellPosition[1] = j;
-            vh->info().cellPosition[2] = k;
+            info.cellPosition[d] = n[d];
+            offset(d) = wrapped(d) + n[d];
           }
+          points->push_back(::std::make_pair(
+              math::armaToCgal<Kernel>(orthoMtx * offset), info));
         }
       }
     }
-    else
-    {
-      Delaunay::Vertex_handle vh = myTriangulation.insert(math::armaToCgal<Kernel>(pos));
-      vh->info().atomIndex = atomIdx;
-    }
   }
-
-  // Finally cache the atom vertex handles
-  updateVertexHandles();
-  myTriangulationCurrent = true;
 }
 
 void StructureTriangulation::updateVertexHandles() const
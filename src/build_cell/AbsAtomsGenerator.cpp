@@ -28,9 +28,12 @@ namespace spl {
 namespace build_cell {
 
 AbsAtomsGenerator::AbsAtomsGenerator(const AbsAtomsGenerator & toCopy) :
-    myAtoms(toCopy.myAtoms), myGenShape(toCopy.myGenShape->clone()),
-    myLastTicketId(0)
+    myAtoms(toCopy.myAtoms), myLastTicketId(0), mySpeciesPairDistances(
+        toCopy.mySpeciesPairDistances), myGenerationSettings(
+        toCopy.myGenerationSettings)
 {
+  if(toCopy.myGenShape.get())
+    myGenShape = toCopy.myGenShape->clone();
 }
 
 void
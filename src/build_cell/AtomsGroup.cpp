@@ -128,7 +128,12 @@ IFragmentGeneratorPtr AtomsGroup::clone() const
 
   ::arma::vec4 axisAngle = myRot;
   if(myTransformMode & TransformMode::RAND_ROT_DIR)
-    axisAngle.rows(X, Z) = math::normaliseCopy(::arma::randu< ::arma::vec>(3));
+  {
+    ::arma::vec dir(3);
+    for(size_t i = 0; i < 3; ++i)
+      dir(i) = math::randu< double>();
+    axisAngle.rows(X, Z) = math::normaliseCopy(dir);
+  }
   if(myTransformMode & TransformMode::RAND_ROT_ANGLE)
     axisAngle(3) = math::randu(0.0, common::constants::TWO_PI);
 
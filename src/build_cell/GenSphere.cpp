@@ -144,7 +144,8 @@ GenSphere::randomPoint(const ::arma::mat44 & fullTransform) const
 
   // Get a random point with normally distributed x, y and z with with 0 mean and 1 variance.
   ::arma::vec3 point;
-  point.randn();
+  for(size_t i = X; i <= Z; ++i)
+    point(i) = math::randn< double>();
 
   // Normalise and scale
   point *= generateRadius() / (sqrt(::arma::dot(point, point)));
@@ -0,0 +1,197 @@
+/*
+ * ParallelStructureGenerator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES /////////////////////////////////
+#include "spl/build_cell/ParallelStructureGenerator.h"
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+
+#include <algorithm>
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+
+#include "spl/common/Structure.h"
+#include "spl/math/Random.h"
+
+namespace spl {
+namespace build_cell {
+
+ParallelStructureGenerator::Settings::Settings() :
+    numWorkers(0), queueCapacity(64), numStructures(0), maxAttempts(1000), seed(
+        0)
+{
+}
+
+ParallelStructureGenerator::Stats::Stats() :
+    attempts(0), successes(0), abandoned(0)
+{
+}
+
+ParallelStructureGenerator::ParallelStructureGenerator(
+    const StructureBuilder & builder,
+    const common::AtomSpeciesDatabase & speciesDb, const Settings & settings) :
+    mySpeciesDb(speciesDb), mySettings(settings), myStopping(false), myNumActive(
+        0), myNumClaimed(0)
+{
+  unsigned int numWorkers = mySettings.numWorkers;
+  if(numWorkers == 0)
+    numWorkers = ::std::max(1u, ::boost::thread::hardware_concurrency());
+
+  // Copy the builder here, in the calling thread, so the workers share nothing
+  for(unsigned int i = 0; i < numWorkers; ++i)
+    myBuilders.push_back(new StructureBuilder(builder));
+}
+
+ParallelStructureGenerator::~ParallelStructureGenerator()
+{
+  stop();
+  BOOST_FOREACH(common::Structure * const structure, myQueue)
+    delete structure;
+}
+
+void
+ParallelStructureGenerator::start()
+{
+  ::boost::mutex::scoped_lock lock(myMutex);
+  if(myNumActive > 0)
+    return;
+
+  myStopping = false;
+  myNumActive = myBuilders.size();
+  for(size_t i = 0; i < myBuilders.size(); ++i)
+    myWorkers.create_thread(
+        ::boost::bind(&ParallelStructureGenerator::work, this, i));
+}
+
+void
+ParallelStructureGenerator::stop()
+{
+  {
+    ::boost::mutex::scoped_lock lock(myMutex);
+    myStopping = true;
+  }
+  myNotFull.notify_all();
+  myWorkers.join_all();
+}
+
+bool
+ParallelStructureGenerator::pop(common::StructurePtr & structureOut)
+{
+  ::boost::mutex::scoped_lock lock(myMutex);
+  while(myQueue.empty() && myNumActive > 0)
+    myNotEmpty.wait(lock);
+
+  if(myQueue.empty())
+    return false;
+
+  structureOut.reset(myQueue.front());
+  myQueue.pop_front();
+  lock.unlock();
+
+  myNotFull.notify_one();
+  return true;
+}
+
+ParallelStructureGenerator::Stats
+ParallelStructureGenerator::getStats() const
+{
+  ::boost::mutex::scoped_lock lock(myMutex);
+  return myStats;
+}
+
+void
+ParallelStructureGenerator::work(const size_t workerIdx)
+{
+  // Each thread has its own generator so give each worker a separate stream
+  math::seedThread(mySettings.seed + static_cast< unsigned int>(workerIdx));
+  StructureBuilder & builder = myBuilders[workerIdx];
+
+  common::StructurePtr structure;
+  while(claim())
+  {
+    bool generated = false;
+    for(unsigned int attempt = 0; !generated && attempt < mySettings.maxAttempts;
+        ++attempt)
+    {
+      const GenerationOutcome outcome = builder.generateStructure(structure,
+          mySpeciesDb);
+      record(outcome);
+      generated = outcome.isSuccess();
+    }
+
+    if(!generated)
+      abandon();
+    else if(!push(structure))
+      break;
+  }
+  workerFinished();
+}
+
+bool
+ParallelStructureGenerator::claim()
+{
+  ::boost::mutex::scoped_lock lock(myMutex);
+  if(myStopping
+      || (mySettings.numStructures != 0
+          && myNumClaimed >= mySettings.numStructures))
+    return false;
+
+  ++myNumClaimed;
+  return true;
+}
+
+bool
+ParallelStructureGenerator::push(common::StructurePtr & structure)
+{
+  ::boost::mutex::scoped_lock lock(myMutex);
+  while(myQueue.size() >= mySettings.queueCapacity && !myStopping)
+    myNotFull.wait(lock);
+
+  if(myStopping)
+    return false;
+
+  myQueue.push_back(structure.release());
+  lock.unlock();
+
+  myNotEmpty.notify_one();
+  return true;
+}
+
+void
+ParallelStructureGenerator::record(const GenerationOutcome & outcome)
+{
+  ::boost::mutex::scoped_lock lock(myMutex);
+  ++myStats.attempts;
+  if(outcome.isSuccess())
+    ++myStats.successes;
+  else
+    ++myStats.failures[outcome.getMessage()];
+}
+
+void
+ParallelStructureGenerator::abandon()
+{
+  ::boost::mutex::scoped_lock lock(myMutex);
+  ++myStats.abandoned;
+}
+
+void
+ParallelStructureGenerator::workerFinished()
+{
+  {
+    ::boost::mutex::scoped_lock lock(myMutex);
+    --myNumActive;
+  }
+  // Wake any consumers so they can see that we're done
+  myNotEmpty.notify_all();
+}
+
+}
+}
+
+#endif // SPL_ENABLE_THREAD_AWARE
@@ -8,9 +8,12 @@
 #include "spl/build_cell/PointSeparator.h"
 
 #include <boost/foreach.hpp>
+#include <boost/variant/static_visitor.hpp>
 
 #include "spl/SSLibAssert.h"
 #include "spl/common/AtomSpeciesDatabase.h"
+#include "spl/common/DistanceCalculatorDelegator.h"
+#include "spl/math/Random.h"
 
 //#define DEBUG_POINT_SEPARATOR
 
@@ -69,11 +72,28 @@ SeparationData::SeparationData(const common::Structure & structure,
   setSeparationsFromLabels(labels, sepList);
 }
 
+void
+SeparationData::setUniformSeparation(const double separation)
+{
+  types.assign(points.n_cols, 0);
+  typeSeparations.set_size(1, 1);
+  typeSeparations.fill(separation);
+  separationOverrides.clear();
+}
+
+void
+SeparationData::setSeparation(const size_t i, const size_t j,
+    const double separation)
+{
+  SSLIB_ASSERT(i < points.n_cols && j < points.n_cols);
+  separationOverrides[utility::OrderedPair< size_t>(i, j)] = separation;
+}
+
 void
 SeparationData::init(const size_t numPoints)
 {
   points.zeros(3, numPoints);
-  separations.zeros(numPoints, numPoints);
+  setUniformSeparation(0.0);
 }
 
 PointSeparator::PointSeparator() :
@@ -87,85 +107,118 @@ PointSeparator::PointSeparator(const size_t maxIterations,
 {
 }
 
+struct PointSeparator::SeparatePointsVisitor : public boost::static_visitor<
+    bool>
+{
+  SeparatePointsVisitor(const PointSeparator & separator,
+      SeparationData * const sepData) :
+      mySeparator(separator), mySepData(sepData)
+  {
+  }
+
+  template< class DistCalc>
+    bool
+    operator()(const DistCalc & distCalc) const
+    {
+      return mySeparator.separatePoints(distCalc, mySepData);
+    }
+
+private:
+  const PointSeparator & mySeparator;
+  SeparationData * const mySepData;
+};
+
 bool
 PointSeparator::separatePoints(SeparationData * const sepData) const
 {
-  using std::sqrt;
-
   SSLIB_ASSERT(sepData);
 
-  const FixedList & fixed = generateFixedList(*sepData);
-  const arma::mat minSepSqs = sepData->separations % sepData->separations;
+  // Dispatch once on the type of distance calculator so that the loops below
+  // are compiled for each calculator with the distance calls inlined
+  SeparatePointsVisitor visitor(*this, sepData);
+  return common::visitDistanceCalculator(sepData->distanceCalculator, visitor);
+}
 
-  const size_t numPoints = sepData->points.n_cols;
-  if(numPoints == 0)
-    return true;
+template< class DistCalc>
+  bool
+  PointSeparator::separatePoints(const DistCalc & distCalc,
+      SeparationData * const sepData) const
+  {
+    using std::sqrt;
 
-  double sep, sepSq, sepDiff;
-  double maxOverlapFraction;
-  double prefactor; // Used to adjust the displacement vector if either atom is fixed
-  arma::vec3 dr, sepVec;
-  arma::mat delta(3, numPoints);
-  bool success = false;
+    const FixedList & fixed = generateFixedList(*sepData);
 
-  for(size_t iters = 0; iters < myMaxIterations; ++iters)
-  {
-    // First loop over calculating separations and checking for overlap
-    maxOverlapFraction = calcMaxOverlapFraction(*sepData, minSepSqs, fixed);
+    const size_t numPoints = sepData->points.n_cols;
+    if(numPoints == 0)
+      return true;
+
+    double sep, sepSq, sepDiff, minSep;
+    double maxOverlapFraction;
+    double prefactor; // Used to adjust the displacement vector if either atom is fixed
+    arma::vec3 dr, sepVec;
+    arma::mat delta(3, numPoints);
+    bool success = false;
+
+    for(size_t iters = 0; iters < myMaxIterations; ++iters)
+    {
+      // First loop over calculating separations and checking for overlap
+      maxOverlapFraction = calcMaxOverlapFraction(distCalc, *sepData, fixed);
 
 #ifdef DEBUG_POINT_SEPARATOR
-    std::cout << sepData->points.t() << "\n\n";
+      std::cout << sepData->points.t() << "\n\n";
 #endif
 
-    if(maxOverlapFraction < myTolerance)
-    {
-      success = true;
-      break;
-    }
+      if(maxOverlapFraction < myTolerance)
+      {
+        success = true;
+        break;
+      }
 
-    delta.zeros();
-    // Now fix-up any overlaps
-    for(size_t row = 0; row < numPoints - 1; ++row)
-    {
-      for(size_t col = row + 1; col < numPoints; ++col)
+      delta.zeros();
+      // Now fix-up any overlaps
+      for(size_t row = 0; row < numPoints - 1; ++row)
       {
-        if(!(fixed[row] && fixed[col]))
+        for(size_t col = row + 1; col < numPoints; ++col)
         {
-          sepVec = sepData->distanceCalculator.getVecMinImg(
-              sepData->points.col(row), sepData->points.col(col));
-          sepSq = arma::dot(sepVec, sepVec);
-          if(sepSq < minSepSqs(row, col))
+          if(!(fixed[row] && fixed[col]))
           {
-            // If both are free then share the displacement, otherwise all goes to one
-            prefactor = fixed[row] || fixed[col] ? 1.0 :  0.5;
-
-            if(sepSq != 0.0)
-            {
-              sep = sqrt(sepSq);
-              sepDiff = sepData->separations(row, col) - sep;
-
-              // Generate the displacement vector
-              dr = prefactor * sepDiff / sep * sepVec;
-            }
-            else // overlapping, so perturb randomly
+            sepVec = distCalc.getVecMinImg(sepData->points.col(row),
+                sepData->points.col(col));
+            sepSq = arma::dot(sepVec, sepVec);
+            minSep = sepData->getSeparation(row, col);
+            if(sepSq < minSep * minSep)
             {
-              dr = arma::randu(3);
-              dr *= 0.001 * sepData->separations(row, col) / arma::dot(dr, dr);
+              // If both are free then share the displacement, otherwise all goes to one
+              prefactor = fixed[row] || fixed[col] ? 1.0 :  0.5;
+
+              if(sepSq != 0.0)
+              {
+                sep = sqrt(sepSq);
+                sepDiff = minSep - sep;
+
+                // Generate the displacement vector
+                dr = prefactor * sepDiff / sep * sepVec;
+              }
+              else // overlapping, so perturb randomly
+              {
+                for(size_t i = 0; i < 3; ++i)
+                  dr(i) = math::randu< double>();
+                dr *= 0.001 * minSep / arma::dot(dr, dr);
+              }
+              // Move them
+              if(!fixed[row])
+                delta.col(row) -= dr;
+              if(!fixed[col])
+                delta.col(col) += dr;
             }
-            // Move them
-            if(!fixed[row])
-              delta.col(row) -= dr;
-            if(!fixed[col])
-              delta.col(col) += dr;
           }
         }
       }
+      sepData->points += delta;
     }
-    sepData->points += delta;
-  }
 
-  return success;
-}
+    return success;
+  }
 
 PointSeparator::FixedList
 PointSeparator::generateFixedList(const SeparationData & sepData) const
@@ -176,35 +229,37 @@ PointSeparator::generateFixedList(const SeparationData & sepData) const
   return fixed;
 }
 
-double
-PointSeparator::calcMaxOverlapFraction(const SeparationData & sepData,
-    const arma::mat & minSepSqs, const FixedList & fixed) const
-{
-  const size_t numPoints = sepData.points.n_cols;
-
-  double sepSq, maxOverlapSq = 0.0;
-  for(size_t row = 0; row < numPoints - 1; ++row)
+template< class DistCalc>
+  double
+  PointSeparator::calcMaxOverlapFraction(const DistCalc & distCalc,
+      const SeparationData & sepData, const FixedList & fixed) const
   {
-    const arma::vec3 & posI = sepData.points.col(row);
-    for(size_t col = row + 1; col < numPoints; ++col)
+    const size_t numPoints = sepData.points.n_cols;
+
+    double sepSq, minSep, maxOverlapSq = 0.0;
+    for(size_t row = 0; row < numPoints - 1; ++row)
     {
-      if(!(fixed[row] && fixed[col])) // Only if they're not both fixed
+      const arma::vec3 & posI = sepData.points.col(row);
+      for(size_t col = row + 1; col < numPoints; ++col)
       {
-        const arma::vec3 & posJ = sepData.points.col(col);
+        if(!(fixed[row] && fixed[col])) // Only if they're not both fixed
+        {
+          const arma::vec3 & posJ = sepData.points.col(col);
 
-        sepSq = sepData.distanceCalculator.getDistSqMinImg(posI, posJ);
+          sepSq = distCalc.getDistSqMinImg(posI, posJ);
+          minSep = sepData.getSeparation(row, col);
 
-        if(sepSq < minSepSqs(row, col))
-          maxOverlapSq = std::max(maxOverlapSq, minSepSqs(row, col) / sepSq);
+          if(sepSq < minSep * minSep)
+            maxOverlapSq = std::max(maxOverlapSq, minSep * minSep / sepSq);
+        }
       }
     }
+    // TODO: CHECK THIS
+    if(maxOverlapSq == 0.0)
+      return 0.0;
+    else
+      return 1.0 - 1.0 / std::sqrt(maxOverlapSq);
   }
-  // TODO: CHECK THIS
-  if(maxOverlapSq == 0.0)
-    return 0.0;
-  else
-    return 1.0 - 1.0 / std::sqrt(maxOverlapSq);
-}
 
 }
 }
@@ -197,7 +197,7 @@ bool
 StructureBuild::separateAtoms()
 {
   SeparationData sepData(myStructure);
-  sepData.separations = generateSepSqMatrix();
+  setSeparations(&sepData);
   const bool succeeded = myPointSeparator.separatePoints(&sepData);
   if(succeeded)
     myStructure.setAtomPositions(sepData.points);
@@ -271,69 +271,93 @@ StructureBuild::getSpeciesPairDistances() const
   return mySpeciesPairDistances;
 }
 
-::arma::mat
-StructureBuild::generateSepSqMatrix() const
+void
+StructureBuild::setSeparations(SeparationData * const sepData) const
 {
+  // Atoms with the same species and build radius are separated in the same
+  // way so they share a type
+  typedef ::std::pair< common::AtomSpeciesId::Value, OptionalDouble> TypeKey;
+  typedef ::std::map< TypeKey, size_t> Types;
+
   const size_t numAtoms = myStructure.getNumAtoms();
-  ::arma::mat sepSq = ::arma::zeros(numAtoms, numAtoms);
+  SSLIB_ASSERT(sepData->points.n_cols == numAtoms);
 
-  SpeciesPair pair;
+  Types types;
+  // An atom of each type
+  ::std::vector< const common::Atom *> typeAtoms;
   for(size_t i = 0; i < numAtoms; ++i)
   {
-    const common::Atom & atomI = myStructure.getAtom(i);
-    const BuildAtomInfo * infoI = getAtomInfo(atomI);
-    for(size_t j = i; j < numAtoms; ++j)
+    const common::Atom & atom = myStructure.getAtom(i);
+    const BuildAtomInfo * const info = getAtomInfo(atom);
+    const TypeKey key(atom.getSpecies(), info ? info->radius : OptionalDouble());
+
+    const ::std::pair< Types::iterator, bool> res = types.insert(
+        ::std::make_pair(key, typeAtoms.size()));
+    if(res.second)
+      typeAtoms.push_back(&atom);
+    sepData->types[i] = res.first->second;
+  }
+
+  const size_t numTypes = typeAtoms.size();
+  sepData->typeSeparations.set_size(numTypes, numTypes);
+  for(size_t i = 0; i < numTypes; ++i)
+  {
+    for(size_t j = i; j < numTypes; ++j)
     {
-      const common::Atom & atomJ = myStructure.getAtom(j);
-      const BuildAtomInfo * infoJ = getAtomInfo(atomJ);
-      pair.set(atomI.getSpecies(), atomJ.getSpecies());
+      sepData->typeSeparations(i, j) = sepData->typeSeparations(j, i) =
+          (1.0 - myAtomsOverlap) * calcSeparation(*typeAtoms[i], *typeAtoms[j]);
+    }
+  }
+  sepData->separationOverrides.clear();
+}
 
-      OptionalDouble rI, rJ;
+double
+StructureBuild::calcSeparation(const common::Atom & atomI,
+    const common::Atom & atomJ) const
+{
+  const SpeciesPair pair(atomI.getSpecies(), atomJ.getSpecies());
+  const BuildAtomInfo * const infoI = getAtomInfo(atomI);
+  const BuildAtomInfo * const infoJ = getAtomInfo(atomJ);
 
-      // Try to set the radii from build info (the most specific knowledge we have)
-      if(infoI)
-        rI = infoI->radius;
-      if(infoJ)
-        rJ = infoJ->radius;
+  OptionalDouble rI, rJ;
 
-      // If we couldn't find radii then try pair separation distances
-      if(!rI && !rJ)
-      {
-        // Try doing it by pair distances
-        SpeciesPairDistances::const_iterator it =
-            getSpeciesPairDistances().find(pair);
-        if(it != mySpeciesPairDistances.end())
-        {
-          // Give them each a half of the separation distance
-          rI.reset(0.5 * it->second);
-          rJ.reset(0.5 * it->second);
-        }
-      }
+  // Try to set the radii from build info (the most specific knowledge we have)
+  if(infoI)
+    rI = infoI->radius;
+  if(infoJ)
+    rJ = infoJ->radius;
 
-      rI = mySpeciesDb.getSpeciesPairDistance(pair);
-      if(rI)
-      {
-        rJ.reset(0.5 * *rI);
-        *rI = 0.5 * *rI;
-      }
+  // If we couldn't find radii then try pair separation distances
+  if(!rI && !rJ)
+  {
+    OptionalDouble pairDist;
+    const SpeciesPairDistances & pairDistances = getSpeciesPairDistances();
+    const SpeciesPairDistances::const_iterator it = pairDistances.find(pair);
+    if(it != pairDistances.end())
+      pairDist = it->second;
+    else
+      pairDist = mySpeciesDb.getSpeciesPairDistance(pair);
 
-      // Finally if we still don't have radii try getting it from the species database
-      // Try setting it from the species database radii
-      if(!rI)
-        rI = mySpeciesDb.getRadius(atomI.getSpecies());
-      if(!rJ)
-        rJ = mySpeciesDb.getRadius(atomJ.getSpecies());
-
-      double separation = 0.0;
-      if(rI)
-        separation += *rI;
-      if(rJ)
-        separation += *rJ;
-      sepSq(i, j) = separation * separation;
+    if(pairDist)
+    {
+      // Give them each a half of the separation distance
+      rI.reset(0.5 * *pairDist);
+      rJ.reset(0.5 * *pairDist);
     }
   }
 
-  return (1.0 - myAtomsOverlap) * ::arma::symmatu(sepSq);
+  // Finally if we still don't have radii try getting it from the species database
+  if(!rI)
+    rI = mySpeciesDb.getRadius(atomI.getSpecies());
+  if(!rJ)
+    rJ = mySpeciesDb.getRadius(atomJ.getSpecies());
+
+  double separation = 0.0;
+  if(rI)
+    separation += *rI;
+  if(rJ)
+    separation += *rJ;
+  return separation;
 }
 
 }
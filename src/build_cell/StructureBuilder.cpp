@@ -20,6 +20,7 @@
 #include "spl/build_cell/SymmetryGroup.h"
 #include "spl/common/Structure.h"
 #include "spl/utility/IndexingEnums.h"
+#include "spl/utility/Instrumentation.h"
 
 namespace spl {
 namespace build_cell {
@@ -40,17 +41,23 @@ StructureBuilder::StructureBuilder(const ConstructInfo & info) :
 }
 
 StructureBuilder::StructureBuilder(const StructureBuilder & toCopy) :
-    StructureBuilderCore(toCopy), myPointGroup(toCopy.myPointGroup), myNumSymOps(
+    StructureBuilderCore(toCopy), StructureGenerator(toCopy), AbsAtomsGenerator(
+        toCopy), myPointGroup(toCopy.myPointGroup), myNumSymOps(
         toCopy.myNumSymOps), myIsCluster(toCopy.myIsCluster), myAtomsOverlap(
-        toCopy.myAtomsOverlap), myUnitCellGenerator(
-        myUnitCellGenerator->clone())
+        toCopy.myAtomsOverlap)
 {
+  if(toCopy.myUnitCellGenerator.get())
+    myUnitCellGenerator = toCopy.myUnitCellGenerator->clone();
 }
 
 GenerationOutcome
 StructureBuilder::generateStructure(common::StructurePtr & structureOut,
     const common::AtomSpeciesDatabase & speciesDb)
 {
+  const utility::instrumentation::ScopedTimer timer(
+      "build_cell.StructureBuilder.generateStructure");
+  utility::instrumentation::count("build_cell.StructureBuilder.attempts");
+
   GenerationOutcome outcome;
 
   typedef ::std::pair< const FragmentGenerator *,
@@ -112,6 +119,7 @@ StructureBuilder::generateStructure(common::StructurePtr & structureOut,
 
   // TODO: Check global constraints
 
+  utility::instrumentation::count("build_cell.StructureBuilder.successes");
   outcome.setSuccess();
   return outcome;
 }
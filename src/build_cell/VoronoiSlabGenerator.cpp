@@ -10,6 +10,8 @@
 
 #ifdef SPL_USE_CGAL
 
+#include <map>
+
 #include <boost/range/iterator_range.hpp>
 
 #include <CGAL/centroid.h>
@@ -301,7 +303,10 @@ VoronoiSlabGenerator::Slab::separatePoints(SlabData * const slabData) const
   const size_t numVertices = slabData->vertices.size();
   SeparationData sepData(numVertices, slabData->distCalc);
 
-  sepData.separations.fill(0.0);
+  // Each distinct minimum separation is a type (type 0 has none), a pair must
+  // be at least the larger of their two minimum separations apart
+  ::std::vector< double> minSeps(1, 0.0);
+  ::std::map< double, size_t> minSepTypes;
   sepData.points.row(2).fill(0.0); // Set all z values to 0
   size_t idx = 0;
   BOOST_FOREACH(const Delaunay::Vertex_handle vtx, slabData->vertices)
@@ -312,15 +317,23 @@ VoronoiSlabGenerator::Slab::separatePoints(SlabData * const slabData) const
 
     if(vtx->info().minsep)
     {
-      for(size_t i = 0; i < numVertices; ++i)
-      {
-        double sep = std::max(sepData.separations(idx, i), *vtx->info().minsep);
-        sepData.separations(i, idx) = sepData.separations(idx, i) = sep;
-      }
+      const ::std::pair< ::std::map< double, size_t>::iterator, bool> res =
+          minSepTypes.insert(
+              ::std::make_pair(*vtx->info().minsep, minSeps.size()));
+      if(res.second)
+        minSeps.push_back(*vtx->info().minsep);
+      sepData.types[idx] = res.first->second;
     }
     ++idx;
   }
 
+  sepData.typeSeparations.set_size(minSeps.size(), minSeps.size());
+  for(size_t i = 0; i < minSeps.size(); ++i)
+  {
+    for(size_t j = 0; j < minSeps.size(); ++j)
+      sepData.typeSeparations(i, j) = std::max(minSeps[i], minSeps[j]);
+  }
+
   if(slabData->unitCell)
     slabData->unitCell->wrapVecsInplace(sepData.points);
 
@@ -0,0 +1,296 @@
+/*
+ * CompactFormula.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES ///////////////
+#include "spl/common/CompactFormula.h"
+
+#include <cstdlib>
+#include <deque>
+#include <map>
+#include <stdexcept>
+
+#include <boost/functional/hash.hpp>
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <boost/thread/mutex.hpp>
+#endif
+
+#include "spl/SSLibAssert.h"
+#include "spl/common/AtomsFormula.h"
+#include "spl/math/NumberAlgorithms.h"
+
+namespace spl {
+namespace common {
+
+namespace {
+
+// Species names by id, a deque so that references to names stay valid
+::std::deque< ::std::string> speciesNames;
+::std::map< ::std::string, CompactFormula::SpeciesId> speciesIds;
+#ifdef SPL_ENABLE_THREAD_AWARE
+::boost::mutex speciesMutex;
+#endif
+
+}
+
+CompactFormula::SpeciesId
+CompactFormula::intern(const ::std::string & species)
+{
+#ifdef SPL_ENABLE_THREAD_AWARE
+  ::boost::mutex::scoped_lock lock(speciesMutex);
+#endif
+  const ::std::map< ::std::string, SpeciesId>::const_iterator it =
+      speciesIds.find(species);
+  if(it != speciesIds.end())
+    return it->second;
+
+  const SpeciesId id = static_cast< SpeciesId>(speciesNames.size());
+  speciesNames.push_back(species);
+  speciesIds[species] = id;
+  return id;
+}
+
+const ::std::string &
+CompactFormula::speciesName(const SpeciesId id)
+{
+#ifdef SPL_ENABLE_THREAD_AWARE
+  ::boost::mutex::scoped_lock lock(speciesMutex);
+#endif
+  SSLIB_ASSERT(id < speciesNames.size());
+  return speciesNames[id];
+}
+
+bool
+CompactFormula::fits(const AtomsFormula & formula)
+{
+  // Species with a count of zero don't take up an entry
+  size_t numSpecies = 0;
+  for(AtomsFormula::const_iterator it = formula.begin(), end = formula.end();
+      it != end; ++it)
+  {
+    if(it->second != 0)
+      ++numSpecies;
+  }
+  return numSpecies <= MAX_SPECIES;
+}
+
+CompactFormula::CompactFormula() :
+    myNumSpecies(0), myHash(0)
+{
+  updateHash();
+}
+
+CompactFormula::CompactFormula(const AtomsFormula & formula) :
+    myNumSpecies(0), myHash(0)
+{
+  if(!fits(formula))
+    throw ::std::length_error("Formula has too many species");
+
+  for(AtomsFormula::const_iterator it = formula.begin(), end = formula.end();
+      it != end; ++it)
+    add(intern(it->first), it->second);
+  updateHash();
+}
+
+bool
+CompactFormula::isEmpty() const
+{
+  return myNumSpecies == 0;
+}
+
+int
+CompactFormula::numSpecies() const
+{
+  return static_cast< int>(myNumSpecies);
+}
+
+int
+CompactFormula::total() const
+{
+  int tot = 0;
+  for(size_t i = 0; i < myNumSpecies; ++i)
+    tot += myEntries[i].count;
+  return tot;
+}
+
+int
+CompactFormula::numberOf(const SpeciesId species) const
+{
+  for(size_t i = 0; i < myNumSpecies && myEntries[i].species <= species; ++i)
+  {
+    if(myEntries[i].species == species)
+      return myEntries[i].count;
+  }
+  return 0;
+}
+
+bool
+CompactFormula::add(const SpeciesId species, const int count)
+{
+  if(count == 0)
+    return true;
+
+  size_t pos = 0;
+  while(pos < myNumSpecies && myEntries[pos].species < species)
+    ++pos;
+
+  if(pos < myNumSpecies && myEntries[pos].species == species)
+  {
+    myEntries[pos].count += count;
+    if(myEntries[pos].count == 0)
+    {
+      // Remove the entry
+      for(size_t i = pos + 1; i < myNumSpecies; ++i)
+        myEntries[i - 1] = myEntries[i];
+      --myNumSpecies;
+    }
+  }
+  else
+  {
+    if(myNumSpecies == MAX_SPECIES)
+      return false;
+
+    for(size_t i = myNumSpecies; i > pos; --i)
+      myEntries[i] = myEntries[i - 1];
+    myEntries[pos].species = species;
+    myEntries[pos].count = count;
+    ++myNumSpecies;
+  }
+  updateHash();
+  return true;
+}
+
+CompactFormula &
+CompactFormula::operator +=(const CompactFormula & rhs)
+{
+  // Work on a copy so that we're left untouched if the sum doesn't fit
+  CompactFormula sum(*this);
+  for(size_t i = 0; i < rhs.myNumSpecies; ++i)
+  {
+    if(!sum.add(rhs.myEntries[i].species, rhs.myEntries[i].count))
+      throw ::std::length_error("Formula has too many species");
+  }
+  *this = sum;
+  return *this;
+}
+
+unsigned int
+CompactFormula::reduce()
+{
+  if(myNumSpecies == 0)
+    return 0;
+
+  unsigned int gcd = static_cast< unsigned int>(std::abs(myEntries[0].count));
+  for(size_t i = 1; i < myNumSpecies && gcd != 1; ++i)
+    gcd = math::greatestCommonDivisor(gcd,
+        static_cast< unsigned int>(std::abs(myEntries[i].count)));
+
+  if(gcd > 1)
+  {
+    for(size_t i = 0; i < myNumSpecies; ++i)
+      myEntries[i].count /= static_cast< int>(gcd);
+    updateHash();
+  }
+  return gcd;
+}
+
+size_t
+CompactFormula::hash() const
+{
+  return myHash;
+}
+
+bool
+CompactFormula::operator ==(const CompactFormula & rhs) const
+{
+  if(myHash != rhs.myHash || myNumSpecies != rhs.myNumSpecies)
+    return false;
+
+  for(size_t i = 0; i < myNumSpecies; ++i)
+  {
+    if(myEntries[i].species != rhs.myEntries[i].species
+        || myEntries[i].count != rhs.myEntries[i].count)
+      return false;
+  }
+  return true;
+}
+
+bool
+CompactFormula::operator !=(const CompactFormula & rhs) const
+{
+  return !(*this == rhs);
+}
+
+bool
+CompactFormula::operator <(const CompactFormula & rhs) const
+{
+  if(myNumSpecies != rhs.myNumSpecies)
+    return myNumSpecies < rhs.myNumSpecies;
+
+  for(size_t i = 0; i < myNumSpecies; ++i)
+  {
+    if(myEntries[i].species != rhs.myEntries[i].species)
+      return myEntries[i].species < rhs.myEntries[i].species;
+    if(myEntries[i].count != rhs.myEntries[i].count)
+      return myEntries[i].count < rhs.myEntries[i].count;
+  }
+  return false;
+}
+
+CompactFormula::const_iterator
+CompactFormula::begin() const
+{
+  return myEntries;
+}
+
+CompactFormula::const_iterator
+CompactFormula::end() const
+{
+  return myEntries + myNumSpecies;
+}
+
+AtomsFormula
+CompactFormula::toFormula() const
+{
+  AtomsFormula formula;
+  for(size_t i = 0; i < myNumSpecies; ++i)
+    formula[speciesName(myEntries[i].species)] = myEntries[i].count;
+  return formula;
+}
+
+::std::string
+CompactFormula::toString() const
+{
+  return toFormula().toString();
+}
+
+void
+CompactFormula::updateHash()
+{
+  size_t seed = myNumSpecies;
+  for(size_t i = 0; i < myNumSpecies; ++i)
+  {
+    ::boost::hash_combine(seed, myEntries[i].species);
+    ::boost::hash_combine(seed, myEntries[i].count);
+  }
+  myHash = seed;
+}
+
+size_t
+hash_value(const CompactFormula & formula)
+{
+  return formula.hash();
+}
+
+::std::ostream &
+operator <<(::std::ostream & os, const CompactFormula & formula)
+{
+  os << formula.toString();
+  return os;
+}
+
+}
+}
@@ -10,6 +10,7 @@
 
 #include "spl/common/ClusterDistanceCalculator.h"
 #include "spl/common/OrthoCellDistanceCalculator.h"
+#include "spl/common/Structure.h"
 #include "spl/common/UnitCell.h"
 #include "spl/common/UniversalCrystalDistanceCalculator.h"
 
@@ -18,7 +19,7 @@ namespace common {
 
 DistanceCalculatorDelegator::DistanceCalculatorDelegator(Structure & structure) :
     myStructure(structure), myDelegate(new ClusterDistanceCalculator()), myDelegateType(
-        CalculatorType::CLUSTER)
+        CalculatorType::CLUSTER), myWrappedPositionsCurrent(false)
 {
   // WARNING: Don't use structure here as it won't be initialised!!
 }
@@ -27,6 +28,13 @@ void
 DistanceCalculatorDelegator::setUnitCell(common::UnitCell * const unitCell)
 {
   updateDelegate();
+  invalidateWrappedPositions();
+}
+
+void
+DistanceCalculatorDelegator::invalidateWrappedPositions()
+{
+  myWrappedPositionsCurrent = false;
 }
 
 void
@@ -81,5 +89,18 @@ DistanceCalculatorDelegator::setDelegate(const CalculatorType::Value calcType)
   return delegateChanged;
 }
 
+void
+DistanceCalculatorDelegator::updateWrappedPositions() const
+{
+  myStructure.getAtomPositions(myWrappedPositions);
+  if(const UnitCell * const unitCell = myStructure.getUnitCell())
+  {
+    unitCell->cartsToFracInplace(myWrappedPositions);
+    unitCell->wrapVecsFracInplace(myWrappedPositions);
+    unitCell->fracsToCartInplace(myWrappedPositions);
+  }
+  myWrappedPositionsCurrent = true;
+}
+
 } // namespace spl
 } // namespace common
@@ -0,0 +1,146 @@
+/*
+ * GeometrySnapshot.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES ///////////////
+#include "spl/common/GeometrySnapshot.h"
+
+#include <iterator>
+
+#include "spl/common/ClusterDistanceCalculator.h"
+#include "spl/common/OrthoCellDistanceCalculator.h"
+#include "spl/common/Structure.h"
+#include "spl/common/UnitCell.h"
+#include "spl/common/UniversalCrystalDistanceCalculator.h"
+
+namespace spl {
+namespace common {
+
+GeometrySnapshot::GeometrySnapshot(const Structure & structure,
+    const bool primitive)
+{
+  const UnitCell * const unitCell = structure.getUnitCell();
+  const SymmetryCache::Primitive * const primitiveCell =
+      primitive && unitCell ?
+          structure.getPrimitiveCell(Structure::PRIMITIVE_TOLERANCE) : NULL;
+
+  if(primitiveCell && primitiveCell->species.size() < structure.getNumAtoms())
+  {
+    myCell.reset(new UnitCell(primitiveCell->lattice));
+    myPositions = primitiveCell->positions;
+    myCell->fracsWrapToCartInplace(myPositions);
+    mySpecies = primitiveCell->species;
+  }
+  else
+  {
+    if(unitCell)
+      myCell.reset(new UnitCell(*unitCell));
+    // The structure keeps these wrapped already
+    myPositions = structure.getDistanceCalculator().getWrappedPositions();
+    mySpecies.reserve(structure.getNumAtoms());
+    structure.getAtomSpecies(::std::back_inserter(mySpecies));
+  }
+
+  updateDistanceCalculator();
+}
+
+GeometrySnapshot::~GeometrySnapshot()
+{
+}
+
+size_t
+GeometrySnapshot::getNumAtoms() const
+{
+  return mySpecies.size();
+}
+
+const UnitCell *
+GeometrySnapshot::getUnitCell() const
+{
+  return myCell.get();
+}
+
+const ::arma::mat &
+GeometrySnapshot::getPositions() const
+{
+  return myPositions;
+}
+
+const GeometrySnapshot::SpeciesList &
+GeometrySnapshot::getSpecies() const
+{
+  return mySpecies;
+}
+
+const DistanceCalculator &
+GeometrySnapshot::getDistanceCalculator() const
+{
+  return *myDistanceCalculator;
+}
+
+void
+GeometrySnapshot::scale(const double scaleFactor)
+{
+  if(!myCell)
+    return;
+
+  myCell->cartsToFracInplace(myPositions);
+  myCell->setVolume(myCell->getVolume() * scaleFactor);
+  myCell->fracsToCartInplace(myPositions);
+}
+
+bool
+GeometrySnapshot::niggliReduce()
+{
+  if(!myCell || !myCell->niggliReduce())
+    return false;
+
+  // The lattice system may appear different with the new vectors
+  wrapPositions();
+  updateDistanceCalculator();
+  return true;
+}
+
+bool
+GeometrySnapshot::getDistsBetween(const size_t i, const size_t j,
+    const double cutoff, ::std::vector< double> & outDistances,
+    const size_t maxDistances, const unsigned int maxCellMultiples) const
+{
+  return myDistanceCalculator->getDistsBetweenWrapped(
+      myPositions.unsafe_col(i), myPositions.unsafe_col(j), cutoff,
+      outDistances, maxDistances, maxCellMultiples);
+}
+
+void
+GeometrySnapshot::wrapPositions()
+{
+  if(myCell && myPositions.n_cols != 0)
+    myCell->wrapVecsInplace(myPositions);
+}
+
+void
+GeometrySnapshot::updateDistanceCalculator()
+{
+  // Same choice of calculator as DistanceCalculatorDelegator
+  if(!myCell)
+    myDistanceCalculator.reset(new ClusterDistanceCalculator());
+  else
+  {
+    const UnitCell::LatticeSystem::Value latticeSystem =
+        myCell->getLatticeSystem(
+            OrthoCellDistanceCalculator::VALID_ANGLE_TOLERANCE);
+    if(latticeSystem == UnitCell::LatticeSystem::TETRAGONAL
+        || latticeSystem == UnitCell::LatticeSystem::CUBIC
+        || latticeSystem == UnitCell::LatticeSystem::ORTHORHOMBIC)
+      myDistanceCalculator.reset(new OrthoCellDistanceCalculator(myCell.get()));
+    else
+      myDistanceCalculator.reset(
+          new UniversalCrystalDistanceCalculator(myCell.get()));
+  }
+}
+
+}
+}
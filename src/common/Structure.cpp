@@ -8,15 +8,12 @@
 // INCLUDES /////////////////////////////////////
 #include "spl/common/Structure.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <boost/foreach.hpp>
 #include <boost/scoped_array.hpp>
 
-extern "C" {
-#  include <spglib/spglib.h>
-}
-
 #include "spl/SSLibAssert.h"
 #include "spl/common/Atom.h"
 #include "spl/common/AtomsFormula.h"
@@ -33,6 +30,8 @@ extern "C" {
 namespace spl {
 namespace common {
 
+const double Structure::PRIMITIVE_TOLERANCE = 0.05;
+
 class MatchSpecies : public std::unary_function< const Atom &, bool>
 {
 public:
@@ -52,18 +51,21 @@ private:
 };
 
 Structure::Structure() :
-    myAtomPositionsCurrent(false), myDistanceCalculator(*this)
+    myAtomPositionsCurrent(false), myDistanceCalculator(*this),
+    myNeighbourIndexCurrent(false)
 {
 }
 
 Structure::Structure(const UnitCell & cell) :
-    myAtomPositionsCurrent(false), myDistanceCalculator(*this)
+    myAtomPositionsCurrent(false), myDistanceCalculator(*this),
+    myNeighbourIndexCurrent(false)
 {
   setUnitCell(cell);
 }
 
 Structure::Structure(const Structure & toCopy) :
-    myAtomPositionsCurrent(false), myDistanceCalculator(*this)
+    myAtomPositionsCurrent(false), myDistanceCalculator(*this),
+    myNeighbourIndexCurrent(false)
 {
   // Use the equals operator so we don't duplicate code
   *this = toCopy;
@@ -71,6 +73,8 @@ Structure::Structure(const Structure & toCopy) :
 
 Structure::~Structure()
 {
+  if(myCell)
+    myCell->removeListener(*this);
 }
 
 Structure &
@@ -151,14 +155,19 @@ Structure::setUnitCell(const UnitCell & cell)
     return;
 
   myCell.reset(cell);
+  myCell->addListener(*this);
   myDistanceCalculator.setUnitCell(::boost::get_pointer(myCell));
+  mySymmetry.invalidate();
 }
 
 void
 Structure::clearUnitCell()
 {
+  if(myCell)
+    myCell->removeListener(*this);
   myCell.reset();
   myDistanceCalculator.setUnitCell(NULL);
+  mySymmetry.invalidate();
 }
 
 size_t
@@ -198,7 +207,7 @@ Structure::getAtom(const size_t idx) const
 Atom &
 Structure::newAtom(const AtomSpeciesId::Value species)
 {
-  myAtomPositionsCurrent = false;
+  invalidatePositions();
   Atom * const atom = new Atom(species, myAtoms.size());
   myAtoms.push_back(atom);
   atom->addListener(this);
@@ -208,7 +217,7 @@ Structure::newAtom(const AtomSpeciesId::Value species)
 Atom &
 Structure::newAtom(const Atom & toCopy)
 {
-  myAtomPositionsCurrent = false;
+  invalidatePositions();
   Atom & atom = *myAtoms.insert(myAtoms.end(), new Atom(toCopy));
   atom.setIndex(myAtoms.size());
   atom.addListener(this);
@@ -225,7 +234,7 @@ Structure::eraseAtom(AtomIterator & it)
   for(size_t i = index; i < myAtoms.size(); ++i)
     myAtoms[i].setIndex(i);
 
-  myAtomPositionsCurrent = false;
+  invalidatePositions();
   return ret;
 }
 
@@ -248,7 +257,7 @@ Structure::clearAtoms()
 
   myAtoms.clear();
 
-  myAtomPositionsCurrent = false;
+  invalidatePositions();
   return previousNumAtoms;
 }
 
@@ -286,6 +295,8 @@ Structure::setAtomPositions(const ::arma::mat & posMtx)
   // Save the new positions in the buffer
   myAtomPositionsBuffer = posMtx;
   myAtomPositionsCurrent = true;
+  myNeighbourIndexCurrent = false;
+  myDistanceCalculator.invalidateWrappedPositions();
 }
 
 size_t
@@ -305,12 +316,86 @@ Structure::getComposition() const
   return comp;
 }
 
-const DistanceCalculator &
+const DistanceCalculatorDelegator &
 Structure::getDistanceCalculator() const
 {
   return myDistanceCalculator;
 }
 
+size_t
+Structure::getNeighbours(const ::arma::vec3 & point, const double radius,
+    ::std::vector< size_t> * const neighbours) const
+{
+  if(!myCell)
+    return getNeighbourIndex().radiusQuery(point, radius, neighbours);
+
+  const double radiusSq = radius * radius;
+  size_t numFound = 0;
+  for(size_t i = 0; i < myAtoms.size(); ++i)
+  {
+    if(myDistanceCalculator.getDistSqMinImg(point, myAtoms[i].getPosition())
+        <= radiusSq)
+    {
+      neighbours->push_back(i);
+      ++numFound;
+    }
+  }
+  return numFound;
+}
+
+size_t
+Structure::getNeighbours(const size_t atomIdx, const double radius,
+    ::std::vector< size_t> * const neighbours) const
+{
+  SSLIB_ASSERT(atomIdx < getNumAtoms());
+
+  const size_t start = neighbours->size();
+  getNeighbours(myAtoms[atomIdx].getPosition(), radius, neighbours);
+  neighbours->erase(
+      ::std::remove(neighbours->begin() + start, neighbours->end(), atomIdx),
+      neighbours->end());
+  return neighbours->size() - start;
+}
+
+size_t
+Structure::getNearestNeighbours(const ::arma::vec3 & point, const size_t k,
+    ::std::vector< size_t> * const neighbours) const
+{
+  if(!myCell)
+    return getNeighbourIndex().nearestQuery(point, k, neighbours);
+
+  ::std::vector< ::std::pair< double, size_t> > distances(myAtoms.size());
+  for(size_t i = 0; i < myAtoms.size(); ++i)
+    distances[i] = ::std::make_pair(
+        myDistanceCalculator.getDistSqMinImg(point, myAtoms[i].getPosition()),
+        i);
+
+  const size_t numFound = ::std::min(k, distances.size());
+  ::std::partial_sort(distances.begin(), distances.begin() + numFound,
+      distances.end());
+  for(size_t i = 0; i < numFound; ++i)
+    neighbours->push_back(distances[i].second);
+  return numFound;
+}
+
+size_t
+Structure::getNearestNeighbours(const size_t atomIdx, const size_t k,
+    ::std::vector< size_t> * const neighbours) const
+{
+  SSLIB_ASSERT(atomIdx < getNumAtoms());
+
+  // Ask for one extra as the atom will find itself
+  const size_t start = neighbours->size();
+  getNearestNeighbours(myAtoms[atomIdx].getPosition(), k + 1, neighbours);
+  const ::std::vector< size_t>::iterator self = ::std::find(
+      neighbours->begin() + start, neighbours->end(), atomIdx);
+  if(self != neighbours->end())
+    neighbours->erase(self);
+  else if(neighbours->size() - start > k)
+    neighbours->pop_back();
+  return neighbours->size() - start;
+}
+
 ::boost::optional< ::std::string>
 Structure::getVisibleProperty(const VisibleProperty & property) const
 {
@@ -324,103 +409,39 @@ Structure::setVisibleProperty(VisibleProperty & property,
   property.setValue(properties(), value);
 }
 
+const SymmetryCache::Dataset *
+Structure::getSymmetryDataset(const double tolerance) const
+{
+  return mySymmetry.getDataset(*this, tolerance);
+}
+
+const SymmetryCache::Primitive *
+Structure::getPrimitiveCell(const double tolerance) const
+{
+  return mySymmetry.getPrimitive(*this, tolerance);
+}
+
 bool
 Structure::makePrimitive()
 {
-  const size_t numAtoms = myAtoms.size();
-  if(!getUnitCell() || numAtoms == 0)
+  const SymmetryCache::Primitive * const primitive = getPrimitiveCell(
+      PRIMITIVE_TOLERANCE);
+  if(!primitive || primitive->species.size() >= getNumAtoms())
     return false;
 
-  if(numAtoms > 0 && myCell)
-  {
-    double lattice[3][3];
-    const ::arma::mat33 & orthoMtx = myCell->getOrthoMtx();
-    for(size_t i = 0; i < 3; ++i)
-    {
-      for(size_t j = 0; j < 3; ++j)
-      {
-        // Row-major = column-major
-        lattice[i][j] = orthoMtx(i, j);
-      }
-    }
-
-    double (*positions)[3] = new double[numAtoms][3];
-    ::arma::mat posMtx;
-    getAtomPositions(posMtx);
-    myCell->cartsToFracInplace(posMtx);
-    for(size_t i = 0; i < numAtoms; ++i)
-    {
-      for(size_t j = 0; j < 3; ++j)
-      {
-        // Row-major = column-major
-        positions[i][j] = posMtx(j, i);
-      }
-    }
-
-    ::std::vector< AtomSpeciesId::Value> speciesVec;
-    ::std::vector< AtomSpeciesId::Value> speciesIdxVec;
-    getAtomSpecies(::std::back_inserter(speciesVec));
-    ::std::map< common::AtomSpeciesId::Value, int> speciesIndices;
-    int idx = 0;
-    BOOST_FOREACH(const common::AtomSpeciesId::Value & speciesId, speciesVec)
-    {
-      if(speciesIndices.insert(::std::make_pair(speciesId, idx)).second == true)
-      {
-        speciesIdxVec.push_back(speciesId);
-        ++idx;
-      }
-    }
-
-    ::boost::scoped_array< int> species(new int[speciesVec.size()]);
-    for(size_t i = 0; i < speciesVec.size(); ++i)
-    {
-      species[i] = speciesIndices[speciesVec[i]];
-    }
-
-    // Try to find the primitive unit cell
-    const size_t newNumAtoms = static_cast< size_t>(spg_find_primitive(lattice,
-        positions, species.get(), numAtoms, 0.05));
-
-    if(newNumAtoms != 0 && newNumAtoms < numAtoms)
-    {
-      // First deal with lattice
-      ::arma::mat33 newLattice;
-      for(size_t i = 0; i < 3; ++i)
-      {
-        for(size_t j = 0; j < 3; ++j)
-        {
-          newLattice(i, j) = lattice[i][j];
-        }
-      }
-
-      myCell->setOrthoMtx(newLattice);
-
-      // Now deal with atoms
-      clearAtoms();
-
-      Atom * atom;
-      ::arma::vec3 pos;
-
-      for(size_t i = 0; i < newNumAtoms; ++i)
-      {
-        atom = &newAtom(speciesIdxVec[species[i]]);
-        pos << positions[i][0] << ::arma::endr << positions[i][1]
-            << ::arma::endr << positions[i][2] << ::arma::endr;
-        atom->setPosition(myCell->fracWrapToCartInplace(pos));
-      }
-      delete[] positions;
-      return true;
-    }
-  }
-
-  return false;
+  // Take a copy as changing the structure will invalidate the cache
+  applyPrimitive(SymmetryCache::Primitive(*primitive));
+  return true;
 }
 
 UniquePtr< Structure>::Type
 Structure::getPrimitiveCopy() const
 {
   UniquePtr< Structure>::Type structure(new Structure(*this));
-  structure->makePrimitive();
+  const SymmetryCache::Primitive * const primitive = getPrimitiveCell(
+      PRIMITIVE_TOLERANCE);
+  if(primitive && primitive->species.size() < getNumAtoms())
+    structure->applyPrimitive(*primitive);
   return structure;
 }
 
@@ -476,7 +497,7 @@ void
 Structure::onAtomMoved(Atom * const atom)
 {
   // Atom has moved so the buffer is not longer current
-  myAtomPositionsCurrent = false;
+  invalidatePositions();
 }
 
 void
@@ -484,6 +505,28 @@ Structure::onAtomDestroyed(Atom * const atom)
 {
 }
 
+void
+Structure::onUnitCellChanged(UnitCell & unitCell)
+{
+  myDistanceCalculator.invalidateWrappedPositions();
+  mySymmetry.invalidate();
+}
+
+void
+Structure::onUnitCellVolumeChanged(UnitCell & unitCell, const double oldVol,
+    const double newVol)
+{
+  myDistanceCalculator.invalidateWrappedPositions();
+  mySymmetry.invalidate();
+}
+
+void
+Structure::onUnitCellDestroyed()
+{
+  myDistanceCalculator.invalidateWrappedPositions();
+  mySymmetry.invalidate();
+}
+
 void
 Structure::updatePosBuffer() const
 {
@@ -496,6 +539,45 @@ Structure::updatePosBuffer() const
   myAtomPositionsCurrent = true;
 }
 
+void
+Structure::invalidatePositions()
+{
+  myAtomPositionsCurrent = false;
+  myNeighbourIndexCurrent = false;
+  myDistanceCalculator.invalidateWrappedPositions();
+  mySymmetry.invalidate();
+}
+
+const math::KdTree &
+Structure::getNeighbourIndex() const
+{
+  if(!myNeighbourIndexCurrent)
+  {
+    if(!myAtomPositionsCurrent)
+      updatePosBuffer();
+    myNeighbourIndex.build(myAtomPositionsBuffer);
+    myNeighbourIndexCurrent = true;
+  }
+  return myNeighbourIndex;
+}
+
+void
+Structure::applyPrimitive(const SymmetryCache::Primitive & primitive)
+{
+  SSLIB_ASSERT(myCell);
+
+  myCell->setOrthoMtx(primitive.lattice);
+
+  clearAtoms();
+  ::arma::vec3 pos;
+  for(size_t i = 0; i < primitive.species.size(); ++i)
+  {
+    pos = primitive.positions.col(i);
+    newAtom(primitive.species[i]).setPosition(
+        myCell->fracWrapToCartInplace(pos));
+  }
+}
+
 } // namespace common
 } // namespace spl
 
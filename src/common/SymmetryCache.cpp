@@ -0,0 +1,178 @@
+/*
+ * SymmetryCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "spl/common/SymmetryCache.h"
+
+#include <algorithm>
+#include <map>
+
+#include <boost/algorithm/string/trim.hpp>
+
+extern "C" {
+#  include <spglib/spglib.h>
+}
+
+#include "spl/common/Structure.h"
+#include "spl/common/UnitCell.h"
+
+// NAMESPACES ////////////////////////////////
+
+namespace spl {
+namespace common {
+
+const SymmetryCache::Dataset *
+SymmetryCache::getDataset(const Structure & structure,
+    const double tolerance) const
+{
+  if(!structure.getUnitCell() || structure.getNumAtoms() == 0)
+    return NULL;
+
+  Datasets::iterator it = myDatasets.find(tolerance);
+  if(it != myDatasets.end())
+    return ::boost::get_pointer(it->second);
+
+  const Input & in = getInput(structure);
+  SpglibDataset * const spgData = spg_get_dataset(in.lattice,
+      reinterpret_cast< SPGCONST double (*)[3]>(&in.positions[0]),
+      &in.species[0], static_cast< int>(in.species.size()), tolerance);
+
+  it = myDatasets.insert(::std::make_pair(tolerance, ::boost::none)).first;
+  if(!spgData)
+    return NULL;
+
+  Dataset dataset;
+  dataset.spacegroupNumber = spgData->spacegroup_number;
+  dataset.iucSymbol = spgData->international_symbol;
+  ::boost::algorithm::trim(dataset.iucSymbol);
+  dataset.hallSymbol = spgData->hall_symbol;
+  ::boost::algorithm::trim(dataset.hallSymbol);
+
+  dataset.rotations.resize(spgData->n_operations);
+  dataset.translations.resize(spgData->n_operations);
+  for(int op = 0; op < spgData->n_operations; ++op)
+  {
+    for(size_t i = 0; i < 3; ++i)
+    {
+      for(size_t j = 0; j < 3; ++j)
+        dataset.rotations[op](i, j) = spgData->rotations[op][i][j];
+      dataset.translations[op](i) = spgData->translations[op][i];
+    }
+  }
+  dataset.equivalentAtoms.assign(spgData->equivalent_atoms,
+      spgData->equivalent_atoms + spgData->n_atoms);
+
+  spg_free_dataset(spgData);
+
+  it->second = dataset;
+  return ::boost::get_pointer(it->second);
+}
+
+const SymmetryCache::Primitive *
+SymmetryCache::getPrimitive(const Structure & structure,
+    const double tolerance) const
+{
+  if(!structure.getUnitCell() || structure.getNumAtoms() == 0)
+    return NULL;
+
+  Primitives::iterator it = myPrimitives.find(tolerance);
+  if(it != myPrimitives.end())
+    return ::boost::get_pointer(it->second);
+
+  // spglib works in place so give it copies
+  const Input & in = getInput(structure);
+  double lattice[3][3];
+  ::std::copy(&in.lattice[0][0], &in.lattice[0][0] + 9, &lattice[0][0]);
+  ::std::vector< double> positions(in.positions);
+  ::std::vector< int> species(in.species);
+
+  const int numPrimitive = spg_find_primitive(lattice,
+      reinterpret_cast< double (*)[3]>(&positions[0]), &species[0],
+      static_cast< int>(species.size()), tolerance);
+
+  it = myPrimitives.insert(::std::make_pair(tolerance, ::boost::none)).first;
+  if(numPrimitive <= 0)
+    return NULL;
+
+  Primitive primitive;
+  for(size_t i = 0; i < 3; ++i)
+  {
+    for(size_t j = 0; j < 3; ++j)
+    {
+      // Row-major = column-major
+      primitive.lattice(i, j) = lattice[i][j];
+    }
+  }
+  primitive.positions.set_size(3, numPrimitive);
+  primitive.species.resize(numPrimitive);
+  for(int i = 0; i < numPrimitive; ++i)
+  {
+    for(size_t j = 0; j < 3; ++j)
+      primitive.positions(j, i) = positions[3 * i + j];
+    primitive.species[i] = in.speciesList[species[i]];
+  }
+
+  it->second = primitive;
+  return ::boost::get_pointer(it->second);
+}
+
+void
+SymmetryCache::invalidate()
+{
+  myInput.reset();
+  myDatasets.clear();
+  myPrimitives.clear();
+}
+
+const SymmetryCache::Input &
+SymmetryCache::getInput(const Structure & structure) const
+{
+  if(myInput)
+    return *myInput;
+
+  const UnitCell & cell = *structure.getUnitCell();
+  const size_t numAtoms = structure.getNumAtoms();
+
+  Input in;
+  const ::arma::mat33 & orthoMtx = cell.getOrthoMtx();
+  for(size_t i = 0; i < 3; ++i)
+  {
+    for(size_t j = 0; j < 3; ++j)
+    {
+      // Row-major = column-major
+      // [row][col] = mtx(row, col)
+      in.lattice[i][j] = orthoMtx(i, j);
+    }
+  }
+
+  ::arma::mat posMtx;
+  structure.getAtomPositions(posMtx);
+  cell.cartsToFracInplace(posMtx);
+  cell.wrapVecsFracInplace(posMtx);
+  // Column-major 3xN is the same layout as [atomIdx][X/Y/Z]
+  in.positions.assign(posMtx.memptr(), posMtx.memptr() + 3 * numAtoms);
+
+  ::std::map< AtomSpeciesId::Value, int> speciesIndices;
+  in.species.resize(numAtoms);
+  for(size_t i = 0; i < numAtoms; ++i)
+  {
+    const AtomSpeciesId::Value & speciesId = structure.getAtom(i).getSpecies();
+    const ::std::pair< ::std::map< AtomSpeciesId::Value, int>::iterator, bool> res =
+        speciesIndices.insert(
+            ::std::make_pair(speciesId,
+                static_cast< int>(in.speciesList.size())));
+    if(res.second)
+      in.speciesList.push_back(speciesId);
+    in.species[i] = res.first->second;
+  }
+
+  myInput = in;
+  return *myInput;
+}
+
+}
+}
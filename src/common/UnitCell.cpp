@@ -13,6 +13,7 @@
 #include "spl/SSLibAssert.h"
 #include "spl/common/Constants.h"
 #include "spl/common/Structure.h"
+#include "spl/math/Random.h"
 #include "spl/utility/IndexingEnums.h"
 
 namespace spl {
@@ -336,7 +337,8 @@ const double (&
     UnitCell::randomPoint() const
     {
       arma::vec3 rand;
-      rand.randu();
+      for(size_t i = 0; i < 3; ++i)
+        rand(i) = math::randu< double>();
       return fracToCartInplace(rand);
     }
 
@@ -11,70 +11,57 @@
 namespace spl {
 namespace common {
 
-UniversalCrystalDistanceCalculator::UniversalCrystalDistanceCalculator(
-    UnitCell * const unitCell):
-        myUnitCell(NULL)
-{
-  SSLIB_ASSERT(unitCell);
+namespace {
 
-  setUnitCell(unitCell);
-}
-
-UniversalCrystalDistanceCalculator::~UniversalCrystalDistanceCalculator()
-{
-  if(myUnitCell)
-    myUnitCell->removeListener(*this);
-}
-
-::arma::vec3
-UniversalCrystalDistanceCalculator::getVecMinImg(const arma::vec3 & a,
-    const arma::vec3 & b, const unsigned int maxCellMultiples) const
+// Reduce the basis (columns of basis) by repeatedly subtracting integer
+// multiples of each vector from the others until none can be shortened.
+// Only the lattice matters to the caller so the change of basis isn't kept.
+void
+reduceBasis(arma::mat33 & basis)
 {
-  const UnitCell & cell = *myUnitCell;
-
-  // Make sure cart1 and 2 are in the unit cell at the origin
-  const arma::vec3 dR = cell.wrapVec(b) - cell.wrapVec(a);
-  double minModDRSq = dot(dR, dR);
-  const double minModDR = std::sqrt(minModDRSq);
-
-  // Maximum multiple of cell vectors we need to go to
-  int A_max = static_cast< int>(std::ceil(
-      getNumPlaneRepetitionsToBoundSphere(myCache.B, myCache.C, minModDR)));
-  int B_max = static_cast< int>(std::ceil(
-      getNumPlaneRepetitionsToBoundSphere(myCache.A, myCache.C, minModDR)));
-  int C_max = static_cast< int>(std::ceil(
-      getNumPlaneRepetitionsToBoundSphere(myCache.A, myCache.B, minModDR)));
-
-  bool problemDuringCalculation = false;
-  problemDuringCalculation |= capMultiples(A_max, maxCellMultiples);
-  problemDuringCalculation |= capMultiples(B_max, maxCellMultiples);
-  problemDuringCalculation |= capMultiples(C_max, maxCellMultiples);
+  static const unsigned int MAX_ITERATIONS = 1000;
+  static const double TOL = 1e-10;
 
-  // Loop variables
-  arma::vec3 minDR = dR;
-  double modDRSq;
-  arma::vec3 nA, nAPlusNB, dRImg;
-  for(int a = -A_max; a <= A_max; ++a)
+  bool changed = true;
+  for(unsigned int iter = 0; changed && iter < MAX_ITERATIONS; ++iter)
   {
-    nA = a * myCache.A;
-    for(int b = -B_max; b <= B_max; ++b)
+    changed = false;
+    for(size_t i = 0; i < 3; ++i)
     {
-      nAPlusNB = nA + b * myCache.B;
-      for(int c = -C_max; c <= C_max; ++c)
+      const double lenSq = arma::dot(basis.col(i), basis.col(i));
+      for(size_t j = 0; j < 3; ++j)
       {
-        dRImg = nAPlusNB + c * myCache.C + dR;
+        if(i == j)
+          continue;
 
-        modDRSq = dot(dRImg, dRImg);
-        if(modDRSq < minModDRSq)
+        // Only reduce if it will strictly shorten vector j
+        const double proj = arma::dot(basis.col(i), basis.col(j)) / lenSq;
+        if(std::abs(proj) > 0.5 + TOL)
         {
-          minModDRSq = modDRSq;
-          minDR = dRImg;
+          const double k = std::floor(proj + 0.5);
+          basis.col(j) -= k * basis.col(i);
+          changed = true;
         }
       }
     }
   }
+}
 
-  return minDR;
+}
+
+UniversalCrystalDistanceCalculator::UniversalCrystalDistanceCalculator(
+    UnitCell * const unitCell):
+        myUnitCell(NULL)
+{
+  SSLIB_ASSERT(unitCell);
+
+  setUnitCell(unitCell);
+}
+
+UniversalCrystalDistanceCalculator::~UniversalCrystalDistanceCalculator()
+{
+  if(myUnitCell)
+    myUnitCell->removeListener(*this);
 }
 
 bool
@@ -104,6 +91,8 @@ UniversalCrystalDistanceCalculator::getDistsBetween(const arma::vec3 & a,
   problemDuringCalculation |= capMultiples(A_max, maxCellMultiples);
   problemDuringCalculation |= capMultiples(B_max, maxCellMultiples);
   problemDuringCalculation |= capMultiples(C_max, maxCellMultiples);
+  countImages((2 * A_max + 1) * (2 * B_max + 1) * (2 * C_max + 1),
+      problemDuringCalculation);
 
   const double cutoffSq = cutoff * cutoff;
   size_t numFound = 0;
@@ -134,62 +123,6 @@ UniversalCrystalDistanceCalculator::getDistsBetween(const arma::vec3 & a,
   return !problemDuringCalculation;
 }
 
-bool
-UniversalCrystalDistanceCalculator::getVecsBetween(const arma::vec3 & a,
-    const arma::vec3 & b, const double cutoff,
-    std::vector< arma::vec3> & outValues, const size_t maxValues,
-    const unsigned int maxCellMultiples) const
-{
-  const UnitCell & cell = *myUnitCell;
-  const double vol = cell.getVolume();
-  const arma::vec3 dR = b - a;
-
-  int A_max = static_cast< int>(std::floor(
-      getNumPlaneRepetitionsToBoundSphere(
-          cutoff + std::abs(arma::dot(dR, myCache.bCrossCHat)), vol,
-          myCache.bCrossCLen)));
-  int B_max = static_cast< int>(std::floor(
-      getNumPlaneRepetitionsToBoundSphere(
-          cutoff + std::abs(arma::dot(dR, myCache.aCrossCHat)), vol,
-          myCache.aCrossCLen)));
-  int C_max = static_cast< int>(std::floor(
-      getNumPlaneRepetitionsToBoundSphere(
-          cutoff + std::abs(arma::dot(dR, myCache.aCrossBHat)), vol,
-          myCache.aCrossBLen)));
-
-  bool problemDuringCalculation = false;
-  problemDuringCalculation |= capMultiples(A_max, maxCellMultiples);
-  problemDuringCalculation |= capMultiples(B_max, maxCellMultiples);
-  problemDuringCalculation |= capMultiples(C_max, maxCellMultiples);
-
-  const double cutoffSq = cutoff * cutoff;
-  arma::vec3 outVec;
-  size_t numFound = 0;
-  arma::vec3 rA, rAB;
-  for(int a = -A_max; a <= A_max; ++a)
-  {
-    rA = a * myCache.A;
-    for(int b = -B_max; b <= B_max; ++b)
-    {
-      rAB = rA + b * myCache.B;
-      for(int c = -C_max; c <= C_max; ++c)
-      {
-        outVec = rAB + c * myCache.C + dR;
-
-        if(arma::dot(outVec, outVec) < cutoffSq)
-        {
-          outValues.push_back(outVec);
-          if(++numFound >= maxValues)
-            return false;
-        }
-      }
-    }
-  }
-
-  // Completed successfully
-  return !problemDuringCalculation;
-}
-
 bool
 UniversalCrystalDistanceCalculator::isValid() const
 {
@@ -213,18 +146,6 @@ UniversalCrystalDistanceCalculator::setUnitCell(common::UnitCell * const unitCel
   }
 }
 
-double
-UniversalCrystalDistanceCalculator::getNumPlaneRepetitionsToBoundSphere(
-    const arma::vec3 & planeVec1, const arma::vec3 & planeVec2,
-    const double radius) const
-{
-  // The vector normal to the plane
-  const arma::vec3 normal = arma::cross(planeVec1, planeVec2);
-  const double unitCellVolume = myUnitCell->getVolume(); // = a . |b x c|
-
-  return radius / unitCellVolume * std::sqrt(arma::dot(normal, normal));
-}
-
 void
 UniversalCrystalDistanceCalculator::onUnitCellChanged(UnitCell & unitCell)
 {
@@ -266,6 +187,19 @@ UniversalCrystalDistanceCalculator::Cache::update(const UnitCell & cell)
   aCrossC = arma::cross(A, C);
   aCrossCLen = std::sqrt(arma::dot(aCrossC, aCrossC));
   aCrossCHat = aCrossC / aCrossCLen;
+
+  reducedOrtho = cell.getOrthoMtx();
+  reduceBasis(reducedOrtho);
+  reducedFrac = arma::inv(reducedOrtho);
+
+  const double volume = std::abs(arma::det(reducedOrtho));
+  for(size_t i = 0; i < 3; ++i)
+  {
+    const arma::vec3 normal = arma::cross(reducedOrtho.col((i + 1) % 3),
+        reducedOrtho.col((i + 2) % 3));
+    reducedRepetitionsPerLength[i] = std::sqrt(arma::dot(normal, normal))
+        / volume;
+  }
 }
 
 }
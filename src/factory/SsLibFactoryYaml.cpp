@@ -170,7 +170,9 @@ Factory::createGeometryOptimiser(const Optimiser & options) const
   }
   else if(options.external)
   {
-    opt.reset(new potential::ExternalOptimiser(options.external->exe));
+    opt.reset(
+        new potential::ExternalOptimiser(options.external->exe,
+            options.external->persistent));
   }
 
   return opt;
@@ -24,6 +24,7 @@
 #include "spl/io/BoostFilesystem.h"
 #include "spl/io/Parsing.h"
 #include "spl/utility/IndexingEnums.h"
+#include "spl/utility/Instrumentation.h"
 
 // DEFINES /////////////////////////////////
 
@@ -76,6 +77,8 @@ common::types::StructurePtr
 CellReaderWriter::readStructure(std::istream & is) const
 {
   using namespace utility::cart_coords_enum;
+  const utility::instrumentation::ScopedTimer timer(
+      "io.CellReaderWriter.readStructure");
 
   static const boost::regex RE_FLOAT(
       "([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)");
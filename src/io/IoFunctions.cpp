@@ -8,6 +8,8 @@
 // INCLUDES //////////////////////////////////
 #include "spl/io/IoFunctions.h"
 
+#include <cmath>
+#include <cstdio>
 #include <iomanip>
 #include <sstream>
 
@@ -134,5 +136,84 @@ void writeToStream(::std::ostream & out, const double num, const unsigned digits
   return ss.str();
 }
 
+void appendFixed(::std::string * const buffer, const double num,
+    const unsigned digitsAfterDecimal)
+{
+  static const unsigned long long POWERS_OF_TEN[] =
+    { 1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+        10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+        100000000000ull, 1000000000000ull, 10000000000000ull,
+        100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+        100000000000000000ull };
+  static const int MAX_PRECISION = 17;
+
+  int precision = getPrecision(num, digitsAfterDecimal);
+  // A stream uses the default precision if it's given a negative one
+  if(precision < 0)
+    precision = 6;
+
+  const double absNum = ::std::abs(num);
+  const double scaledNum = precision <= MAX_PRECISION ?
+      absNum * static_cast< double>(POWERS_OF_TEN[precision]) : 0.0;
+  // Fall back to the stream for anything that won't fit exactly in a double
+  // (including inf and nan)
+  if(precision > MAX_PRECISION || !(scaledNum < 1.0e15))
+  {
+    buffer->append(toString(num, digitsAfterDecimal));
+    return;
+  }
+  // The scaling is out by at most an ulp so if we're that close to halfway
+  // (or on it, where the stream rounds to even) let the stream decide
+  const double wholeNum = ::std::floor(scaledNum);
+  const double remainder = scaledNum - wholeNum;
+  if(::std::abs(remainder - 0.5) <= scaledNum * 4.0e-16)
+  {
+    buffer->append(toString(num, digitsAfterDecimal));
+    return;
+  }
+
+  const unsigned long long scaled = static_cast< unsigned long long>(wholeNum)
+      + (remainder > 0.5 ? 1ull : 0ull);
+  const unsigned long long intPart = scaled / POWERS_OF_TEN[precision];
+  unsigned long long fracPart = scaled % POWERS_OF_TEN[precision];
+
+  // The stream keeps the sign of negative zero
+  if(num < 0.0 || (num == 0.0 && 1.0 / num < 0.0))
+    buffer->push_back('-');
+  appendUnsigned(buffer, static_cast< unsigned long>(intPart));
+  if(precision > 0)
+  {
+    char digits[MAX_PRECISION];
+    for(int i = precision - 1; i >= 0; --i)
+    {
+      digits[i] = static_cast< char>('0' + fracPart % 10);
+      fracPart /= 10;
+    }
+    buffer->push_back('.');
+    buffer->append(digits, precision);
+  }
+}
+
+void appendGeneral(::std::string * const buffer, const double num,
+    const int precision)
+{
+  char str[64];
+  const int len = ::std::sprintf(str, "%.*g", precision, num);
+  if(len > 0)
+    buffer->append(str, len);
+}
+
+void appendUnsigned(::std::string * const buffer, unsigned long num)
+{
+  char digits[24];
+  size_t pos = sizeof(digits);
+  do
+  {
+    digits[--pos] = static_cast< char>('0' + num % 10);
+    num /= 10;
+  } while(num != 0);
+  buffer->append(digits + pos, sizeof(digits) - pos);
+}
+
 }
 }
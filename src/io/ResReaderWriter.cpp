@@ -8,10 +8,11 @@
 // INCLUDES //////////////////////////////////
 #include "spl/io/ResReaderWriter.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <limits>
-#include <set>
+#include <sstream>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/foreach.hpp>
@@ -32,6 +33,8 @@
 #include "spl/io/IoFunctions.h"
 #include "spl/io/BoostFilesystem.h"
 #include "spl/utility/IndexingEnums.h"
+#include "spl/utility/Instrumentation.h"
+#include "spl/utility/UtilFunctions.h"
 
 // DEFINES /////////////////////////////////
 
@@ -54,10 +57,6 @@ void
 ResReaderWriter::writeStructure(spl::common::Structure & str,
     const ResourceLocator & locator) const
 {
-  using namespace utility::cell_params_enum;
-  using namespace utility::cart_coords_enum;
-  using spl::common::AtomSpeciesId;
-
   const fs::path filepath(locator.path());
   if(!filepath.has_filename())
     throw "Cannot write out structure without filepath";
@@ -69,16 +68,44 @@ ResReaderWriter::writeStructure(spl::common::Structure & str,
   }
 
   fs::ofstream strFile(filepath);
-  strFile << std::setprecision(std::numeric_limits< double>::digits10 + 2);
+  writeStructure(strFile, str, filepath.stem().string());
+
+  str.properties()[properties::io::LAST_ABS_FILE_PATH] = io::ResourceLocator(
+      io::absolute(filepath));
+
+  if(strFile.is_open())
+    strFile.close();
+}
+
+void
+ResReaderWriter::writeStructure(std::ostream & os,
+    const common::Structure & str, const std::string & defaultName) const
+{
+  std::string buffer;
+  writeStructure(&buffer, str, defaultName);
+  os.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
+}
+
+void
+ResReaderWriter::writeStructure(std::string * const buffer,
+    const common::Structure & str, const std::string & defaultName) const
+{
+  using namespace utility::cell_params_enum;
+  using namespace utility::cart_coords_enum;
+  using spl::common::AtomSpeciesId;
+
+  static const int PRECISION = std::numeric_limits< double>::digits10 + 2;
 
   const common::UnitCell * const cell = str.getUnitCell();
 
   //////////////////////////
   // Start title
   InfoLine infoLine(str);
-  if(!infoLine.name)
-    infoLine.name = filepath.stem().string();
-  strFile << "TITL " << infoLine << "\n";
+  if(!infoLine.name && !defaultName.empty())
+    infoLine.name = defaultName;
+  std::ostringstream title;
+  title << std::setprecision(PRECISION) << "TITL " << infoLine << "\n";
+  buffer->append(title.str());
 
   ///////////////////////////////////
   // Start lattice
@@ -87,12 +114,15 @@ ResReaderWriter::writeStructure(spl::common::Structure & str,
     const double (&latticeParams)[6] = cell->getLatticeParams();
 
     // Do cell parameters
-    strFile << "CELL 1.0";
+    buffer->append("CELL 1.0");
     for(size_t i = A; i <= GAMMA; ++i)
-      strFile << " " << latticeParams[i];
-    strFile << "\n";
+    {
+      buffer->push_back(' ');
+      appendGeneral(buffer, latticeParams[i], PRECISION);
+    }
+    buffer->push_back('\n');
   }
-  strFile << "LATT -1" << "\n";
+  buffer->append("LATT -1\n");
 
   // End lattice
 
@@ -101,7 +131,6 @@ ResReaderWriter::writeStructure(spl::common::Structure & str,
 
   // Get the species and positions of all atoms
   using std::vector;
-  using std::set;
 
   arma::mat positions;
   str.getAtomPositions(positions);
@@ -113,52 +142,104 @@ ResReaderWriter::writeStructure(spl::common::Structure & str,
 
   vector< AtomSpeciesId::Value> species;
   str.getAtomSpecies(std::back_inserter(species));
-  set< AtomSpeciesId::Value> uniqueSpecies(species.begin(), species.end());
-
-  // Output atom species
-  std::map< AtomSpeciesId::Value, std::string> speciesSymbols;
-  std::map< AtomSpeciesId::Value, unsigned int> speciesOrder;
-  strFile << "SFAC";
-  size_t idx = 1;
-  BOOST_FOREACH(const AtomSpeciesId::Value id, uniqueSpecies)
+  vector< AtomSpeciesId::Value> uniqueSpecies(species);
+  std::sort(uniqueSpecies.begin(), uniqueSpecies.end());
+  uniqueSpecies.erase(std::unique(uniqueSpecies.begin(), uniqueSpecies.end()),
+      uniqueSpecies.end());
+
+  // Output atom species, they are numbered by their position in the list
+  buffer->append("SFAC");
+  BOOST_FOREACH(const AtomSpeciesId::Value & id, uniqueSpecies)
   {
-    speciesSymbols[id] = id.empty() ? "?" : id;
-    speciesOrder[id] = idx;
-    ++idx;
-    strFile << " " << speciesSymbols[id];
+    buffer->push_back(' ');
+    buffer->append(id.empty() ? "?" : id);
   }
 
   // Now write out the atom positions along with the spcies
   for(size_t i = 0; i < positions.n_cols; ++i)
   {
-    const AtomSpeciesId::Value id = species[i];
-
-    strFile << "\n" << speciesSymbols[id] << " " << speciesOrder[id] << " "
-        << toString(positions(X, i), DIGITS_AFTER_DECIMAL) << " "
-        << toString(positions(Y, i), DIGITS_AFTER_DECIMAL) << " "
-        << toString(positions(Z, i), DIGITS_AFTER_DECIMAL) << " 1.0";
+    const AtomSpeciesId::Value & id = species[i];
+    const size_t order = std::lower_bound(uniqueSpecies.begin(),
+        uniqueSpecies.end(), id) - uniqueSpecies.begin() + 1;
+
+    buffer->push_back('\n');
+    buffer->append(id.empty() ? "?" : id);
+    buffer->push_back(' ');
+    appendUnsigned(buffer, order);
+    for(size_t j = X; j <= Z; ++j)
+    {
+      buffer->push_back(' ');
+      appendFixed(buffer, positions(j, i), DIGITS_AFTER_DECIMAL);
+    }
+    buffer->append(" 1.0");
   }
 
   // End atoms ///////////
 
-  strFile << "\nEND\n";
+  buffer->append("\nEND\n");
+}
+
+void
+ResReaderWriter::writeToDirectory(
+    const std::vector< common::Structure *> & structures,
+    const fs::path & dir) const
+{
+  const utility::instrumentation::ScopedTimer timer(
+      "io.ResReaderWriter.writeStructures");
 
-  str.properties()[properties::io::LAST_ABS_FILE_PATH] = io::ResourceLocator(
-      io::absolute(filepath));
+  if(!dir.empty() && !exists(dir))
+    create_directories(dir);
 
-  if(strFile.is_open())
+  std::string buffer;
+  BOOST_FOREACH(common::Structure * const str, structures)
+  {
+    std::string name = str->getName();
+    if(name.empty())
+      name = utility::generateUniqueName();
+    const fs::path filepath = dir / (name + ".res");
+
+    buffer.clear();
+    writeStructure(&buffer, *str, name);
+
+    fs::ofstream strFile(filepath, std::ios_base::out | std::ios_base::binary);
+    if(!strFile.is_open())
+      continue;
+    strFile.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
     strFile.close();
+    // Only record where the structure is if it was actually written
+    if(strFile)
+      str->properties()[properties::io::LAST_ABS_FILE_PATH] =
+          io::ResourceLocator(io::absolute(filepath));
+  }
+}
+
+void
+ResReaderWriter::writeToStream(std::ostream & os,
+    const std::vector< const common::Structure *> & structures) const
+{
+  const utility::instrumentation::ScopedTimer timer(
+      "io.ResReaderWriter.writeStructures");
+
+  // Only write once the buffer is reasonably full
+  static const size_t FLUSH_SIZE = 1 << 20;
+
+  std::string buffer;
+  buffer.reserve(FLUSH_SIZE + (FLUSH_SIZE >> 2));
+  BOOST_FOREACH(const common::Structure * const str, structures)
+  {
+    writeStructure(&buffer, *str);
+    if(buffer.size() >= FLUSH_SIZE)
+    {
+      os.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  }
+  os.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
 }
 
 ssc::types::StructurePtr
 ResReaderWriter::readStructure(const ResourceLocator & resourceLocator) const
 {
-  namespace utility = spl::utility;
-  using spl::common::Atom;
-  using spl::common::AtomSpeciesId;
-  using std::getline;
-  using boost::bad_lexical_cast;
-  using boost::lexical_cast;
   using boost::filesystem::ifstream;
 
   const fs::path filepath = resourceLocator.path();
@@ -175,33 +256,47 @@ ResReaderWriter::readStructure(const ResourceLocator & resourceLocator) const
 
   if(strFile.is_open())
   {
-    str.reset(new common::Structure());
-
+    str = readStructure(strFile);
     str->properties()[properties::io::LAST_ABS_FILE_PATH] = io::ResourceLocator(
         io::absolute(filepath));
 
-    std::string line;
-    for(getline(strFile, line); strFile.good(); getline(strFile, line))
-    {
-      if(line.find("TITL") != std::string::npos && line.length() > 5)
-      {
-        InfoLine infoLine;
-        std::stringstream ss(line.substr(5));
-        ss >> infoLine;
-        infoLine.populate(str.get());
-      }
-      else if(line.find("CELL") != std::string::npos)
-        parseCell(*str, line);
-      else if(line.find("SFAC") != std::string::npos)
-        parseAtoms(*str, strFile, line);
-    } // end for
-
     strFile.close();
   }
 
   return str;
 }
 
+ssc::types::StructurePtr
+ResReaderWriter::readStructure(std::istream & is) const
+{
+  using std::getline;
+  const utility::instrumentation::ScopedTimer timer(
+      "io.ResReaderWriter.readStructure");
+
+  common::types::StructurePtr str(new common::Structure());
+
+  std::string line;
+  for(getline(is, line); is.good(); getline(is, line))
+  {
+    if(line.find("TITL") != std::string::npos && line.length() > 5)
+    {
+      InfoLine infoLine;
+      std::stringstream ss(line.substr(5));
+      ss >> infoLine;
+      infoLine.populate(str.get());
+    }
+    else if(line.find("CELL") != std::string::npos)
+      parseCell(*str, line);
+    else if(line.find("SFAC") != std::string::npos)
+    {
+      parseAtoms(*str, is, line);
+      break; // The atoms block is terminated by END
+    }
+  } // end for
+
+  return str;
+}
+
 size_t
 ResReaderWriter::readStructures(StructuresContainer & outStructures,
     const ResourceLocator & resourceLocator) const
@@ -0,0 +1,297 @@
+/*
+ * SplIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "spl/io/SplIndex.h"
+
+#include <iomanip>
+
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#  define SSLIB_OS_POSIX
+#endif
+
+#ifdef SSLIB_OS_POSIX
+extern "C"
+{
+#  include <sys/stat.h>
+}
+#endif
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/foreach.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+// NAMESPACES ////////////////////////////////
+
+namespace spl {
+namespace io {
+
+namespace fs = ::boost::filesystem;
+
+namespace {
+// Changed whenever the format changes so old indices are seen as stale
+static const ::std::string MAGIC = "spl-index-2";
+static const ::std::string STRUCTURES_KEY = "structures:";
+static const int STAMP_WIDTH = 20;
+static const int NANOSECONDS_WIDTH = 9;
+
+bool
+isStructuresKey(const ::std::string & line)
+{
+  return line.compare(0, STRUCTURES_KEY.size(), STRUCTURES_KEY) == 0
+      && line.find_first_not_of(" \t", STRUCTURES_KEY.size())
+          == ::std::string::npos;
+}
+}
+
+SplIndex::Range::Range() :
+    offset(0), length(0)
+{
+}
+
+SplIndex::Range::Range(const size_t offset_, const size_t length_) :
+    offset(offset_), length(length_)
+{
+}
+
+fs::path
+SplIndex::indexPath(const fs::path & filepath)
+{
+  return fs::path(filepath.string() + ".idx");
+}
+
+void
+SplIndex::remove(const fs::path & filepath)
+{
+  ::boost::system::error_code ec;
+  fs::remove(indexPath(filepath), ec);
+}
+
+SplIndex::FileStamp::FileStamp() :
+    size(0), modified(0), modifiedNanoseconds(0)
+{
+}
+
+bool
+SplIndex::FileStamp::operator ==(const FileStamp & rhs) const
+{
+  return size == rhs.size && modified == rhs.modified
+      && modifiedNanoseconds == rhs.modifiedNanoseconds;
+}
+
+SplIndex::SplIndex(const fs::path & filepath) :
+    myFilepath(filepath), myLoaded(false)
+{
+}
+
+bool
+SplIndex::loadIfFresh()
+{
+  myRanges.clear();
+  myLoaded = false;
+
+  if(!getFileStamp(&myStamp))
+    return false;
+
+  fs::ifstream is(indexPath(myFilepath));
+  if(!is.is_open())
+    return false;
+
+  ::std::string magic;
+  FileStamp indexed;
+  is >> magic >> indexed.size >> indexed.modified
+      >> indexed.modifiedNanoseconds;
+  if(!is || magic != MAGIC || !(indexed == myStamp))
+    return false;
+
+  Range range;
+  ::std::string id;
+  while(is >> range.offset >> range.length)
+  {
+    // The id is the rest of the line
+    is.get();
+    ::std::getline(is, id);
+    // Later lines are from appends so replace any earlier entry
+    myRanges[id] = range;
+  }
+  myLoaded = true;
+  return true;
+}
+
+const SplIndex::Range *
+SplIndex::find(const ::std::string & id) const
+{
+  const Ranges::const_iterator it = myRanges.find(id);
+  if(it == myRanges.end())
+    return NULL;
+  return &it->second;
+}
+
+void
+SplIndex::appended(const Entries & entries)
+{
+  if(!myLoaded)
+    return;
+
+  if(!getFileStamp(&myStamp))
+    return;
+
+  fs::fstream os(indexPath(myFilepath),
+      ::std::ios_base::in | ::std::ios_base::out | ::std::ios_base::binary);
+  if(!os.is_open())
+    return;
+
+  os.seekp(0, ::std::ios::end);
+  BOOST_FOREACH(Entries::const_reference entry, entries)
+  {
+    myRanges[entry.first] = entry.second;
+    os << entry.second.offset << " " << entry.second.length << " "
+        << entry.first << "\n";
+  }
+  // The header is fixed width so it can be updated in place
+  os.seekp(0, ::std::ios::beg);
+  writeHeader(os, myStamp);
+}
+
+bool
+SplIndex::build()
+{
+  myRanges.clear();
+  myLoaded = false;
+
+  // Stamp the file before reading it so that if it changes while being
+  // scanned the saved index will be seen as stale
+  if(!getFileStamp(&myStamp))
+    return false;
+
+  fs::ifstream is(myFilepath, ::std::ios_base::in | ::std::ios_base::binary);
+  if(!is.is_open())
+    return false;
+
+  const size_t fileSize = static_cast< size_t>(fs::file_size(myFilepath));
+  const size_t NONE = ::std::string::npos;
+
+  // Entries are the lines under the structures key with the same indentation
+  // as the first one and run until the next line that isn't indented further
+  bool inStructures = false;
+  size_t entryIndent = NONE;
+  ::std::string id;
+  size_t entryStart = NONE;
+  size_t pos = 0;
+  ::std::string line;
+  while(::std::getline(is, line))
+  {
+    const size_t lineStart = pos;
+    pos += line.size() + 1;
+    if(!line.empty() && line[line.size() - 1] == '\r')
+      line.erase(line.size() - 1);
+
+    const size_t indent = line.find_first_not_of(' ');
+    if(indent == NONE || line[indent] == '#')
+      continue;
+
+    if(entryStart != NONE && indent <= entryIndent)
+    {
+      // Replacing any earlier entry with the same id so that the last wins
+      myRanges[id] = Range(entryStart, lineStart - entryStart);
+      entryStart = NONE;
+    }
+
+    if(indent == 0)
+    {
+      inStructures = isStructuresKey(line);
+      entryIndent = NONE;
+      continue;
+    }
+    if(!inStructures)
+      continue;
+
+    if(entryIndent == NONE)
+      entryIndent = indent;
+    if(indent == entryIndent)
+    {
+      try
+      {
+        const YAML::Node key = YAML::Load(line);
+        if(!key.IsMap() || key.size() != 1)
+          return false;
+        id = key.begin()->first.as< ::std::string>();
+      }
+      catch(const YAML::Exception & /*e*/)
+      {
+        return false;
+      }
+      entryStart = lineStart;
+    }
+  }
+  if(entryStart != NONE)
+    myRanges[id] = Range(entryStart, fileSize - entryStart);
+
+  myLoaded = true;
+  return true;
+}
+
+bool
+SplIndex::save() const
+{
+  if(!myLoaded)
+    return false;
+
+  fs::ofstream os(indexPath(myFilepath),
+      ::std::ios_base::out | ::std::ios_base::trunc | ::std::ios_base::binary);
+  if(!os.is_open())
+    return false;
+
+  writeHeader(os, myStamp);
+  BOOST_FOREACH(Ranges::const_reference entry, myRanges)
+  {
+    os << entry.second.offset << " " << entry.second.length << " "
+        << entry.first << "\n";
+  }
+  return true;
+}
+
+bool
+SplIndex::getFileStamp(FileStamp * const stamp) const
+{
+#ifdef SSLIB_OS_POSIX
+  struct stat info;
+  if(::stat(myFilepath.string().c_str(), &info) != 0)
+    return false;
+  stamp->size = static_cast< size_t>(info.st_size);
+  stamp->modified = info.st_mtime;
+#  if defined (__APPLE__) && defined (__MACH__)
+  stamp->modifiedNanoseconds = info.st_mtimespec.tv_nsec;
+#  else
+  stamp->modifiedNanoseconds = info.st_mtim.tv_nsec;
+#  endif
+  return true;
+#else
+  // Only whole seconds are available here
+  ::boost::system::error_code ec;
+  stamp->size = static_cast< size_t>(fs::file_size(myFilepath, ec));
+  if(ec)
+    return false;
+  stamp->modified = fs::last_write_time(myFilepath, ec);
+  stamp->modifiedNanoseconds = 0;
+  return !ec;
+#endif
+}
+
+void
+SplIndex::writeHeader(::std::ostream & os, const FileStamp & stamp) const
+{
+  os << MAGIC << " " << ::std::setfill('0') << ::std::setw(STAMP_WIDTH)
+      << stamp.size << " " << ::std::setw(STAMP_WIDTH) << stamp.modified << " "
+      << ::std::setw(NANOSECONDS_WIDTH) << stamp.modifiedNanoseconds
+      << ::std::setfill(' ') << "\n";
+}
+
+}
+}
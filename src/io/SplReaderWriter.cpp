@@ -8,8 +8,10 @@
 // INCLUDES //////////////////////////////////
 #include "spl/io/SplReaderWriter.h"
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <set>
 #include <vector>
 
@@ -32,9 +34,11 @@
 #include "spl/common/UnitCell.h"
 #include "spl/io/IoFunctions.h"
 #include "spl/io/BoostFilesystem.h"
+#include "spl/io/SplIndex.h"
 #include "spl/io/StructureSchema.h"
 #include "spl/io/StructureYamlGenerator.h"
 #include "spl/utility/IndexingEnums.h"
+#include "spl/utility/Instrumentation.h"
 #include "spl/utility/UtilFunctions.h"
 
 // DEFINES /////////////////////////////////
@@ -57,57 +61,283 @@ static const std::string STRUCTURES = "structures";
 
 static const StructureSchema STRUCTURE_SCHEMA;
 
+namespace {
+
+enum AppendState
+{
+  NEW_FILE, APPENDABLE, NOT_APPENDABLE
+};
+
+// Check that the last top level key in the file is a block of structures by
+// reading backwards from the end, so the whole file doesn't have to be read
+AppendState
+getAppendState(const fs::path & filepath, bool * const needsNewline)
+{
+  *needsNewline = false;
+  if(!fs::exists(filepath))
+    return NEW_FILE;
+
+  fs::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
+  if(!file.is_open())
+    return NOT_APPENDABLE;
+
+  file.seekg(0, std::ios::end);
+  const std::streamoff fileSize = file.tellg();
+
+  std::string tail;
+  for(std::streamoff chunk = 4096; ; chunk *= 2)
+  {
+    const std::streamoff start = std::max(fileSize - chunk,
+        static_cast< std::streamoff>(0));
+    tail.resize(static_cast< size_t>(fileSize - start));
+    file.seekg(start, std::ios::beg);
+    file.read(&tail[0], static_cast< std::streamsize>(tail.size()));
+
+    // Find the last line that doesn't start with whitespace
+    for(size_t pos = tail.size(); pos > 0; --pos)
+    {
+      const bool lineStart = pos - 1 == 0 ? start == 0 : tail[pos - 2] == '\n';
+      const char c = tail[pos - 1];
+      if(!lineStart || c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        continue;
+
+      *needsNewline = tail[tail.size() - 1] != '\n';
+      const std::string line = tail.substr(pos - 1,
+          tail.find('\n', pos - 1) - (pos - 1));
+      const std::string key = kw::STRUCTURES + ":";
+      if(line.compare(0, key.size(), key) != 0
+          || line.find_first_not_of(" \t\r", key.size()) != std::string::npos)
+        return NOT_APPENDABLE;
+      return APPENDABLE;
+    }
+    if(start == 0)
+      return tail.find_first_not_of(" \t\r\n") == std::string::npos ?
+          NEW_FILE : NOT_APPENDABLE;
+  }
+}
+
+// Load all the documents in the file as one.  Appending adds documents and
+// an id can appear more than once, the last entry for an id wins.
+YAML::Node
+loadFile(const fs::path & filepath)
+{
+  const std::vector< YAML::Node> docs = YAML::LoadAllFromFile(
+      filepath.string());
+
+  YAML::Node merged;
+  BOOST_FOREACH(const YAML::Node & doc, docs)
+  {
+    if(!doc.IsMap())
+      continue;
+
+    for(YAML::const_iterator it = doc.begin(), end = doc.end(); it != end;
+        ++it)
+    {
+      const std::string key = it->first.as< std::string>();
+      if((key == kw::STRUCTURE || key == kw::STRUCTURES) && it->second.IsMap())
+      {
+        // Assigning to an existing id replaces the earlier entry
+        for(YAML::const_iterator strIt = it->second.begin(), strEnd =
+            it->second.end(); strIt != strEnd; ++strIt)
+          merged[key][strIt->first.as< std::string>()] = strIt->second;
+      }
+      else
+        merged[key] = it->second;
+    }
+  }
+  return merged;
+}
+
+// Rebuild the index of a file that has just been written and save it, if
+// that fails make sure there isn't an old one left behind
+void
+saveIndex(const fs::path & filepath)
+{
+  SplIndex index(filepath);
+  if(!index.build() || !index.save())
+    SplIndex::remove(filepath);
+}
+
+// Read just the entry for the given id using the file's index, if there
+// isn't an up to date one it is rebuilt, and saved if possible, as scanning
+// is still cheaper than parsing the whole file
+bool
+readIndexed(const fs::path & filepath, const std::string & id,
+    YAML::Node * const node)
+{
+  SplIndex index(filepath);
+  if(!index.loadIfFresh())
+  {
+    if(!index.build())
+      return false;
+    // Not being able to save (e.g. a read only directory) isn't an error
+    index.save();
+  }
+
+  const SplIndex::Range * const range = index.find(id);
+  if(!range)
+    return false;
+
+  fs::ifstream file(filepath, std::ios_base::in | std::ios_base::binary);
+  if(!file.is_open())
+    return false;
+
+  std::string fragment(range->length, '\0');
+  file.seekg(static_cast< std::streamoff>(range->offset), std::ios::beg);
+  if(!file.read(&fragment[0], static_cast< std::streamsize>(range->length)))
+    return false;
+
+  try
+  {
+    const YAML::Node entry = YAML::Load(fragment);
+    if(!entry.IsMap() || entry.size() != 1
+        || entry.begin()->first.as< std::string>() != id)
+      return false;
+    *node = entry.begin()->second;
+  }
+  catch(const YAML::Exception & /*e*/)
+  {
+    return false;
+  }
+  return true;
+}
+
+ResourceLocator
+uniqueLocator(const common::Structure & str, const ResourceLocator & locator)
+{
+  ResourceLocator uniqueLoc = locator;
+  if(uniqueLoc.id().empty())
+  {
+    std::string newId = str.getName();
+    if(newId.empty())
+    {
+      newId = utility::generateUniqueName();
+    }
+    uniqueLoc.setId(newId);
+  }
+  return uniqueLoc;
+}
+
+}
+
+SplReaderWriter::SplReaderWriter() :
+    myAppend(false)
+{
+}
+
+void
+SplReaderWriter::setAppend(const bool append)
+{
+  myAppend = append;
+}
+
+bool
+SplReaderWriter::getAppend() const
+{
+  return myAppend;
+}
+
 void
 SplReaderWriter::writeStructure(common::Structure & str,
     const ResourceLocator & locator) const
 {
+  write(Structures(1, &str), locator);
+}
+
+bool
+SplReaderWriter::compact(const ResourceLocator & locator) const
+{
+  const fs::path filepath(locator.path());
+  YAML::Node doc;
+  try
+  {
+    doc = loadFile(filepath);
+  }
+  catch(const YAML::Exception & /*e*/)
+  {
+    return false;
+  }
+  if(!doc.IsMap())
+    return false;
+
+  // Loading has already dropped the earlier entries.  Put the structures
+  // last so that the file can still be appended to.
+  YAML::Node compacted;
+  for(YAML::const_iterator it = doc.begin(), end = doc.end(); it != end; ++it)
+  {
+    const std::string key = it->first.as< std::string>();
+    if(key != kw::STRUCTURES)
+      compacted[key] = it->second;
+  }
+  if(doc[kw::STRUCTURES])
+    compacted[kw::STRUCTURES] = doc[kw::STRUCTURES];
+
+  fs::ofstream strFile(filepath, std::ios_base::out | std::ios_base::trunc);
+  if(!strFile.is_open())
+    return false;
+
+  YAML::Emitter out;
+  out << compacted;
+  strFile << out.c_str() << std::endl;
+  strFile.close();
+  saveIndex(filepath);
+  return true;
+}
+
+bool
+SplReaderWriter::updateIndex(const ResourceLocator & locator) const
+{
+  SplIndex index(locator.path());
+  if(index.loadIfFresh())
+    return true;
+  return index.build() && index.save();
+}
+
+void
+SplReaderWriter::write(const Structures & structures,
+    const ResourceLocator & locator) const
+{
+  const utility::instrumentation::ScopedTimer timer(
+      "io.SplReaderWriter.write");
+
   const fs::path filepath(locator.path());
   if(!filepath.has_filename())
     throw "Cannot write out structure without filepath";
 
-  const io::StructureYamlGenerator generator;
-
   const fs::path dir = filepath.parent_path();
   if(!dir.empty() && !exists(dir))
     create_directories(dir);
 
-  // First open and parse the file to get the current contents (if any)
+  if(myAppend && append(structures, locator))
+    return;
+
+  const io::StructureYamlGenerator generator;
+
+  // First parse the file to get the current contents (if any)
   YAML::Node doc;
-  fs::fstream strFile;
   if(fs::exists(filepath))
   {
-    strFile.open(filepath, std::ios_base::in | std::ios_base::out);
     try
     {
-      doc = YAML::Load(strFile);
+      doc = loadFile(filepath);
     }
     catch(const YAML::Exception & /*e*/)
     {
       // The file is dodgy, so happily overwrite it
     }
-    // Go back to the start of the file
-    strFile.clear(); // Clear the EoF flag
-    strFile.seekg(0, std::ios::beg);
-  }
-  else
-  {
-    strFile.open(filepath, std::ios_base::out);
   }
+  // The merged contents can be shorter than the file so truncate it
+  fs::ofstream strFile(filepath, std::ios_base::out | std::ios_base::trunc);
 
-  ResourceLocator uniqueLoc = locator;
-  if(uniqueLoc.id().empty())
+  std::vector< ResourceLocator> locators;
+  BOOST_FOREACH(common::Structure * const str, structures)
   {
-    std::string newId = str.getName();
-    if(newId.empty())
-    {
-      newId = utility::generateUniqueName();
-    }
-    uniqueLoc.setId(newId);
-  }
+    locators.push_back(uniqueLocator(*str, locator));
 
-  const Structure structureInfo = generator.generateInfo(str);
-  YAML::Node strNode = doc[kw::STRUCTURES][uniqueLoc.id()];
-  STRUCTURE_SCHEMA.valueToNode(structureInfo, &strNode);
+    const Structure structureInfo = generator.generateInfo(*str);
+    YAML::Node strNode = doc[kw::STRUCTURES][locators.back().id()];
+    STRUCTURE_SCHEMA.valueToNode(structureInfo, &strNode);
+  }
 
   if(strFile.is_open())
   {
@@ -115,22 +345,123 @@ SplReaderWriter::writeStructure(common::Structure & str,
     out << doc;
     strFile << out.c_str() << std::endl;
     strFile.close();
+    // Entries may have moved so the index has to be rebuilt
+    saveIndex(filepath);
+
+    for(size_t i = 0; i < structures.size(); ++i)
+      structures[i]->properties()[properties::io::LAST_ABS_FILE_PATH] =
+          locators[i];
+  }
+}
+
+bool
+SplReaderWriter::append(const Structures & structures,
+    const ResourceLocator & locator) const
+{
+  const fs::path filepath(locator.path());
+  bool needsNewline;
+  const AppendState state = getAppendState(filepath, &needsNewline);
+  if(state == NOT_APPENDABLE)
+    return false;
+
+  // Keep the index up to date if there is one, otherwise it is built once the
+  // structures have been written
+  SplIndex index(filepath);
+  const bool indexed = state == APPENDABLE && index.loadIfFresh();
+  size_t offset = state == APPENDABLE ?
+      static_cast< size_t>(fs::file_size(filepath)) : 0;
+
+  fs::ofstream strFile(filepath, std::ios_base::out | std::ios_base::app);
+  if(!strFile.is_open())
+    return false;
+
+  // Each append goes in a new document so that ids already in the file
+  // don't end up as duplicate keys in the same map
+  std::ostringstream header;
+  if(needsNewline)
+    header << "\n";
+  if(state == APPENDABLE)
+    header << "---\n";
+  header << kw::STRUCTURES << ":\n";
+  strFile << header.str();
+  offset += header.str().size();
+
+  const io::StructureYamlGenerator generator;
+  SplIndex::Entries entries;
+  std::set< std::string> documentIds;
+  std::string line;
+  BOOST_FOREACH(common::Structure * const str, structures)
+  {
+    const ResourceLocator uniqueLoc = uniqueLocator(*str, locator);
+    if(!documentIds.insert(uniqueLoc.id()).second)
+    {
+      // Same id twice in one go, start another document
+      const std::string newDocument = "---\n" + kw::STRUCTURES + ":\n";
+      strFile << newDocument;
+      offset += newDocument.size();
+      documentIds.clear();
+      documentIds.insert(uniqueLoc.id());
+    }
+
+    YAML::Node entry;
+    YAML::Node strNode = entry[uniqueLoc.id()];
+    STRUCTURE_SCHEMA.valueToNode(generator.generateInfo(*str), &strNode);
+
+    YAML::Emitter out;
+    out << entry;
 
-    str.properties()[properties::io::LAST_ABS_FILE_PATH] = uniqueLoc;
+    // Indent the entry so that it goes under the structures key
+    std::ostringstream fragment;
+    std::istringstream lines(out.c_str());
+    while(std::getline(lines, line))
+      fragment << "  " << line << "\n";
+    strFile << fragment.str();
+
+    entries.push_back(
+        std::make_pair(uniqueLoc.id(),
+            SplIndex::Range(offset, fragment.str().size())));
+    offset += fragment.str().size();
+
+    str->properties()[properties::io::LAST_ABS_FILE_PATH] = uniqueLoc;
   }
+  strFile.close();
+
+  if(indexed)
+    index.appended(entries);
+  else
+    saveIndex(filepath);
+  return true;
 }
 
 common::types::StructurePtr
 SplReaderWriter::readStructure(const ResourceLocator & locator) const
 {
+  const utility::instrumentation::ScopedTimer timer(
+      "io.SplReaderWriter.readStructure");
   common::types::StructurePtr structure;
   const io::StructureYamlGenerator generator;
 
   const fs::path filepath(locator.path());
+
+  // If we know the id try to parse just that structure
+  YAML::Node strNode;
+  if(!locator.id().empty() && readIndexed(filepath, locator.id(), &strNode))
+  {
+    Structure structureInfo;
+    if(STRUCTURE_SCHEMA.nodeToValue(strNode, &structureInfo))
+      structure = generator.generateStructure(structureInfo);
+    if(structure.get())
+    {
+      structure->properties()[properties::io::LAST_ABS_FILE_PATH] =
+          ResourceLocator(io::absolute(filepath), locator.id());
+      return structure;
+    }
+  }
+
   YAML::Node doc;
   try
   {
-    doc = YAML::LoadFile(filepath.string());
+    doc = loadFile(filepath);
   }
   catch(const YAML::Exception & /*e*/)
   {
@@ -180,6 +511,8 @@ size_t
 SplReaderWriter::readStructures(StructuresContainer & outStructures,
     const ResourceLocator & locator) const
 {
+  const utility::instrumentation::ScopedTimer timer(
+      "io.SplReaderWriter.readStructures");
   size_t numLoaded = 0;
   if(locator.id().empty())
   {
@@ -189,7 +522,7 @@ SplReaderWriter::readStructures(StructuresContainer & outStructures,
     YAML::Node doc;
     try
     {
-      doc = YAML::LoadFile(filepath.string());
+      doc = loadFile(filepath);
     }
     catch(const YAML::Exception & /*e*/)
     {
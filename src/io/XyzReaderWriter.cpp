@@ -10,6 +10,7 @@
 
 #include <iomanip>
 #include <set>
+#include <sstream>
 #include <vector>
 
 #include <boost/foreach.hpp>
@@ -30,6 +31,8 @@
 #include "spl/io/IoFunctions.h"
 #include "spl/io/BoostFilesystem.h"
 #include "spl/utility/IndexingEnums.h"
+#include "spl/utility/Instrumentation.h"
+#include "spl/utility/UtilFunctions.h"
 
 // DEFINES /////////////////////////////////
 
@@ -53,10 +56,6 @@ void
 XyzReaderWriter::writeStructure(spl::common::Structure & str,
     const ResourceLocator & locator) const
 {
-  using namespace utility::cell_params_enum;
-  using namespace utility::cart_coords_enum;
-  using spl::common::AtomSpeciesId;
-
   const fs::path filepath(locator.path());
   if(!filepath.has_filename())
     throw "Cannot write out structure without filepath";
@@ -65,18 +64,40 @@ XyzReaderWriter::writeStructure(spl::common::Structure & str,
   if(!dir.empty() && !exists(dir))
     create_directories(dir);
 
+  std::string buffer;
+  writeStructure(&buffer, str, filepath.string());
+
   fs::ofstream strFile;
   strFile.open(filepath);
+  strFile.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
+
+  str.properties()[properties::io::LAST_ABS_FILE_PATH] = io::ResourceLocator(
+      io::absolute(filepath));
+
+  if(strFile.is_open())
+    strFile.close();
+}
+
+void
+XyzReaderWriter::writeStructure(std::string * const buffer,
+    const common::Structure & str, const std::string & defaultName) const
+{
+  using namespace utility::cart_coords_enum;
+
+  static const int PRECISION = 12;
 
   // Number of atoms
-  strFile << str.getNumAtoms() << "\n";
+  appendUnsigned(buffer, str.getNumAtoms());
+  buffer->push_back('\n');
 
   //////////////////////////
   // Start Title
   InfoLine infoLine(str);
-  if(!infoLine.name || infoLine.name->empty())
-    infoLine.name = filepath.string();
-  strFile << infoLine << "\n";
+  if((!infoLine.name || infoLine.name->empty()) && !defaultName.empty())
+    infoLine.name = defaultName;
+  std::ostringstream title;
+  title << infoLine << "\n";
+  buffer->append(title.str());
   // End title //////////////////
 
   ////////////////////////////
@@ -89,24 +110,82 @@ XyzReaderWriter::writeStructure(spl::common::Structure & str,
     const arma::vec3 & pos = atom.getPosition();
 
     if(!atom.getSpecies().empty())
-      strFile << atom.getSpecies() << " ";
+      buffer->append(atom.getSpecies());
     else
-      strFile << "DU ";
-    strFile << std::setprecision(12) << pos(X) << " " << pos(Y) << " " << pos(Z)
-        << "\n";
+      buffer->append("DU");
+    for(size_t j = X; j <= Z; ++j)
+    {
+      buffer->push_back(' ');
+      appendGeneral(buffer, pos(j), PRECISION);
+    }
+    buffer->push_back('\n');
   }
   // End atoms ///////////
+}
 
-  str.properties()[properties::io::LAST_ABS_FILE_PATH] = io::ResourceLocator(
-      io::absolute(filepath));
+void
+XyzReaderWriter::writeToDirectory(
+    const std::vector< common::Structure *> & structures,
+    const fs::path & dir) const
+{
+  const utility::instrumentation::ScopedTimer timer(
+      "io.XyzReaderWriter.writeStructures");
 
-  if(strFile.is_open())
+  if(!dir.empty() && !exists(dir))
+    create_directories(dir);
+
+  std::string buffer;
+  BOOST_FOREACH(common::Structure * const str, structures)
+  {
+    std::string name = str->getName();
+    if(name.empty())
+      name = utility::generateUniqueName();
+    const fs::path filepath = dir / (name + ".xyz");
+
+    buffer.clear();
+    writeStructure(&buffer, *str, name);
+
+    fs::ofstream strFile(filepath, std::ios_base::out | std::ios_base::binary);
+    if(!strFile.is_open())
+      continue;
+    strFile.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
     strFile.close();
+    // Only record where the structure is if it was actually written
+    if(strFile)
+      str->properties()[properties::io::LAST_ABS_FILE_PATH] =
+          io::ResourceLocator(io::absolute(filepath));
+  }
+}
+
+void
+XyzReaderWriter::writeToStream(std::ostream & os,
+    const std::vector< const common::Structure *> & structures) const
+{
+  const utility::instrumentation::ScopedTimer timer(
+      "io.XyzReaderWriter.writeStructures");
+
+  // Only write once the buffer is reasonably full
+  static const size_t FLUSH_SIZE = 1 << 20;
+
+  std::string buffer;
+  buffer.reserve(FLUSH_SIZE + (FLUSH_SIZE >> 2));
+  BOOST_FOREACH(const common::Structure * const str, structures)
+  {
+    writeStructure(&buffer, *str);
+    if(buffer.size() >= FLUSH_SIZE)
+    {
+      os.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  }
+  os.write(buffer.data(), static_cast< std::streamsize>(buffer.size()));
 }
 
 common::types::StructurePtr
 XyzReaderWriter::readStructure(const ResourceLocator & resourceLocator) const
 {
+  const utility::instrumentation::ScopedTimer timer(
+      "io.XyzReaderWriter.readStructure");
   common::types::StructurePtr str;
   if(resourceLocator.empty() || !fs::exists(resourceLocator.path()))
     return str;
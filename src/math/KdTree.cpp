@@ -0,0 +1,227 @@
+/*
+ * KdTree.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+#include "spl/math/KdTree.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "spl/SSLibAssert.h"
+
+namespace spl {
+namespace math {
+
+const size_t KdTree::MAX_LEAF_SIZE = 8;
+
+class KdTree::CompareAxis : public std::binary_function< size_t, size_t, bool>
+{
+public:
+  CompareAxis(const arma::mat & points, const unsigned int axis) :
+      myPoints(points), myAxis(axis)
+  {
+  }
+  bool
+  operator()(const size_t i, const size_t j) const
+  {
+    return myPoints(myAxis, i) < myPoints(myAxis, j);
+  }
+private:
+  const arma::mat & myPoints;
+  const unsigned int myAxis;
+};
+
+KdTree::KdTree()
+{
+}
+
+void
+KdTree::build(const arma::mat & points)
+{
+  SSLIB_ASSERT(points.n_rows == 3);
+
+  clear();
+  if(points.n_cols == 0)
+    return;
+
+  myPoints = points;
+  myIndices.resize(points.n_cols);
+  for(size_t i = 0; i < myIndices.size(); ++i)
+    myIndices[i] = i;
+
+  // A balanced tree has about 2N / MAX_LEAF_SIZE nodes
+  myNodes.reserve(2 * (myIndices.size() / MAX_LEAF_SIZE + 1));
+  buildNode(0, myIndices.size());
+}
+
+void
+KdTree::clear()
+{
+  myPoints.reset();
+  myIndices.clear();
+  myNodes.clear();
+}
+
+size_t
+KdTree::size() const
+{
+  return myIndices.size();
+}
+
+bool
+KdTree::empty() const
+{
+  return myIndices.empty();
+}
+
+size_t
+KdTree::radiusQuery(const arma::vec3 & point, const double radius,
+    std::vector< size_t> * const indices) const
+{
+  const size_t sizeBefore = indices->size();
+  if(!empty() && radius >= 0.0)
+    radiusQuery(0, point.memptr(), radius * radius, indices);
+  return indices->size() - sizeBefore;
+}
+
+size_t
+KdTree::nearestQuery(const arma::vec3 & point, const size_t k,
+    std::vector< size_t> * const indices,
+    std::vector< double> * const distsSq) const
+{
+  if(empty() || k == 0)
+    return 0;
+
+  std::vector< DistIndex> heap;
+  heap.reserve(k);
+  nearestQuery(0, point.memptr(), k, &heap);
+  std::sort_heap(heap.begin(), heap.end());
+
+  for(size_t i = 0; i < heap.size(); ++i)
+  {
+    indices->push_back(heap[i].second);
+    if(distsSq)
+      distsSq->push_back(heap[i].first);
+  }
+  return heap.size();
+}
+
+size_t
+KdTree::buildNode(const size_t begin, const size_t end)
+{
+  const size_t nodeIdx = myNodes.size();
+  myNodes.push_back(Node());
+  {
+    Node & node = myNodes.back();
+    node.begin = begin;
+    node.end = end;
+    node.left = node.right = 0;
+    node.axis = 0;
+    node.split = 0.0;
+  }
+  if(end - begin <= MAX_LEAF_SIZE)
+    return nodeIdx;
+
+  // Split along the axis with the largest spread
+  arma::vec3 lower, upper;
+  lower = upper = myPoints.col(myIndices[begin]);
+  for(size_t i = begin + 1; i < end; ++i)
+  {
+    for(unsigned int d = 0; d < 3; ++d)
+    {
+      const double x = myPoints(d, myIndices[i]);
+      lower(d) = std::min(lower(d), x);
+      upper(d) = std::max(upper(d), x);
+    }
+  }
+  const arma::vec3 spread = upper - lower;
+  unsigned int axis = 0;
+  if(spread(1) > spread(axis))
+    axis = 1;
+  if(spread(2) > spread(axis))
+    axis = 2;
+
+  const size_t mid = begin + (end - begin) / 2;
+  std::nth_element(myIndices.begin() + begin, myIndices.begin() + mid,
+      myIndices.begin() + end, CompareAxis(myPoints, axis));
+
+  // Careful: building the children may reallocate myNodes
+  const size_t left = buildNode(begin, mid);
+  const size_t right = buildNode(mid, end);
+  Node & node = myNodes[nodeIdx];
+  node.axis = axis;
+  node.split = myPoints(axis, myIndices[mid]);
+  node.left = left;
+  node.right = right;
+
+  return nodeIdx;
+}
+
+void
+KdTree::radiusQuery(const size_t nodeIdx, const double * const point,
+    const double radiusSq, std::vector< size_t> * const indices) const
+{
+  const Node & node = myNodes[nodeIdx];
+  if(node.left == 0)
+  {
+    for(size_t i = node.begin; i < node.end; ++i)
+    {
+      if(distSq(myIndices[i], point) <= radiusSq)
+        indices->push_back(myIndices[i]);
+    }
+    return;
+  }
+
+  const double diff = point[node.axis] - node.split;
+  radiusQuery(diff < 0.0 ? node.left : node.right, point, radiusSq, indices);
+  if(diff * diff <= radiusSq)
+    radiusQuery(diff < 0.0 ? node.right : node.left, point, radiusSq,
+        indices);
+}
+
+void
+KdTree::nearestQuery(const size_t nodeIdx, const double * const point,
+    const size_t k, std::vector< DistIndex> * const heap) const
+{
+  const Node & node = myNodes[nodeIdx];
+  if(node.left == 0)
+  {
+    for(size_t i = node.begin; i < node.end; ++i)
+    {
+      const DistIndex candidate(distSq(myIndices[i], point), myIndices[i]);
+      if(heap->size() < k)
+      {
+        heap->push_back(candidate);
+        std::push_heap(heap->begin(), heap->end());
+      }
+      else if(candidate < heap->front())
+      {
+        std::pop_heap(heap->begin(), heap->end());
+        heap->back() = candidate;
+        std::push_heap(heap->begin(), heap->end());
+      }
+    }
+    return;
+  }
+
+  const double diff = point[node.axis] - node.split;
+  nearestQuery(diff < 0.0 ? node.left : node.right, point, k, heap);
+  if(heap->size() < k || diff * diff <= heap->front().first)
+    nearestQuery(diff < 0.0 ? node.right : node.left, point, k, heap);
+}
+
+double
+KdTree::distSq(const size_t idx, const double * const point) const
+{
+  const double * const p = myPoints.colptr(idx);
+  const double dx = p[0] - point[0];
+  const double dy = p[1] - point[1];
+  const double dz = p[2] - point[2];
+  return dx * dx + dy * dy + dz * dz;
+}
+
+}
+}
@@ -8,14 +8,136 @@
 // INCLUDES //////////////////////////////////
 #include "spl/math/Random.h"
 
+#include <cstdlib>
+
+#include "spl/SSLib.h"
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <set>
+
+#  include <boost/thread/locks.hpp>
+#  include <boost/thread/mutex.hpp>
+#  include <boost/thread/tss.hpp>
+#endif
+
 // NAMESPACES ////////////////////////////////
 
 namespace spl {
 namespace math {
 namespace detail {
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+
+namespace {
+
+// The seed mt19937 uses when default constructed
+const unsigned int DEFAULT_SEED = 5489u;
+
+struct ThreadGenerator
+{
+  boost::mt19937 generator;
+  // The order in which threads first asked for a generator
+  unsigned int index;
+};
+
+// Derive the seed of a thread's generator from the global one.  The first
+// thread gets the global seed itself so single threaded callers see the same
+// stream as they would with one shared generator.
+unsigned int
+threadSeed(const unsigned int globalSeed, const unsigned int index)
+{
+  if(index == 0)
+    return globalSeed;
+
+  // Mix (a 32 bit finaliser) so that neighbouring indices give unrelated seeds
+  unsigned int h = globalSeed ^ (index * 0x9e3779b9u);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+// All the live thread generators so that seed() can reach them
+boost::mutex registryMutex;
+std::set< ThreadGenerator *> registry;
+unsigned int globalSeed = DEFAULT_SEED;
+unsigned int nextIndex = 0;
+
+void
+releaseGenerator(ThreadGenerator * const gen)
+{
+  {
+    boost::lock_guard< boost::mutex> guard(registryMutex);
+    registry.erase(gen);
+  }
+  delete gen;
+}
+
+boost::thread_specific_ptr< ThreadGenerator> threadGenerator(
+    &releaseGenerator);
+
+ThreadGenerator &
+threadState()
+{
+  ThreadGenerator * gen = threadGenerator.get();
+  if(!gen)
+  {
+    gen = new ThreadGenerator();
+    {
+      boost::lock_guard< boost::mutex> guard(registryMutex);
+      gen->index = nextIndex++;
+      gen->generator.seed(threadSeed(globalSeed, gen->index));
+      registry.insert(gen);
+    }
+    threadGenerator.reset(gen);
+  }
+  return *gen;
+}
+
+}
+
+boost::mt19937 &
+generator()
+{
+  return threadState().generator;
+}
+
+#else
+
 boost::mt19937 mt19937;
 
+boost::mt19937 &
+generator()
+{
+  return mt19937;
 }
+
+#endif
+
+} // namespace detail
+
+void
+seed(const unsigned int randSeed)
+{
+  std::srand(randSeed);
+#ifdef SPL_ENABLE_THREAD_AWARE
+  boost::lock_guard< boost::mutex> guard(detail::registryMutex);
+  detail::globalSeed = randSeed;
+  for(std::set< detail::ThreadGenerator *>::iterator it =
+      detail::registry.begin(), end = detail::registry.end(); it != end; ++it)
+    (*it)->generator.seed(detail::threadSeed(randSeed, (*it)->index));
+#else
+  detail::generator().seed(randSeed);
+#endif
 }
+
+void
+seedThread(const unsigned int randSeed)
+{
+  detail::generator().seed(randSeed);
 }
 
+}
+}
@@ -7,27 +7,133 @@
 
 #include "spl/math/RunningStats.h"
 
+#include <algorithm>
 #include <limits>
 #include <cmath>
 
 namespace spl {
 namespace math {
 
-RunningStats::RunningStats():
-myNum(0),
-mySum(0.0),
-mySqSum(0.0),
-myMin(::std::numeric_limits<double>::max()),
-myMax(-::std::numeric_limits<double>::max())
-{}
+namespace {
+// Number of independent accumulators used by the bulk insert
+static const size_t LANES = 4;
+}
+
+RunningStats::RunningStats()
+{
+  clear();
+}
 
 void RunningStats::insert(const double x)
 {
+  if(myNum == 0)
+    myShift = x;
+
   ++myNum;
   mySum += x;
   mySqSum += x * x;
   myMin = ::std::min(myMin, x);
   myMax = ::std::max(myMax, x);
+
+  const double dev = x - myShift;
+  myShiftedSum += dev;
+  myShiftedSqSum += dev * dev;
+}
+
+void RunningStats::insert(const double * const values, const size_t n)
+{
+  if(n == 0)
+    return;
+
+  // Gather the block on its own.  Each lane keeps independent partial results
+  // so the loops can be vectorised without reassociating the additions, and
+  // a second pass over the (cached) values gives an accurate M2.
+  double sum[LANES], sqSum[LANES], min[LANES], max[LANES], m2[LANES];
+  for(size_t l = 0; l < LANES; ++l)
+  {
+    sum[l] = sqSum[l] = m2[l] = 0.0;
+    min[l] = max[l] = values[0];
+  }
+
+  const size_t numBlocked = n - n % LANES;
+  for(size_t i = 0; i < numBlocked; i += LANES)
+  {
+    for(size_t l = 0; l < LANES; ++l)
+    {
+      const double x = values[i + l];
+      sum[l] += x;
+      sqSum[l] += x * x;
+      min[l] = x < min[l] ? x : min[l];
+      max[l] = x > max[l] ? x : max[l];
+    }
+  }
+  for(size_t i = numBlocked; i < n; ++i)
+  {
+    sum[0] += values[i];
+    sqSum[0] += values[i] * values[i];
+    min[0] = ::std::min(min[0], values[i]);
+    max[0] = ::std::max(max[0], values[i]);
+  }
+
+  RunningStats block;
+  block.myNum = static_cast<unsigned int>(n);
+  block.mySum = sum[0];
+  block.mySqSum = sqSum[0];
+  block.myMin = min[0];
+  block.myMax = max[0];
+  for(size_t l = 1; l < LANES; ++l)
+  {
+    block.mySum += sum[l];
+    block.mySqSum += sqSum[l];
+    block.myMin = ::std::min(block.myMin, min[l]);
+    block.myMax = ::std::max(block.myMax, max[l]);
+  }
+  // Shift by the mean so the shifted sum is zero
+  block.myShift = block.mySum / static_cast<double>(n);
+
+  for(size_t i = 0; i < numBlocked; i += LANES)
+  {
+    for(size_t l = 0; l < LANES; ++l)
+    {
+      const double dev = values[i + l] - block.myShift;
+      m2[l] += dev * dev;
+    }
+  }
+  for(size_t i = numBlocked; i < n; ++i)
+    m2[0] += (values[i] - block.myShift) * (values[i] - block.myShift);
+  for(size_t l = 0; l < LANES; ++l)
+    block.myShiftedSqSum += m2[l];
+
+  merge(block);
+}
+
+void RunningStats::merge(const RunningStats & other)
+{
+  if(other.myNum == 0)
+    return;
+  if(myNum == 0)
+  {
+    *this = other;
+    return;
+  }
+
+  // Chan et al.'s pairwise combination of the squared deviations
+  const double n1 = static_cast<double>(myNum);
+  const double n2 = static_cast<double>(other.myNum);
+  const double mean1 = myShift + myShiftedSum / n1;
+  const double mean2 = other.myShift + other.myShiftedSum / n2;
+  const double delta = mean2 - mean1;
+  const double m2Total = m2() + other.m2() + delta * delta * n1 * n2 / (n1 + n2);
+  // and carry on from the combined mean
+  myShift = mean1 + delta * n2 / (n1 + n2);
+  myShiftedSum = 0.0;
+  myShiftedSqSum = m2Total;
+
+  myNum += other.myNum;
+  mySum += other.mySum;
+  mySqSum += other.mySqSum;
+  myMin = ::std::min(myMin, other.myMin);
+  myMax = ::std::max(myMax, other.myMax);
 }
 
 unsigned int RunningStats::num() const
@@ -65,5 +171,39 @@ double RunningStats::rms() const
   return ::std::sqrt(mySqSum / static_cast<double>(myNum));
 }
 
+double RunningStats::variance() const
+{
+  if(myNum == 0)
+    return 0.0;
+  return m2() / static_cast<double>(myNum);
+}
+
+double RunningStats::stdDev() const
+{
+  return ::std::sqrt(variance());
+}
+
+void RunningStats::clear()
+{
+  myNum = 0;
+  mySum = 0.0;
+  mySqSum = 0.0;
+  myMin = ::std::numeric_limits<double>::max();
+  myMax = -::std::numeric_limits<double>::max();
+  myShift = 0.0;
+  myShiftedSum = 0.0;
+  myShiftedSqSum = 0.0;
+}
+
+double RunningStats::m2() const
+{
+  if(myNum == 0)
+    return 0.0;
+  // Rounding can make this slightly negative when the spread is zero
+  return ::std::max(
+      myShiftedSqSum - myShiftedSum * myShiftedSum / static_cast<double>(myNum),
+      0.0);
+}
+
 }
 }
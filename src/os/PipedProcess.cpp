@@ -0,0 +1,269 @@
+/*
+ * PipedProcess.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "spl/os/PipedProcess.h"
+
+#include <boost/noncopyable.hpp>
+#include <boost/smart_ptr/scoped_array.hpp>
+
+#if defined (__unix__) || (defined (__APPLE__) && defined (__MACH__))
+#  define SSLIB_OS_POSIX
+#endif
+
+#ifdef SSLIB_OS_POSIX
+extern "C"
+{
+#  include <errno.h>
+#  include <pthread.h>
+#  include <signal.h>
+#  include <sys/wait.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+}
+#endif
+
+// NAMESPACES ////////////////////////////////
+
+namespace spl {
+namespace os {
+
+#ifdef SSLIB_OS_POSIX
+namespace {
+
+// Blocks SIGPIPE for the calling thread only, any SIGPIPE raised while
+// blocked is consumed before the mask is restored.  This leaves the process
+// wide disposition alone so other threads are unaffected.
+class ScopedSigpipeBlock : ::boost::noncopyable
+{
+public:
+  ScopedSigpipeBlock()
+  {
+    sigemptyset(&mySigpipe);
+    sigaddset(&mySigpipe, SIGPIPE);
+
+    sigset_t pending;
+    sigemptyset(&pending);
+    sigpending(&pending);
+    myWasPending = sigismember(&pending, SIGPIPE) == 1;
+
+    pthread_sigmask(SIG_BLOCK, &mySigpipe, &myOldMask);
+  }
+
+  ~ScopedSigpipeBlock()
+  {
+    // Only consume a SIGPIPE that we caused
+    if(!myWasPending)
+    {
+      sigset_t pending;
+      sigemptyset(&pending);
+      sigpending(&pending);
+      if(sigismember(&pending, SIGPIPE) == 1)
+      {
+        int sig;
+        sigwait(&mySigpipe, &sig);
+      }
+    }
+    pthread_sigmask(SIG_SETMASK, &myOldMask, NULL);
+  }
+
+private:
+  sigset_t mySigpipe;
+  sigset_t myOldMask;
+  bool myWasPending;
+};
+
+}
+#endif
+
+PipedProcess::PipedProcess() :
+    myPid(-1), myToChild(-1), myFromChild(-1)
+{
+}
+
+PipedProcess::~PipedProcess()
+{
+  stop();
+}
+
+bool
+PipedProcess::start(const ::std::vector< ::std::string> & exeAndArgv)
+{
+  if(exeAndArgv.empty() || isRunning())
+    return false;
+
+#ifdef SSLIB_OS_POSIX
+  ::boost::scoped_array< const char *> argvArray(
+      new const char *[exeAndArgv.size() + 1]);
+  for(size_t i = 0; i < exeAndArgv.size(); ++i)
+    argvArray[i] = exeAndArgv[i].c_str();
+  argvArray[exeAndArgv.size()] = 0;
+
+  int toChild[2], fromChild[2];
+  if(pipe(toChild) != 0)
+    return false;
+  if(pipe(fromChild) != 0)
+  {
+    close(toChild[0]);
+    close(toChild[1]);
+    return false;
+  }
+
+  const pid_t child = fork();
+  if(child < 0)
+  { // Failed to fork
+    close(toChild[0]);
+    close(toChild[1]);
+    close(fromChild[0]);
+    close(fromChild[1]);
+    return false;
+  }
+  if(child == 0)
+  { // We are the child, hook the pipes up to stdin and stdout
+    dup2(toChild[0], STDIN_FILENO);
+    dup2(fromChild[1], STDOUT_FILENO);
+    close(toChild[0]);
+    close(toChild[1]);
+    close(fromChild[0]);
+    close(fromChild[1]);
+    execvp(exeAndArgv[0].c_str(), const_cast< char **>(argvArray.get()));
+    _exit(127);
+  }
+
+  // We are the parent
+  close(toChild[0]);
+  close(fromChild[1]);
+  myPid = child;
+  myToChild = toChild[1];
+  myFromChild = fromChild[0];
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+PipedProcess::isRunning() const
+{
+  return myPid > 0;
+}
+
+int
+PipedProcess::stop()
+{
+  if(!isRunning())
+    return -1;
+
+  closePipes();
+
+  int exitCode = -1;
+#ifdef SSLIB_OS_POSIX
+  int childExitStatus;
+  if(waitpid(myPid, &childExitStatus, 0) == myPid
+      && WIFEXITED(childExitStatus))
+    exitCode = WEXITSTATUS(childExitStatus);
+#endif
+  myPid = -1;
+  return exitCode;
+}
+
+bool
+PipedProcess::write(const ::std::string & data)
+{
+  if(myToChild < 0)
+    return false;
+
+#ifdef SSLIB_OS_POSIX
+  // If the child has died we want a failed write, not to be killed by SIGPIPE
+  const ScopedSigpipeBlock blockSigpipe;
+
+  const char * buffer = data.data();
+  size_t remaining = data.size();
+  while(remaining > 0)
+  {
+    const ssize_t written = ::write(myToChild, buffer, remaining);
+    if(written < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      break;
+    }
+    buffer += written;
+    remaining -= written;
+  }
+
+  return remaining == 0;
+#else
+  return false;
+#endif
+}
+
+bool
+PipedProcess::read(::std::string * const data, const size_t numBytes)
+{
+  if(myFromChild < 0)
+    return false;
+
+#ifdef SSLIB_OS_POSIX
+  data->resize(numBytes);
+  size_t numRead = 0;
+  while(numRead < numBytes)
+  {
+    const ssize_t got = ::read(myFromChild, &(*data)[numRead],
+        numBytes - numRead);
+    if(got < 0 && errno == EINTR)
+      continue;
+    if(got <= 0)
+      return false; // Error or EOF before we got everything
+    numRead += got;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool
+PipedProcess::readLine(::std::string * const line)
+{
+  if(myFromChild < 0)
+    return false;
+
+#ifdef SSLIB_OS_POSIX
+  line->clear();
+  char c;
+  while(true)
+  {
+    const ssize_t got = ::read(myFromChild, &c, 1);
+    if(got < 0 && errno == EINTR)
+      continue;
+    if(got <= 0)
+      return false;
+    if(c == '\n')
+      return true;
+    line->push_back(c);
+  }
+#else
+  return false;
+#endif
+}
+
+void
+PipedProcess::closePipes()
+{
+#ifdef SSLIB_OS_POSIX
+  if(myToChild >= 0)
+    close(myToChild);
+  if(myFromChild >= 0)
+    close(myFromChild);
+#endif
+  myToChild = -1;
+  myFromChild = -1;
+}
+
+}
+}
@@ -11,12 +11,19 @@
 #ifdef SPL_USE_YAML
 
 #include <fstream>
+#include <sstream>
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <boost/thread/locks.hpp>
+#endif
+#include <boost/lexical_cast.hpp>
 
 #include <yaml-cpp/yaml.h>
 
 #include <schemer/Schemer.h>
 
 #include <spl/io/BoostFilesystem.h>
+#include <spl/os/PipedProcess.h>
 #include <spl/os/Process.h>
 #include <spl/potential/OptimisationSettings.h>
 #include <spl/utility/UtilFunctions.h>
@@ -73,8 +80,9 @@ SCHEMER_MAP(OptResultsType, OptResults)
   element("finalPressure", &OptResults::finalPressure);
 }
 
-ExternalOptimiser::ExternalOptimiser(const std::string & runCommand) :
-    myRunCommand(runCommand), myResReaderWriter()
+ExternalOptimiser::ExternalOptimiser(const std::string & runCommand,
+    const bool persistent) :
+    myRunCommand(runCommand), myPersistent(persistent), myResReaderWriter()
 {
 }
 
@@ -90,6 +98,9 @@ OptimisationOutcome
 ExternalOptimiser::optimise(common::Structure & structure,
     OptimisationData & data, const OptimisationSettings & options) const
 {
+  if(myPersistent)
+    return optimiseInWorker(structure, data, options);
+
   const std::string outputStem = (
       structure.getName().empty() ?
           utility::generateUniqueName(6) : structure.getName()) + "_opt";
@@ -114,10 +125,7 @@ ExternalOptimiser::optimise(common::Structure & structure,
   if(!readResults(settingsFile.get().string(), &results) || !results.successful)
     return OptimisationOutcome::failure(OptimisationError::INTERNAL_ERROR);
 
-  data.internalEnergy = results.finalInternalEnergy;
-  data.enthalpy = results.finalEnthalpy;
-  data.numIters = results.finalIters;
-  data.pressure = results.finalPressure;
+  copyResults(results, &data);
 
   // Copy over the new structure
   common::StructurePtr newStructure = myResReaderWriter.readStructure(
@@ -128,6 +136,65 @@ ExternalOptimiser::optimise(common::Structure & structure,
   return OptimisationOutcome::success();
 }
 
+bool
+ExternalOptimiser::isPersistent() const
+{
+  return myPersistent;
+}
+
+OptimisationOutcome
+ExternalOptimiser::optimiseInWorker(common::Structure & structure,
+    OptimisationData & data, const OptimisationSettings & options) const
+{
+#ifdef SPL_ENABLE_THREAD_AWARE
+  boost::lock_guard< boost::mutex> guard(myWorkerMutex);
+#endif
+
+  if(!myWorker.isRunning())
+  {
+    std::vector< std::string> exeAndArgs;
+    os::parseParameters(exeAndArgs, myRunCommand);
+    if(!myWorker.start(exeAndArgs))
+      return OptimisationOutcome::failure(OptimisationError::INTERNAL_ERROR);
+  }
+
+  std::ostringstream settingsStream, strStream;
+  writeSettings(settingsStream, options);
+  myResReaderWriter.writeStructure(strStream, structure, structure.getName());
+
+  std::string resultsFrame, strFrame;
+  if(!writeFrame(settingsStream.str()) || !writeFrame(strStream.str())
+      || !readFrame(&resultsFrame) || !readFrame(&strFrame))
+  {
+    // The worker has died or is out of sync so get rid of it, the next
+    // optimisation will start a fresh one
+    myWorker.stop();
+    return OptimisationOutcome::failure(OptimisationError::INTERNAL_ERROR);
+  }
+
+  OptResults results;
+  std::istringstream resultsStream(resultsFrame);
+  if(!readResults(resultsStream, &results) || !results.successful)
+    return OptimisationOutcome::failure(OptimisationError::INTERNAL_ERROR);
+
+  // Don't let an empty or unreadable frame wipe out the structure
+  std::istringstream newStrStream(strFrame);
+  common::StructurePtr newStructure = myResReaderWriter.readStructure(
+      newStrStream);
+  if(!newStructure.get()
+      || (newStructure->getNumAtoms() == 0 && structure.getNumAtoms() != 0))
+    return OptimisationOutcome::failure(
+        OptimisationError::PROBLEM_WITH_STRUCTURE);
+
+  copyResults(results, &data);
+
+  // Copy over the new structure
+  structure = *newStructure;
+  data.saveToStructure(structure);
+
+  return OptimisationOutcome::success();
+}
+
 void
 ExternalOptimiser::writeSettings(const std::string & filename,
     const OptimisationSettings & settings) const
@@ -135,6 +202,18 @@ ExternalOptimiser::writeSettings(const std::string & filename,
   if(filename.empty())
     return;
 
+  std::ofstream settingsFile(filename.c_str());
+  if(settingsFile.is_open())
+  {
+    writeSettings(settingsFile, settings);
+    settingsFile.close();
+  }
+}
+
+void
+ExternalOptimiser::writeSettings(std::ostream & os,
+    const OptimisationSettings & settings) const
+{
   OptSettings optSettings;
   optSettings.maxIter = settings.maxIter;
   optSettings.energyTol = settings.energyTol;
@@ -146,12 +225,7 @@ ExternalOptimiser::writeSettings(const std::string & filename,
   YAML::Node settingsNode;
   schemer::serialise(optSettings, &settingsNode);
 
-  std::ofstream settingsFile(filename.c_str());
-  if(settingsFile.is_open())
-  {
-    settingsFile << settingsNode << "\n";
-    settingsFile.close();
-  }
+  os << settingsNode << "\n";
 }
 
 bool
@@ -178,6 +252,60 @@ ExternalOptimiser::readResults(const std::string & filename,
   return true;
 }
 
+bool
+ExternalOptimiser::readResults(std::istream & is,
+    OptResults * const results) const
+{
+  YAML::Node resultsNode;
+  try
+  {
+    resultsNode = YAML::Load(is);
+  }
+  catch(const YAML::Exception & /*e*/)
+  {
+    return false;
+  }
+
+  return schemer::parse(resultsNode, results);
+}
+
+bool
+ExternalOptimiser::writeFrame(const std::string & payload) const
+{
+  return myWorker.write(
+      boost::lexical_cast< std::string>(payload.size()) + "\n" + payload);
+}
+
+bool
+ExternalOptimiser::readFrame(std::string * const payload) const
+{
+  std::string header;
+  if(!myWorker.readLine(&header))
+    return false;
+
+  size_t length;
+  try
+  {
+    length = boost::lexical_cast< size_t>(header);
+  }
+  catch(const boost::bad_lexical_cast & /*e*/)
+  {
+    return false;
+  }
+
+  return myWorker.read(payload, length);
+}
+
+void
+ExternalOptimiser::copyResults(const OptResults & results,
+    OptimisationData * const data) const
+{
+  data->internalEnergy = results.finalInternalEnergy;
+  data->enthalpy = results.finalEnthalpy;
+  data->numIters = results.finalIters;
+  data->pressure = results.finalPressure;
+}
+
 }
 }
 
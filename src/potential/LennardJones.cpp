@@ -11,11 +11,13 @@
 #include <memory>
 
 #include <boost/algorithm/string.hpp>
+#include <boost/variant/static_visitor.hpp>
 
 #include "spl/common/AtomSpeciesDatabase.h"
-#include "spl/common/DistanceCalculator.h"
+#include "spl/common/DistanceCalculatorDelegator.h"
 #include "spl/common/UnitCell.h"
 #include "spl/utility/IndexingEnums.h"
+#include "spl/utility/Instrumentation.h"
 
 // NAMESPACES ////////////////////////////////
 
@@ -196,107 +198,149 @@ LennardJones::updateSpeciesDb(
   return true;
 }
 
-bool
-LennardJones::evaluate(const common::Structure & structure,
-    PotentialData & data) const
+struct LennardJones::EvaluatePairsVisitor : public boost::static_visitor< bool>
 {
-  using namespace utility::cart_coords_enum;
-  using std::vector;
-  using std::sqrt;
-
-  const size_t numParticles = structure.getNumAtoms();
-  if(data.forces.n_rows != 3 || data.forces.n_cols != numParticles)
-    data.forces.set_size(3, numParticles);
-  double rSq, modR, modF, selfInteraction;
-// Displacement and force vectors
-  arma::vec3 f;
-// Position vectors
-  arma::vec3 posI, posJ;
-// Energy and force scalars
-  std::pair< double, double> energyForce;
-
-// Get the species of all the atoms
-  vector< std::string> species;
-  structure.getAtomSpecies(std::back_inserter(species));
-
-  vector< arma::vec3> imageVectors;
+  EvaluatePairsVisitor(const LennardJones & lj,
+      const common::Structure & structure, PotentialData & data) :
+      myLj(lj), myStructure(structure), myData(data)
+  {
+  }
 
-  const common::DistanceCalculator & distCalc =
-      structure.getDistanceCalculator();
+  template< class DistCalc>
+    bool
+    operator()(const DistCalc & distCalc) const
+    {
+      return myLj.evaluatePairs(distCalc, myStructure, myData);
+    }
 
-  bool problemDuringCalculation = false;
-  Interactions::const_iterator interaction;
+private:
+  const LennardJones & myLj;
+  const common::Structure & myStructure;
+  PotentialData & myData;
+};
 
-// Loop over all particle pairs (including self-interaction)
-  for(size_t i = 0; i < numParticles; ++i)
+template< class DistCalc>
+  bool
+  LennardJones::evaluatePairs(const DistCalc & distCalc,
+      const common::Structure & structure, PotentialData & data) const
   {
-    posI = structure.getAtom(i).getPosition();
-
-    for(size_t j = i; j < numParticles; ++j)
+    using namespace utility::cart_coords_enum;
+    using std::vector;
+    using std::sqrt;
+
+    const size_t numParticles = structure.getNumAtoms();
+    double rSq, modR, modF, selfInteraction;
+  // Displacement and force vectors
+    arma::vec3 f;
+  // Position vectors
+    arma::vec3 posI, posJ;
+  // Energy and force scalars
+    std::pair< double, double> energyForce;
+
+  // Get the species of all the atoms
+    vector< std::string> species;
+    structure.getAtomSpecies(std::back_inserter(species));
+
+    vector< arma::vec3> imageVectors;
+
+    // Positions wrapped into the cell once up front, not for every pair
+    const arma::mat & wrappedPositions =
+        structure.getDistanceCalculator().getWrappedPositions();
+
+    bool problemDuringCalculation = false;
+    Interactions::const_iterator interaction;
+
+  // Loop over all particle pairs (including self-interaction)
+    for(size_t i = 0; i < numParticles; ++i)
     {
-      // TODO: Set species
-      interaction = myInteractions.find(SpeciesPair(species[i], species[j]));
-      if(interaction == myInteractions.end())
-        continue;
+      posI = wrappedPositions.col(i);
 
-      const Params & params = interaction->second;
-      posJ = structure.getAtom(j).getPosition();
-
-      imageVectors.clear();
-      if(!distCalc.getVecsBetween(posI, posJ, params.cutoff, imageVectors,
-          MAX_INTERACTION_VECTORS, MAX_CELL_MULTIPLES))
+      for(size_t j = i; j < numParticles; ++j)
       {
-        // We reached the maximum number of interaction vectors so indicate that there was a problem
-        problemDuringCalculation = true;
-        // Try evaluating with a smaller cutoff to try and get a full set
-        // of interaction vectors
-        imageVectors.clear();
-        distCalc.getVecsBetween(posI, posJ, 0.5 * params.cutoff, imageVectors,
-            MAX_INTERACTION_VECTORS, MAX_CELL_MULTIPLES);
-      }
+        // TODO: Set species
+        interaction = myInteractions.find(SpeciesPair(species[i], species[j]));
+        if(interaction == myInteractions.end())
+          continue;
 
-      // Used as a prefactor depending if the particles i and j are in fact the same
-      selfInteraction = (i == j) ? 0.5 : 1.0;
-      BOOST_FOREACH(const arma::vec & r, imageVectors)
-      {
-        // Get the distance squared
-        rSq = dot(r, r);
+        const Params & params = interaction->second;
+        posJ = wrappedPositions.col(j);
 
-        // Check that distance isn't near the 0 as this will cause near-singular values
-        if(rSq > MIN_SEPARATION_SQ)
+        imageVectors.clear();
+        if(!distCalc.getVecsBetweenWrapped(posI, posJ, params.cutoff,
+            imageVectors, MAX_INTERACTION_VECTORS, MAX_CELL_MULTIPLES))
         {
-          modR = sqrt(rSq);
-          energyForce = evaluate(modR, params);
-
-          f = energyForce.second / modR * r;
-          // Make sure we get energy/force correct for self-interaction
-          f *= selfInteraction;
+          // We reached the maximum number of interaction vectors so indicate that there was a problem
+          problemDuringCalculation = true;
+          // Try evaluating with a smaller cutoff to try and get a full set
+          // of interaction vectors
+          imageVectors.clear();
+          distCalc.getVecsBetweenWrapped(posI, posJ, 0.5 * params.cutoff,
+              imageVectors, MAX_INTERACTION_VECTORS, MAX_CELL_MULTIPLES);
+        }
 
-          // Update system values
-          // energy
-          data.internalEnergy += selfInteraction * energyForce.first;
+        // Used as a prefactor depending if the particles i and j are in fact the same
+        selfInteraction = (i == j) ? 0.5 : 1.0;
+        BOOST_FOREACH(const arma::vec & r, imageVectors)
+        {
+          // Get the distance squared
+          rSq = dot(r, r);
+
+          // Check that distance isn't near the 0 as this will cause near-singular values
+          if(rSq > MIN_SEPARATION_SQ)
+          {
+            modR = sqrt(rSq);
+            energyForce = evaluate(modR, params);
+
+            f = energyForce.second / modR * r;
+            // Make sure we get energy/force correct for self-interaction
+            f *= selfInteraction;
+
+            // Update system values
+            // energy
+            data.internalEnergy += selfInteraction * energyForce.first;
 #ifdef LJ_DEBUGGING
-          std::cout << std::setprecision(16)
-          << selfInteraction * energyForce.first << "\n";
+            std::cout << std::setprecision(16)
+            << selfInteraction * energyForce.first << "\n";
 #endif
 
-          // force
-          data.forces.col(i) -= f;
-          if(i != j)
-            data.forces.col(j) += f;
+            // force
+            data.forces.col(i) -= f;
+            if(i != j)
+              data.forces.col(j) += f;
 
-          // stress, diagonal is element wise multiplication of force and position
-          // vector components
-          data.stressMtx.diag() -= f % r;
+            // stress, diagonal is element wise multiplication of force and position
+            // vector components
+            data.stressMtx.diag() -= f % r;
 
-          data.stressMtx(Y, Z) -= 0.5 * (f(Y) * r(Z) + f(Z) * r(Y));
-          data.stressMtx(X, Z) -= 0.5 * (f(X) * r(Z) + f(Z) * r(X));
-          data.stressMtx(X, Y) -= 0.5 * (f(X) * r(Y) + f(Y) * r(X));
+            data.stressMtx(Y, Z) -= 0.5 * (f(Y) * r(Z) + f(Z) * r(Y));
+            data.stressMtx(X, Z) -= 0.5 * (f(X) * r(Z) + f(Z) * r(X));
+            data.stressMtx(X, Y) -= 0.5 * (f(X) * r(Y) + f(Y) * r(X));
+          }
         }
       }
     }
+
+    return problemDuringCalculation;
   }
 
+bool
+LennardJones::evaluate(const common::Structure & structure,
+    PotentialData & data) const
+{
+  using namespace utility::cart_coords_enum;
+  const utility::instrumentation::ScopedTimer timer(
+      "potential.LennardJones.evaluate");
+
+  const size_t numParticles = structure.getNumAtoms();
+  if(data.forces.n_rows != 3 || data.forces.n_cols != numParticles)
+    data.forces.set_size(3, numParticles);
+
+  // Dispatch once on the type of distance calculator so that the pair loop
+  // is compiled for each calculator with the distance calls inlined
+  EvaluatePairsVisitor evaluatePairsVisitor(*this, structure, data);
+  const bool problemDuringCalculation = common::visitDistanceCalculator(
+      structure.getDistanceCalculator(), evaluatePairsVisitor);
+
 #ifdef LJ_DEBUGGING
   for(size_t i = 0; i < data.forces.n_cols; ++i)
   {
@@ -314,7 +358,7 @@ LennardJones::evaluate(const common::Structure & structure,
 
 // Now balance forces
 // (do sum of values for each component and divide by number of particles)
-  f = sum(data.forces, 1) / static_cast< double>(numParticles);
+  const arma::vec3 f = sum(data.forces, 1) / static_cast< double>(numParticles);
   data.forces.row(X) -= f(Y);
   data.forces.row(Y) -= f(X);
   data.forces.row(Z) -= f(Z);
@@ -13,9 +13,9 @@
 #include "spl/SSLib.h"
 #include "spl/common/UnitCell.h"
 #include "spl/potential/OptimisationSettings.h"
+#include "spl/utility/Instrumentation.h"
 
 //#define TPSD_GEOM_OPTIMISER_DEBUG (SSLIB_DEBUG & 0)
-//#define TPSD_GEOM_OPTIMISER_TIMING
 //#define TPSD_GEOM_OPTIMISER_CONV
 
 #if TPSD_GEOM_OPTIMISER_DEBUG
@@ -25,10 +25,6 @@
 #  include "spl/io/ResReaderWriter.h"
 #endif
 
-#ifdef TPSD_GEOM_OPTIMISER_TIMING
-#  include <ctime>
-#endif
-
 // NAMESPACES ////////////////////////////////
 namespace spl {
 namespace potential {
@@ -141,9 +137,8 @@ TpsdGeomOptimiser::optimise(common::Structure & structure,
 {
   SSLIB_ASSERT(settings.maxIter.is_initialized());
 
-#ifdef TPSD_GEOM_OPTIMISER_TIMING
-  const clock_t t0 = std::clock();
-#endif
+  const utility::instrumentation::ScopedTimer timer(
+      "potential.TpsdGeomOptimiser.optimise");
 
   // Get data about the structure to be optimised
   PotentialData & data = evaluator.getData();
@@ -251,11 +246,8 @@ TpsdGeomOptimiser::optimise(common::Structure & structure,
   populateOptimistaionData(optimisationData, structure, data);
   optimisationData.numIters.reset(iter - 1);
 
-#ifdef TPSD_GEOM_OPTIMISER_TIMING
-  const clock_t t = std::clock() - t0;
-  std::cout << "Optimisation took: " << static_cast< float>(t) / CLOCKS_PER_SEC
-  << std::endl;
-#endif
+  utility::instrumentation::sample("potential.TpsdGeomOptimiser.iterations",
+      iter - 1);
 
   return outcome;
 }
@@ -269,9 +261,8 @@ TpsdGeomOptimiser::optimise(common::Structure & structure,
   SSLIB_ASSERT(settings.maxIter.is_initialized());
   SSLIB_ASSERT(settings.pressure.is_initialized());
 
-#ifdef TPSD_GEOM_OPTIMISER_TIMING
-  const clock_t t0 = std::clock();
-#endif
+  const utility::instrumentation::ScopedTimer timer(
+      "potential.TpsdGeomOptimiser.optimise");
 
 #if TPSD_GEOM_OPTIMISER_DEBUG
   TpsdGeomOptimiserDebugger debugger;
@@ -467,11 +458,8 @@ TpsdGeomOptimiser::optimise(common::Structure & structure,
   populateOptimistaionData(optimisationData, structure, data);
   optimisationData.numIters.reset(iter - 1);
 
-#ifdef TPSD_GEOM_OPTIMISER_TIMING
-  const clock_t t = std::clock() - t0;
-  std::cout << iter << " iterations in "
-  << static_cast< float>(t) / CLOCKS_PER_SEC << "s\n";
-#endif
+  utility::instrumentation::sample("potential.TpsdGeomOptimiser.iterations",
+      iter - 1);
 
   return outcome;
 }
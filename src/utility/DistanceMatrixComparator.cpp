@@ -9,14 +9,17 @@
 #include "spl/utility/DistanceMatrixComparator.h"
 
 #include <iterator>
+#include <limits>
 
 #include <boost/foreach.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "spl/common/DistanceCalculator.h"
+#include "spl/common/GeometrySnapshot.h"
 #include "spl/common/Structure.h"
 #include "spl/math/NumberAlgorithms.h"
 #include "spl/utility/GenericBufferedComparator.h"
+#include "spl/utility/Instrumentation.h"
 
 // Turn on or off DistanceMatrixComparator (DMC) debugging
 //#define SSLIB_DMC_DEBUG
@@ -40,28 +43,26 @@ DistanceMatrixComparisonData::DistanceMatrixComparisonData(
     const common::Structure & _structure)
 {
   // Get a primitive setting version of the structure, otherwise the algorithm could get confused
-  const UniquePtr< const common::Structure>::Type primitive(
-      _structure.getPrimitiveCopy());
+  const common::GeometrySnapshot primitive(_structure, true);
 
   const common::DistanceCalculator & distCalc =
-      primitive->getDistanceCalculator();
+      primitive.getDistanceCalculator();
+  const arma::mat & positions = primitive.getPositions();
 
-  const size_t numAtoms = primitive->getNumAtoms();
+  const size_t numAtoms = primitive.getNumAtoms();
   arma::mat unsortedDistnacesMatrix(numAtoms, numAtoms);
   unsortedDistnacesMatrix.diag().zeros();
 
   // Copy over the species of all the atoms (ordered by index)
-  primitive->getAtomSpecies(std::back_inserter(speciesList));
+  speciesList = primitive.getSpecies();
 
   size_t i, j; // Loop indices used throughout
-  const common::Atom * atomI;
-  for(i = 0; i < numAtoms - 1; ++i)
+  for(i = 0; i + 1 < numAtoms; ++i)
   {
-    atomI = &primitive->getAtom(i);
     for(size_t j = i + 1; j < numAtoms; ++j)
     {
-      unsortedDistnacesMatrix(i, j) = distCalc.getDistMinImg(*atomI,
-          primitive->getAtom(j));
+      unsortedDistnacesMatrix(i, j) = distCalc.getDistMinImg(
+          positions.unsafe_col(i), positions.unsafe_col(j));
     }
   }
   // Copy over symmetric elements to bottom left
@@ -149,6 +150,8 @@ std::auto_ptr< DistanceMatrixComparisonData>
 DistanceMatrixComparator::generateComparisonData(
     const common::Structure & structure) const
 {
+  const instrumentation::ScopedTimer timer(
+      "utility.DistanceMatrixComparator.generateComparisonData");
   return std::auto_ptr< DistanceMatrixComparisonData>(
       new DistanceMatrixComparisonData(structure));
 }
@@ -157,12 +160,19 @@ bool
 DistanceMatrixComparator::areSimilar(const DataTyp & str1Data,
     const DataTyp & str2Data) const
 {
-  return compareStructures(str1Data, str2Data) < myTolerance;
+  return compare(str1Data, str2Data, myTolerance) < myTolerance;
 }
 
 double
 DistanceMatrixComparator::compareStructures(const DataTyp & str1Data,
     const DataTyp & str2Data) const
+{
+  return compare(str1Data, str2Data, std::numeric_limits< double>::infinity());
+}
+
+double
+DistanceMatrixComparator::compare(const DataTyp & str1Data,
+    const DataTyp & str2Data, const double threshold) const
 {
   if(!areComparable(str1Data, str2Data))
     return STRUCTURES_INCOMPARABLE;
@@ -173,12 +183,12 @@ DistanceMatrixComparator::compareStructures(const DataTyp & str1Data,
   if(maxAtoms < myFastComparisonAtomsLimit)
   {
     // Use more expensive, but more accurate method
-    return compareStructuresFull(str1Data, str2Data);
+    return compareStructuresFull(str1Data, str2Data, threshold);
   }
   else
   {
     // Use cheaper method
-    return compareStructuresFast(str1Data, str2Data);
+    return compareStructuresFast(str1Data, str2Data, threshold);
   }
 }
 
@@ -191,7 +201,7 @@ DistanceMatrixComparator::areComparable(const DataTyp & str1Data,
 
 double
 DistanceMatrixComparator::compareStructuresFull(const DataTyp & str1Data,
-    const DataTyp & str2Data) const
+    const DataTyp & str2Data, const double threshold) const
 {
   const size_t numAtoms1 = str1Data.distancesMtx.n_cols;
   const size_t numAtoms2 = str2Data.distancesMtx.n_cols;
@@ -205,6 +215,8 @@ DistanceMatrixComparator::compareStructuresFull(const DataTyp & str1Data,
   double r_ij1, r_ij2, distDiff;
   double sqSum = 0.0;
   double minSqSum = std::numeric_limits< double>::max();
+  // Permutations can be abandoned once they reach this
+  double maxSqSum = std::min(threshold * threshold, minSqSum);
   bool speciesMismatch;
   size_t i, j, iRem, permIRem;
 
@@ -239,15 +251,16 @@ DistanceMatrixComparator::compareStructuresFull(const DataTyp & str1Data,
           {
             distDiff = 2.0 * (r_ij1 - r_ij2) / (r_ij1 + r_ij2);
             sqSum += distDiff * distDiff;
-            if(sqSum >= minSqSum)
+            if(sqSum >= maxSqSum)
               break;
           }
         }
-        if(sqSum >= minSqSum)
+        if(sqSum >= maxSqSum)
           break;
       }
 
       minSqSum = std::min(sqSum, minSqSum);
+      maxSqSum = std::min(maxSqSum, minSqSum);
     }
   } while(std::next_permutation(indices.begin(), indices.end()));
 
@@ -256,17 +269,19 @@ DistanceMatrixComparator::compareStructuresFull(const DataTyp & str1Data,
 
 double
 DistanceMatrixComparator::compareStructuresFast(const DataTyp & str1Data,
-    const DataTyp & str2Data) const
+    const DataTyp & str2Data, const double threshold) const
 {
   const size_t numAtoms1 = str1Data.distancesMtx.n_cols;
   const size_t numAtoms2 = str2Data.distancesMtx.n_cols;
   const unsigned int leastCommonMultiple = math::leastCommonMultiple(numAtoms1,
       numAtoms2);
+  const double maxSqSum = threshold * threshold;
 
   size_t i, j, iRem1, iRem2;
+  size_t numVisited = 0;
   double r_ij1, r_ij2, distDiff;
   double sqSum = 0.0;
-  for(i = 0; i < leastCommonMultiple; ++i)
+  for(i = 0; i < leastCommonMultiple && sqSum < maxSqSum; ++i)
   {
     iRem1 = i % numAtoms1;
     iRem2 = i % numAtoms2;
@@ -279,9 +294,27 @@ DistanceMatrixComparator::compareStructuresFast(const DataTyp & str1Data,
       {
         distDiff = 2.0 * (r_ij1 - r_ij2) / (r_ij1 + r_ij2);
         sqSum += distDiff * distDiff;
+        if(sqSum >= maxSqSum)
+        {
+          numVisited += j - i;
+          break;
+        }
       }
     }
+    if(sqSum < maxSqSum)
+      numVisited += leastCommonMultiple - i - 1;
+  }
+
+  if(threshold != std::numeric_limits< double>::infinity()
+      && leastCommonMultiple > 1)
+  {
+    const size_t numPairs = leastCommonMultiple * (leastCommonMultiple - 1)
+        / 2;
+    instrumentation::sample("utility.DistanceMatrixComparator.fractionSkipped",
+        1.0 - static_cast< double>(numVisited)
+            / static_cast< double>(numPairs));
   }
+
   return sqrt(sqSum);
 }
 
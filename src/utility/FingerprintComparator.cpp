@@ -0,0 +1,234 @@
+/*
+ * FingerprintComparator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES /////////////////////////////////////
+#include "spl/utility/FingerprintComparator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "spl/analysis/RadialDistribution.h"
+#include "spl/common/Structure.h"
+#include "spl/common/UnitCell.h"
+#include "spl/utility/GenericBufferedComparator.h"
+#include "spl/utility/Instrumentation.h"
+
+namespace spl {
+namespace utility {
+
+namespace {
+
+// Number of independent accumulators used by the comparison kernels.  With
+// no dependency between lanes the compiler can keep them in vector registers
+// without needing to reassociate floating point additions.
+static const size_t LANES = 8;
+
+float
+dot(const float * const a, const float * const b, const size_t n)
+{
+  float sum[LANES] =
+    { 0.0f };
+  const size_t numBlocked = n - n % LANES;
+  for(size_t i = 0; i < numBlocked; i += LANES)
+  {
+    for(size_t l = 0; l < LANES; ++l)
+      sum[l] += a[i + l] * b[i + l];
+  }
+  for(size_t i = numBlocked; i < n; ++i)
+    sum[0] += a[i] * b[i];
+
+  float total = 0.0f;
+  for(size_t l = 0; l < LANES; ++l)
+    total += sum[l];
+  return total;
+}
+
+float
+distSq(const float * const a, const float * const b, const size_t n)
+{
+  float sum[LANES] =
+    { 0.0f };
+  const size_t numBlocked = n - n % LANES;
+  for(size_t i = 0; i < numBlocked; i += LANES)
+  {
+    for(size_t l = 0; l < LANES; ++l)
+    {
+      const float diff = a[i + l] - b[i + l];
+      sum[l] += diff * diff;
+    }
+  }
+  for(size_t i = numBlocked; i < n; ++i)
+    sum[0] += (a[i] - b[i]) * (a[i] - b[i]);
+
+  float total = 0.0f;
+  for(size_t l = 0; l < LANES; ++l)
+    total += sum[l];
+  return total;
+}
+
+}
+
+const double FingerprintComparator::DEFAULT_TOLERANCE = 1e-3;
+const double FingerprintComparator::DEFAULT_CUTOFF = 6.0;
+const double FingerprintComparator::DEFAULT_BIN_WIDTH = 0.05;
+const double FingerprintComparator::DEFAULT_SMEARING = 0.03;
+
+FingerprintComparisonData::FingerprintComparisonData(
+    const common::Structure & structure, const double cutoff,
+    const double binWidth, const double smearing, const bool volumeAgnostic) :
+    norm(0.0f)
+{
+  // Factor that lengths would have to be scaled by to give a volume of 1.0
+  // per atom.  g(r) doesn't change when the structure is scaled so, rather
+  // than scaling a copy of it, the cutoff and bins are scaled the other way.
+  double lengthScale = 1.0;
+  if(volumeAgnostic && structure.getUnitCell()
+      && structure.getNumAtoms() != 0)
+    lengthScale = ::std::pow(
+        structure.getNumAtoms() / structure.getUnitCell()->getVolume(),
+        1.0 / 3.0);
+
+  analysis::RadialDistribution::Settings settings;
+  settings.cutoff = cutoff / lengthScale;
+  settings.binWidth = binWidth / lengthScale;
+  // Comparison data is often generated from many threads at once already
+  settings.numThreads = 1;
+  analysis::RadialDistribution rdf(settings);
+  rdf.add(structure);
+  species = rdf.getSpecies();
+
+  // Normalised Gaussian smearing kernel sampled at the bin spacing
+  const int halfWidth =
+      smearing > 0.0 ?
+          static_cast< int>(::std::ceil(3.0 * smearing / binWidth)) : 0;
+  ::std::vector< double> kernel(2 * halfWidth + 1, 1.0);
+  double kernelSum = 1.0;
+  for(int k = 1; k <= halfWidth; ++k)
+  {
+    const double x = static_cast< double>(k) * binWidth / smearing;
+    kernel[halfWidth + k] = kernel[halfWidth - k] = ::std::exp(-0.5 * x * x);
+    kernelSum += 2.0 * kernel[halfWidth + k];
+  }
+  for(size_t k = 0; k < kernel.size(); ++k)
+    kernel[k] /= kernelSum;
+
+  // Taken from the unscaled settings so that all fingerprints have the same
+  // length, rounding can give the rdf an extra bin
+  const int numBins = static_cast< int>(::std::ceil(cutoff / binWidth));
+  const size_t numSpecies = species.size();
+  fingerprint.reserve(numSpecies * (numSpecies + 1) / 2 * numBins);
+  for(size_t i = 0; i < numSpecies; ++i)
+  {
+    for(size_t j = i; j < numSpecies; ++j)
+    {
+      const analysis::RadialDistribution::Distribution g = rdf.getPartial(i,
+          j);
+      for(int bin = 0; bin < numBins; ++bin)
+      {
+        double value = 0.0;
+        for(int k = -halfWidth; k <= halfWidth; ++k)
+        {
+          if(bin + k >= 0 && bin + k < numBins)
+            value += kernel[halfWidth + k] * (g[bin + k] - 1.0);
+        }
+        fingerprint.push_back(static_cast< float>(value));
+      }
+    }
+  }
+
+  if(!fingerprint.empty())
+    norm = ::std::sqrt(
+        dot(&fingerprint[0], &fingerprint[0], fingerprint.size()));
+}
+
+FingerprintComparator::FingerprintComparator()
+{
+}
+
+FingerprintComparator::FingerprintComparator(const ConstructionInfo & info) :
+    myInfo(info)
+{
+}
+
+double
+FingerprintComparator::compareStructures(const spl::common::Structure & str1,
+    const spl::common::Structure & str2) const
+{
+  ComparisonDataPtr comp1(generateComparisonData(str1));
+  ComparisonDataPtr comp2(generateComparisonData(str2));
+
+  return compareStructures(*comp1, *comp2);
+}
+
+bool
+FingerprintComparator::areSimilar(const spl::common::Structure & str1,
+    const spl::common::Structure & str2) const
+{
+  ComparisonDataPtr comp1(generateComparisonData(str1));
+  ComparisonDataPtr comp2(generateComparisonData(str2));
+
+  return areSimilar(*comp1, *comp2);
+}
+
+boost::shared_ptr< FingerprintComparator::BufferedTyp>
+FingerprintComparator::generateBuffered() const
+{
+  return boost::shared_ptr< IBufferedComparator>(
+      new GenericBufferedComparator< FingerprintComparator>(*this));
+}
+
+bool
+FingerprintComparator::isMetric() const
+{
+  return myInfo.metric == FingerprintMetric::EUCLIDEAN;
+}
+
+double
+FingerprintComparator::compareStructures(
+    const FingerprintComparisonData & data1,
+    const FingerprintComparisonData & data2) const
+{
+  if(data1.species != data2.species
+      || data1.fingerprint.size() != data2.fingerprint.size())
+    return ::std::numeric_limits< double>::max(); // Species mismatch
+
+  const size_t length = data1.fingerprint.size();
+  if(length == 0)
+    return 0.0;
+
+  const float * const f1 = &data1.fingerprint[0];
+  const float * const f2 = &data2.fingerprint[0];
+  if(myInfo.metric == FingerprintMetric::EUCLIDEAN)
+    return ::std::sqrt(distSq(f1, f2, length) / static_cast< double>(length));
+
+  if(data1.norm == 0.0f || data2.norm == 0.0f)
+    return data1.norm == data2.norm ? 0.0 : 0.5;
+  const double cosine = dot(f1, f2, length) / (data1.norm * data2.norm);
+  return ::std::max(0.0, 0.5 * (1.0 - cosine));
+}
+
+bool
+FingerprintComparator::areSimilar(const FingerprintComparisonData & data1,
+    const FingerprintComparisonData & data2) const
+{
+  return compareStructures(data1, data2) < myInfo.tolerance;
+}
+
+FingerprintComparator::ComparisonDataPtr
+FingerprintComparator::generateComparisonData(
+    const spl::common::Structure & str) const
+{
+  const instrumentation::ScopedTimer timer(
+      "utility.FingerprintComparator.generateComparisonData");
+  return ComparisonDataPtr(
+      new FingerprintComparisonData(str, myInfo.cutoff, myInfo.binWidth,
+          myInfo.smearing, myInfo.volumeAgnostic));
+}
+
+}
+}
@@ -8,6 +8,7 @@
 // INCLUDES //////////////////////////////////
 #include "spl/utility/HeterogeneousMap.h"
 
+#include <algorithm>
 #include <utility>
 
 #include <boost/foreach.hpp>
@@ -17,6 +18,20 @@
 namespace spl {
 namespace utility {
 
+namespace {
+
+struct KeyLess
+{
+  template< typename Entry>
+    bool
+    operator()(const Entry & entry, const KeyId * const key) const
+    {
+      return entry.key < key;
+    }
+};
+
+}
+
 HeterogeneousMap::HeterogeneousMap(const HeterogeneousMap & toCopy)
 {
   // Use equals operator to reduce code replication
@@ -26,8 +41,14 @@ HeterogeneousMap::HeterogeneousMap(const HeterogeneousMap & toCopy)
 HeterogeneousMap &
 HeterogeneousMap::operator =(const HeterogeneousMap & rhs)
 {
+  if(this == &rhs)
+    return *this;
+
   clear();
-  insert(rhs);
+  myEntries = rhs.myEntries;
+  // Tell the keys that they now store a value in this map
+  BOOST_FOREACH(Entry & entry, myEntries)
+    entry.key->insertedIntoMap(*this);
   return *this;
 }
 
@@ -39,108 +60,120 @@ HeterogeneousMap::~HeterogeneousMap()
 bool
 HeterogeneousMap::empty() const
 {
-  return myAnyMap.empty();
+  return myEntries.empty();
 }
 
 size_t
 HeterogeneousMap::size() const
 {
-  return myAnyMap.size();
+  return myEntries.size();
 }
 
 size_t
 HeterogeneousMap::max_size() const
 {
-  return myAnyMap.max_size();
+  return myEntries.max_size();
 }
 
 void
 HeterogeneousMap::insert(const HeterogeneousMap & map)
 {
-  BOOST_FOREACH(const AnyMap::value_type & value, map.myAnyMap)
-  {
-    insert(value);
-  }
+  insert(map, false);
 }
 
 void
 HeterogeneousMap::insert(const HeterogeneousMap & map, const bool overwrite)
 {
-  BOOST_FOREACH(const AnyMap::value_type & value, map.myAnyMap)
-  {
-    insert(value, overwrite);
-  }
+  if(&map == this)
+    return;
+
+  myEntries.reserve(myEntries.size() + map.myEntries.size());
+  BOOST_FOREACH(const Entry & entry, map.myEntries)
+    insert(entry.key, entry.value, overwrite);
 }
 
 void
 HeterogeneousMap::clear()
 {
   // Tell all the keys that they are being removed from the map
-  BOOST_FOREACH(AnyMap::value_type & value, myAnyMap)
-  {
-    value.first->removedFromMap(*this);
-  }
+  BOOST_FOREACH(Entry & entry, myEntries)
+    entry.key->removedFromMap(*this);
 
-  myAnyMap.clear();
+  myEntries.clear();
 }
 
 size_t
 HeterogeneousMap::erase(KeyId & key)
 {
-  const AnyMap::iterator it = myAnyMap.find(&key);
-
-  if(it == myAnyMap.end())
+  if(eraseNoNotify(key) == 0)
     return 0;
 
-  myAnyMap.erase(it);
   key.removedFromMap(*this);
   return 1;
 }
 
-::std::pair< HeterogeneousMap::AnyMap::iterator, bool>
-HeterogeneousMap::insert(const AnyMap::value_type & value)
+HeterogeneousMap::Entries::iterator
+HeterogeneousMap::lowerBound(const KeyId * const key)
 {
-  const ::std::pair< AnyMap::iterator, bool> result = myAnyMap.insert(value);
+  return ::std::lower_bound(myEntries.begin(), myEntries.end(), key,
+      KeyLess());
+}
 
-  if(result.second)
-  {
-    // Tell the key that it now stores a value in this map
-    value.first->insertedIntoMap(*this);
-  }
+HeterogeneousMap::Entries::const_iterator
+HeterogeneousMap::lowerBound(const KeyId * const key) const
+{
+  return ::std::lower_bound(myEntries.begin(), myEntries.end(), key,
+      KeyLess());
+}
 
-  return result;
+HeterogeneousMap::Value *
+HeterogeneousMap::findValue(const KeyId * const key)
+{
+  const Entries::iterator it = lowerBound(key);
+  if(it == myEntries.end() || it->key != key)
+    return NULL;
+  return &it->value;
 }
 
-::std::pair< HeterogeneousMap::AnyMap::iterator, bool>
-HeterogeneousMap::insert(const AnyMap::value_type & value, const bool overwrite)
+const HeterogeneousMap::Value *
+HeterogeneousMap::findValue(const KeyId * const key) const
 {
-  ::std::pair< AnyMap::iterator, bool> result = insert(value);
+  const Entries::const_iterator it = lowerBound(key);
+  if(it == myEntries.end() || it->key != key)
+    return NULL;
+  return &it->value;
+}
 
-  if(result.second)
-  {
-    // Tell the key that it now stores a value in this map
-    value.first->insertedIntoMap(*this);
-  }
+::std::pair< HeterogeneousMap::Entries::iterator, bool>
+HeterogeneousMap::insert(KeyId * const key, const Value & value,
+    const bool overwrite)
+{
+  Entries::iterator it = lowerBound(key);
 
-  // If it wasn't inserted and we should overwrite the value then do so
-  if(!result.second && overwrite)
+  if(it != myEntries.end() && it->key == key)
   {
-    result.first->second = value.second;
-    result.second = true; // The value _was_ inserted
+    // If it wasn't inserted and we should overwrite the value then do so
+    if(!overwrite)
+      return ::std::make_pair(it, false);
+    it->value = value;
+    return ::std::make_pair(it, true); // The value _was_ inserted
   }
 
-  return result;
+  it = myEntries.insert(it, Entry(key, value));
+  // Tell the key that it now stores a value in this map
+  key->insertedIntoMap(*this);
+  return ::std::make_pair(it, true);
 }
 
 size_t
 HeterogeneousMap::eraseNoNotify(KeyId & key)
 {
-  const AnyMap::iterator it = myAnyMap.find(&key);
+  const Entries::iterator it = lowerBound(&key);
 
-  if(it == myAnyMap.end())
+  if(it == myEntries.end() || it->key != &key)
     return 0;
 
-  myAnyMap.erase(it);
+  myEntries.erase(it);
   return 1;
 }
 
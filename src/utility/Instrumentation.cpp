@@ -0,0 +1,552 @@
+/*
+ * Instrumentation.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "spl/utility/Instrumentation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <set>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/foreach.hpp>
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <boost/atomic.hpp>
+#  include <boost/thread/mutex.hpp>
+#  include <boost/thread/tss.hpp>
+#endif
+
+// NAMESPACES ////////////////////////////////
+
+namespace spl {
+namespace utility {
+namespace instrumentation {
+
+namespace detail {
+#ifdef SPL_ENABLE_THREAD_AWARE
+::boost::atomic< bool> enabled(::std::getenv("SPL_INSTRUMENTATION") != NULL);
+#else
+bool enabled = ::std::getenv("SPL_INSTRUMENTATION") != NULL;
+#endif
+}
+
+namespace {
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+// Bumped by reset(), accumulators from an earlier generation are cleared by
+// their thread the next time it records something
+::boost::atomic< unsigned int> generation(0);
+#endif
+
+// A value only ever changed by the thread that owns it but that can be read
+// at any time by the thread making a report
+template< typename T>
+  class Relaxed
+  {
+  public:
+    Relaxed() :
+        myValue(T())
+    {
+    }
+    Relaxed(const Relaxed & other) :
+        myValue(other.get())
+    {
+    }
+
+    T
+    get() const
+    {
+#ifdef SPL_ENABLE_THREAD_AWARE
+      return myValue.load(::boost::memory_order_relaxed);
+#else
+      return myValue;
+#endif
+    }
+    void
+    set(const T value)
+    {
+#ifdef SPL_ENABLE_THREAD_AWARE
+      myValue.store(value, ::boost::memory_order_relaxed);
+#else
+      myValue = value;
+#endif
+    }
+
+  private:
+#ifdef SPL_ENABLE_THREAD_AWARE
+    ::boost::atomic< T> myValue;
+#else
+    T myValue;
+#endif
+  };
+
+struct LiveTimer
+{
+  LiveTimer()
+  {
+    min.set(::std::numeric_limits< double>::max());
+  }
+  TimerStats
+  snapshot() const
+  {
+    TimerStats stats;
+    stats.calls = calls.get();
+    stats.total = total.get();
+    stats.min = min.get();
+    stats.max = max.get();
+    return stats;
+  }
+
+  Relaxed< long long> calls;
+  Relaxed< double> total;
+  Relaxed< double> min;
+  Relaxed< double> max;
+};
+
+struct LiveHistogram
+{
+  typedef ::std::map< int, Relaxed< long long> > Bins;
+
+  LiveHistogram()
+  {
+    min.set(::std::numeric_limits< double>::max());
+    max.set(-::std::numeric_limits< double>::max());
+  }
+  HistogramStats
+  snapshot() const
+  {
+    HistogramStats stats;
+    stats.count = count.get();
+    stats.sum = sum.get();
+    stats.min = min.get();
+    stats.max = max.get();
+    BOOST_FOREACH(Bins::const_reference bin, bins)
+      stats.bins[bin.first] = bin.second.get();
+    return stats;
+  }
+
+  Relaxed< long long> count;
+  Relaxed< double> sum;
+  Relaxed< double> min;
+  Relaxed< double> max;
+  Bins bins;
+};
+
+// Values recorded by one thread, keyed by the address of the name literal so
+// that recording doesn't need to construct any strings.  Only the owning
+// thread records and it doesn't lock unless it adds a new name (or bin), the
+// mutex is there so that a report can walk the maps while they can't change
+// shape.  A report taken while a thread is recording may miss (part of) the
+// value being recorded.
+class Accumulator
+{
+public:
+  Accumulator()
+#ifdef SPL_ENABLE_THREAD_AWARE
+  :
+      myGeneration(generation.load(::boost::memory_order_relaxed))
+#endif
+  {
+  }
+
+  void
+  count(const char * const name, const long long n)
+  {
+    checkGeneration();
+    Relaxed< long long> & counter = findOrInsert(myCounters, name);
+    counter.set(counter.get() + n);
+  }
+  void
+  addTime(const char * const name, const double seconds)
+  {
+    checkGeneration();
+    LiveTimer & timer = findOrInsert(myTimers, name);
+    timer.calls.set(timer.calls.get() + 1);
+    timer.total.set(timer.total.get() + seconds);
+    timer.min.set(::std::min(timer.min.get(), seconds));
+    timer.max.set(::std::max(timer.max.get(), seconds));
+  }
+  void
+  sample(const char * const name, const double value)
+  {
+    checkGeneration();
+    LiveHistogram & histogram = findOrInsert(myHistograms, name);
+    histogram.count.set(histogram.count.get() + 1);
+    histogram.sum.set(histogram.sum.get() + value);
+    histogram.min.set(::std::min(histogram.min.get(), value));
+    histogram.max.set(::std::max(histogram.max.get(), value));
+
+    int bin = ::std::numeric_limits< int>::min();
+    if(value > 0.0)
+      ::std::frexp(value, &bin);
+    Relaxed< long long> & binCount = findOrInsert(histogram.bins, bin);
+    binCount.set(binCount.get() + 1);
+  }
+
+  void
+  mergeInto(Report * const report)
+  {
+#ifdef SPL_ENABLE_THREAD_AWARE
+    ::boost::mutex::scoped_lock lock(myMutex);
+    // Values from before a reset that the thread hasn't cleared yet
+    if(myGeneration != generation.load(::boost::memory_order_relaxed))
+      return;
+#endif
+    BOOST_FOREACH(Counters::const_reference c, myCounters)
+      report->counters[c.first] += c.second.get();
+    BOOST_FOREACH(Timers::const_reference t, myTimers)
+      report->timers[t.first].merge(t.second.snapshot());
+    BOOST_FOREACH(Histograms::const_reference h, myHistograms)
+      report->histograms[h.first].merge(h.second.snapshot());
+  }
+
+#ifndef SPL_ENABLE_THREAD_AWARE
+  void
+  clear()
+  {
+    myCounters.clear();
+    myTimers.clear();
+    myHistograms.clear();
+  }
+#endif
+
+private:
+  typedef ::std::map< const char *, Relaxed< long long> > Counters;
+  typedef ::std::map< const char *, LiveTimer> Timers;
+  typedef ::std::map< const char *, LiveHistogram> Histograms;
+
+  void
+  checkGeneration()
+  {
+#ifdef SPL_ENABLE_THREAD_AWARE
+    const unsigned int current = generation.load(::boost::memory_order_relaxed);
+    if(myGeneration == current)
+      return;
+
+    ::boost::mutex::scoped_lock lock(myMutex);
+    myCounters.clear();
+    myTimers.clear();
+    myHistograms.clear();
+    myGeneration = current;
+#endif
+  }
+
+  template< typename Map>
+    typename Map::mapped_type &
+    findOrInsert(Map & map, const typename Map::key_type & key)
+    {
+      // Only this thread inserts so finding doesn't need the lock
+      const typename Map::iterator it = map.find(key);
+      if(it != map.end())
+        return it->second;
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+      ::boost::mutex::scoped_lock lock(myMutex);
+#endif
+      return map.insert(
+          typename Map::value_type(key, typename Map::mapped_type())).first->second;
+    }
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+  ::boost::mutex myMutex;
+  unsigned int myGeneration;
+#endif
+  Counters myCounters;
+  Timers myTimers;
+  Histograms myHistograms;
+};
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+
+::boost::mutex accumulatorsMutex;
+// Values from threads that have finished
+Report retired;
+::std::set< Accumulator *> accumulators;
+
+void
+retireAccumulator(Accumulator * const accumulator)
+{
+  ::boost::mutex::scoped_lock lock(accumulatorsMutex);
+  accumulator->mergeInto(&retired);
+  accumulators.erase(accumulator);
+  delete accumulator;
+}
+
+::boost::thread_specific_ptr< Accumulator> threadAccumulator(
+    &retireAccumulator);
+
+Accumulator &
+getAccumulator()
+{
+  Accumulator * accumulator = threadAccumulator.get();
+  if(!accumulator)
+  {
+    accumulator = new Accumulator();
+    threadAccumulator.reset(accumulator);
+    ::boost::mutex::scoped_lock lock(accumulatorsMutex);
+    accumulators.insert(accumulator);
+  }
+  return *accumulator;
+}
+
+#else
+
+Accumulator accumulator;
+
+Accumulator &
+getAccumulator()
+{
+  return accumulator;
+}
+
+#endif
+
+double
+binUpperBound(const int bin)
+{
+  return bin == ::std::numeric_limits< int>::min() ? 0.0 :
+      ::std::ldexp(1.0, bin);
+}
+
+// Writes the report to the file given by the environment, if any, at exit
+class ExitReporter
+{
+public:
+  ~ExitReporter()
+  {
+    const char * const path = ::std::getenv("SPL_INSTRUMENTATION_REPORT");
+    if(!path)
+      return;
+
+    const ::std::string filename(path);
+    ::std::ofstream os(filename.c_str());
+    const Report report = getReport();
+    if(::boost::algorithm::iends_with(filename, ".yaml")
+        || ::boost::algorithm::iends_with(filename, ".yml"))
+      report.writeYaml(os);
+    else
+      report.writeJson(os);
+  }
+};
+
+// Must come after the accumulators so it's destroyed before them
+ExitReporter exitReporter;
+
+}
+
+void
+setEnabled(const bool enabled)
+{
+#ifdef SPL_ENABLE_THREAD_AWARE
+  detail::enabled.store(enabled, ::boost::memory_order_relaxed);
+#else
+  detail::enabled = enabled;
+#endif
+}
+
+void
+count(const char * const name, const long long n)
+{
+  if(isEnabled())
+    getAccumulator().count(name, n);
+}
+
+void
+addTime(const char * const name, const double seconds)
+{
+  if(isEnabled())
+    getAccumulator().addTime(name, seconds);
+}
+
+void
+sample(const char * const name, const double value)
+{
+  if(isEnabled())
+    getAccumulator().sample(name, value);
+}
+
+TimerStats::TimerStats() :
+    calls(0), total(0.0), min(::std::numeric_limits< double>::max()), max(
+        0.0)
+{
+}
+
+void
+TimerStats::add(const double seconds)
+{
+  ++calls;
+  total += seconds;
+  min = ::std::min(min, seconds);
+  max = ::std::max(max, seconds);
+}
+
+void
+TimerStats::merge(const TimerStats & other)
+{
+  calls += other.calls;
+  total += other.total;
+  min = ::std::min(min, other.min);
+  max = ::std::max(max, other.max);
+}
+
+HistogramStats::HistogramStats() :
+    count(0), sum(0.0), min(::std::numeric_limits< double>::max()), max(
+        -::std::numeric_limits< double>::max())
+{
+}
+
+void
+HistogramStats::add(const double value)
+{
+  ++count;
+  sum += value;
+  min = ::std::min(min, value);
+  max = ::std::max(max, value);
+
+  int bin = ::std::numeric_limits< int>::min();
+  if(value > 0.0)
+    ::std::frexp(value, &bin);
+  ++bins[bin];
+}
+
+void
+HistogramStats::merge(const HistogramStats & other)
+{
+  count += other.count;
+  sum += other.sum;
+  min = ::std::min(min, other.min);
+  max = ::std::max(max, other.max);
+  BOOST_FOREACH(Bins::const_reference bin, other.bins)
+    bins[bin.first] += bin.second;
+}
+
+void
+Report::writeJson(::std::ostream & os) const
+{
+  os << ::std::setprecision(9) << "{\n  \"counters\": {";
+  for(Counters::const_iterator it = counters.begin(); it != counters.end();
+      ++it)
+  {
+    os << (it == counters.begin() ? "\n" : ",\n") << "    \"" << it->first
+        << "\": " << it->second;
+  }
+  os << "\n  },\n  \"timers\": {";
+  for(Timers::const_iterator it = timers.begin(); it != timers.end(); ++it)
+  {
+    const TimerStats & t = it->second;
+    os << (it == timers.begin() ? "\n" : ",\n") << "    \"" << it->first
+        << "\": {\"calls\": " << t.calls << ", \"total_s\": " << t.total
+        << ", \"mean_s\": " << t.total / static_cast< double>(t.calls)
+        << ", \"min_s\": " << t.min << ", \"max_s\": " << t.max << "}";
+  }
+  os << "\n  },\n  \"histograms\": {";
+  for(Histograms::const_iterator it = histograms.begin();
+      it != histograms.end(); ++it)
+  {
+    const HistogramStats & h = it->second;
+    os << (it == histograms.begin() ? "\n" : ",\n") << "    \"" << it->first
+        << "\": {\"count\": " << h.count << ", \"sum\": " << h.sum
+        << ", \"mean\": " << h.sum / static_cast< double>(h.count)
+        << ", \"min\": " << h.min << ", \"max\": " << h.max << ", \"bins\": [";
+    for(HistogramStats::Bins::const_iterator bin = h.bins.begin();
+        bin != h.bins.end(); ++bin)
+    {
+      os << (bin == h.bins.begin() ? "" : ", ") << "{\"upper\": "
+          << binUpperBound(bin->first) << ", \"count\": " << bin->second
+          << "}";
+    }
+    os << "]}";
+  }
+  os << "\n  }\n}\n";
+}
+
+void
+Report::writeYaml(::std::ostream & os) const
+{
+  os << ::std::setprecision(9) << "counters:"
+      << (counters.empty() ? " {}\n" : "\n");
+  BOOST_FOREACH(Counters::const_reference c, counters)
+    os << "  " << c.first << ": " << c.second << "\n";
+
+  os << "timers:" << (timers.empty() ? " {}\n" : "\n");
+  BOOST_FOREACH(Timers::const_reference t, timers)
+  {
+    os << "  " << t.first << ":\n" << "    calls: " << t.second.calls
+        << "\n    total_s: " << t.second.total << "\n    mean_s: "
+        << t.second.total / static_cast< double>(t.second.calls)
+        << "\n    min_s: " << t.second.min << "\n    max_s: " << t.second.max
+        << "\n";
+  }
+
+  os << "histograms:" << (histograms.empty() ? " {}\n" : "\n");
+  BOOST_FOREACH(Histograms::const_reference h, histograms)
+  {
+    os << "  " << h.first << ":\n" << "    count: " << h.second.count
+        << "\n    sum: " << h.second.sum << "\n    mean: "
+        << h.second.sum / static_cast< double>(h.second.count) << "\n    min: " << h.second.min
+        << "\n    max: " << h.second.max << "\n    bins:\n";
+    BOOST_FOREACH(HistogramStats::Bins::const_reference bin, h.second.bins)
+    {
+      os << "      - {upper: " << binUpperBound(bin.first) << ", count: "
+          << bin.second << "}\n";
+    }
+  }
+}
+
+Report
+getReport()
+{
+  Report report;
+#ifdef SPL_ENABLE_THREAD_AWARE
+  ::boost::mutex::scoped_lock lock(accumulatorsMutex);
+  report = retired;
+  BOOST_FOREACH(Accumulator * const accumulator, accumulators)
+    accumulator->mergeInto(&report);
+#else
+  accumulator.mergeInto(&report);
+#endif
+  return report;
+}
+
+void
+reset()
+{
+#ifdef SPL_ENABLE_THREAD_AWARE
+  ::boost::mutex::scoped_lock lock(accumulatorsMutex);
+  retired = Report();
+  // Each thread clears its own values as they can't be changed under it
+  generation.fetch_add(1, ::boost::memory_order_relaxed);
+#else
+  accumulator.clear();
+#endif
+}
+
+ScopedTimer::ScopedTimer(const char * const name) :
+    myName(name), myEnabled(isEnabled())
+{
+  if(myEnabled)
+    myStart = ::boost::posix_time::microsec_clock::universal_time();
+}
+
+ScopedTimer::~ScopedTimer()
+{
+  if(myEnabled)
+  {
+    const ::boost::posix_time::time_duration elapsed =
+        ::boost::posix_time::microsec_clock::universal_time() - myStart;
+    getAccumulator().addTime(myName,
+        static_cast< double>(elapsed.total_microseconds()) * 1e-6);
+  }
+}
+
+}
+}
+}
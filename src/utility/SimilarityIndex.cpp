@@ -0,0 +1,433 @@
+/*
+ * SimilarityIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES /////////////////////////////////////
+#include "spl/utility/SimilarityIndex.h"
+
+#include <algorithm>
+
+#include <boost/foreach.hpp>
+#include <boost/ptr_container/ptr_map.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include "spl/common/Structure.h"
+#include "spl/utility/IStructureComparator.h"
+
+namespace spl {
+namespace utility {
+
+const size_t SimilarityIndex::MAX_LEAF_SIZE = 16;
+
+struct SimilarityIndex::Node
+{
+  Node() :
+      vantage(NULL), radius(0.0)
+  {
+  }
+
+  // Leaves have no vantage point and keep their entries in the bucket
+  Entry * vantage;
+  double radius;
+  // Entries at zero distance from the vantage point
+  ::std::vector< Entry *> duplicates;
+  // Entries within the radius of the vantage point
+  ::boost::scoped_ptr< Node> inside;
+  // Entries beyond the radius
+  ::boost::scoped_ptr< Node> outside;
+  ::std::vector< Entry *> bucket;
+};
+
+class SimilarityIndex::Partition : ::boost::noncopyable
+{
+public:
+  Partition(IBufferedComparator & comparator, const bool prune,
+      size_t & numComparisons) :
+      myComparator(comparator), myPrune(prune), myNumComparisons(
+          numComparisons), myNumErased(0), myRoot(new Node())
+  {
+  }
+
+  void
+  insert(const Id id, const ComparisonDataHandle & data)
+  {
+    Entry * const entry = new Entry();
+    entry->id = id;
+    entry->data = data;
+    entry->erased = false;
+    Id key = id;
+    myEntries.insert(key, entry);
+    insert(myRoot.get(), entry);
+  }
+
+  void
+  erase(const Id id)
+  {
+    const Entries::iterator it = myEntries.find(id);
+    SSLIB_ASSERT(it != myEntries.end());
+
+    it->second->erased = true;
+    ++myNumErased;
+    // Erased entries still cost comparisons when they are vantage points so
+    // rebuild once they make up more than half the partition
+    if(2 * myNumErased > myEntries.size())
+      rebuild();
+  }
+
+  size_t
+  size() const
+  {
+    return myEntries.size() - myNumErased;
+  }
+
+  // Add the matches in this partition to a max-heap of at most k matches
+  void
+  findNearest(const ComparisonDataHandle & query, const size_t k,
+      const double maxDistance, Matches * const best)
+  {
+    double tau = maxDistance;
+    search(*myRoot, query, k, maxDistance, best, &tau);
+  }
+
+private:
+  typedef ::boost::ptr_map< Id, Entry> Entries;
+
+  double
+  distance(const ComparisonDataHandle & data, const Entry & entry)
+  {
+    ++myNumComparisons;
+    return myComparator.compareStructures(data, entry.data);
+  }
+
+  void
+  insert(Node * node, Entry * const entry)
+  {
+    while(node->vantage)
+    {
+      const double d = distance(entry->data, *node->vantage);
+      if(d == 0.0)
+      {
+        node->duplicates.push_back(entry);
+        return;
+      }
+      ::boost::scoped_ptr< Node> & child =
+          d <= node->radius ? node->inside : node->outside;
+      if(!child)
+        child.reset(new Node());
+      node = child.get();
+    }
+    node->bucket.push_back(entry);
+    if(myPrune && node->bucket.size() > MAX_LEAF_SIZE)
+      split(node);
+  }
+
+  // Turn a leaf into an internal node splitting its entries about the median
+  // distance to the first of them
+  void
+  split(Node * const leaf)
+  {
+    Entry * const vantage = leaf->bucket.front();
+    ::std::vector< ::std::pair< double, Entry *> > dists;
+    dists.reserve(leaf->bucket.size() - 1);
+    for(size_t i = 1; i < leaf->bucket.size(); ++i)
+    {
+      const double d = distance(vantage->data, *leaf->bucket[i]);
+      if(d == 0.0)
+        leaf->duplicates.push_back(leaf->bucket[i]);
+      else
+        dists.push_back(::std::make_pair(d, leaf->bucket[i]));
+    }
+
+    leaf->vantage = vantage;
+    leaf->inside.reset(new Node());
+    leaf->outside.reset(new Node());
+    if(!dists.empty())
+    {
+      const size_t median = dists.size() / 2;
+      ::std::nth_element(dists.begin(), dists.begin() + median, dists.end());
+      leaf->radius = dists[median].first;
+      // Ties go inside so if the median is also the largest distance (many
+      // equidistant entries) shrink the radius to keep the outside non-empty.
+      // Everything after the median is >= it so only the part before needs
+      // to be looked at.
+      if(::std::find_if(dists.begin() + median + 1, dists.end(),
+          FurtherThan(leaf->radius)) == dists.end())
+      {
+        double below = 0.0;
+        for(size_t i = 0; i < median; ++i)
+        {
+          if(dists[i].first < leaf->radius)
+            below = ::std::max(below, dists[i].first);
+        }
+        // If everything is equidistant this leaves them all inside which is
+        // no worse than the leaf was
+        if(below > 0.0)
+          leaf->radius = below;
+      }
+    }
+    for(size_t i = 0; i < dists.size(); ++i)
+    {
+      if(dists[i].first <= leaf->radius)
+        leaf->inside->bucket.push_back(dists[i].second);
+      else
+        leaf->outside->bucket.push_back(dists[i].second);
+    }
+    ::std::vector< Entry *>().swap(leaf->bucket);
+  }
+
+  struct FurtherThan
+  {
+    explicit
+    FurtherThan(const double radius) :
+        radius(radius)
+    {
+    }
+    bool
+    operator ()(const ::std::pair< double, Entry *> & dist) const
+    {
+      return dist.first > radius;
+    }
+    double radius;
+  };
+
+  void
+  rebuild()
+  {
+    myRoot.reset(new Node());
+    for(Entries::iterator it = myEntries.begin(); it != myEntries.end();)
+    {
+      if(it->second->erased)
+        myEntries.erase(it++);
+      else
+        ++it;
+    }
+    myNumErased = 0;
+
+    for(Entries::iterator it = myEntries.begin(), end = myEntries.end();
+        it != end; ++it)
+      insert(myRoot.get(), it->second);
+  }
+
+  void
+  search(const Node & node, const ComparisonDataHandle & query,
+      const size_t k, const double maxDistance, Matches * const best,
+      double * const tau)
+  {
+    if(!node.vantage)
+    {
+      BOOST_FOREACH(const Entry * const entry, node.bucket)
+      {
+        if(!entry->erased)
+          consider(distance(query, *entry), entry->id, k, maxDistance, best,
+              tau);
+      }
+      return;
+    }
+
+    const double d = distance(query, *node.vantage);
+    if(!node.vantage->erased)
+      consider(d, node.vantage->id, k, maxDistance, best, tau);
+    // Duplicates of the vantage point are at the same distance
+    BOOST_FOREACH(const Entry * const entry, node.duplicates)
+    {
+      if(!entry->erased)
+        consider(d, entry->id, k, maxDistance, best, tau);
+    }
+
+    // Search the side the query is on first as it is likely to shrink tau.
+    // By the triangle inequality nothing inside can be within tau if
+    // d - tau > radius and nothing outside can be if d + tau <= radius.
+    if(d <= node.radius)
+    {
+      if(node.inside)
+        search(*node.inside, query, k, maxDistance, best, tau);
+      if(node.outside && d + *tau > node.radius)
+        search(*node.outside, query, k, maxDistance, best, tau);
+    }
+    else
+    {
+      if(node.outside)
+        search(*node.outside, query, k, maxDistance, best, tau);
+      if(node.inside && d - *tau <= node.radius)
+        search(*node.inside, query, k, maxDistance, best, tau);
+    }
+  }
+
+  static void
+  consider(const double d, const Id id, const size_t k,
+      const double maxDistance, Matches * const best, double * const tau)
+  {
+    if(d > maxDistance)
+      return;
+
+    if(best->size() < k)
+    {
+      best->push_back(Match(d, id));
+      ::std::push_heap(best->begin(), best->end());
+    }
+    else if(d < best->front().first)
+    {
+      ::std::pop_heap(best->begin(), best->end());
+      best->back() = Match(d, id);
+      ::std::push_heap(best->begin(), best->end());
+    }
+    if(best->size() == k)
+      *tau = ::std::min(maxDistance, best->front().first);
+  }
+
+  IBufferedComparator & myComparator;
+  const bool myPrune;
+  size_t & myNumComparisons;
+  Entries myEntries;
+  size_t myNumErased;
+  ::boost::scoped_ptr< Node> myRoot;
+};
+
+SimilarityIndex::SimilarityIndex(IStructureComparatorPtr comparator) :
+    myOwnedComparator(comparator), myComparator(
+        myOwnedComparator->generateBuffered()), myPrune(
+        myOwnedComparator->isMetric()), myNextId(0), myNumComparisons(0)
+{
+}
+
+SimilarityIndex::SimilarityIndex(const IStructureComparator & comparator) :
+    myComparator(comparator.generateBuffered()), myPrune(
+        comparator.isMetric()), myNextId(0), myNumComparisons(0)
+{
+}
+
+SimilarityIndex::~SimilarityIndex()
+{
+}
+
+SimilarityIndex::Id
+SimilarityIndex::insert(const common::Structure & structure)
+{
+  const Id id = myNextId++;
+  const common::AtomsFormula key = partitionKey(structure);
+  if(common::CompactFormula::fits(key))
+    insert(myPartitions, myIds, common::CompactFormula(key), id, structure);
+  else
+    insert(myLargePartitions, myLargeIds, key, id, structure);
+  return id;
+}
+
+bool
+SimilarityIndex::erase(const Id id)
+{
+  return erase(myPartitions, myIds, id)
+      || erase(myLargePartitions, myLargeIds, id);
+}
+
+void
+SimilarityIndex::clear()
+{
+  myPartitions.clear();
+  myLargePartitions.clear();
+  myIds.clear();
+  myLargeIds.clear();
+}
+
+size_t
+SimilarityIndex::size() const
+{
+  return myIds.size() + myLargeIds.size();
+}
+
+bool
+SimilarityIndex::empty() const
+{
+  return myIds.empty() && myLargeIds.empty();
+}
+
+SimilarityIndex::Matches
+SimilarityIndex::findNearest(const common::Structure & structure,
+    const size_t k, const double maxDistance)
+{
+  myNumComparisons = 0;
+  Matches best;
+  if(k == 0)
+    return best;
+
+  const common::AtomsFormula key = partitionKey(structure);
+  if(common::CompactFormula::fits(key))
+    findNearest(myPartitions, common::CompactFormula(key), structure, k,
+        maxDistance, &best);
+  else
+    findNearest(myLargePartitions, key, structure, k, maxDistance, &best);
+  ::std::sort_heap(best.begin(), best.end());
+  return best;
+}
+
+size_t
+SimilarityIndex::getNumComparisons() const
+{
+  return myNumComparisons;
+}
+
+common::AtomsFormula
+SimilarityIndex::partitionKey(const common::Structure & structure)
+{
+  common::AtomsFormula composition = structure.getComposition();
+  composition.reduce();
+  return composition;
+}
+
+template< typename Key>
+  void
+  SimilarityIndex::insert(::boost::ptr_map< Key, Partition> & partitions,
+      ::std::map< Id, Key> & ids, const Key & key, const Id id,
+      const common::Structure & structure)
+  {
+    typename ::boost::ptr_map< Key, Partition>::iterator it = partitions.find(
+        key);
+    if(it == partitions.end())
+    {
+      Key newKey = key;
+      it = partitions.insert(newKey,
+          new Partition(*myComparator, myPrune, myNumComparisons)).first;
+    }
+
+    it->second->insert(id, myComparator->generateComparisonData(structure));
+    ids[id] = key;
+  }
+
+template< typename Key>
+  bool
+  SimilarityIndex::erase(::boost::ptr_map< Key, Partition> & partitions,
+      ::std::map< Id, Key> & ids, const Id id)
+  {
+    const typename ::std::map< Id, Key>::iterator it = ids.find(id);
+    if(it == ids.end())
+      return false;
+
+    const typename ::boost::ptr_map< Key, Partition>::iterator partition =
+        partitions.find(it->second);
+    partition->second->erase(id);
+    if(partition->second->size() == 0)
+      partitions.erase(partition);
+    ids.erase(it);
+    return true;
+  }
+
+template< typename Key>
+  void
+  SimilarityIndex::findNearest(::boost::ptr_map< Key, Partition> & partitions,
+      const Key & key, const common::Structure & structure, const size_t k,
+      const double maxDistance, Matches * const best)
+  {
+    const typename ::boost::ptr_map< Key, Partition>::iterator it =
+        partitions.find(key);
+    if(it == partitions.end())
+      return;
+
+    best->reserve(k);
+    it->second->findNearest(myComparator->generateComparisonData(structure),
+        k, maxDistance, best);
+  }
+
+}
+}
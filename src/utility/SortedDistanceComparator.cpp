@@ -8,19 +8,22 @@
 // INCLUDES /////////////////////////////////////
 #include "spl/utility/SortedDistanceComparator.h"
 
+#include <cmath>
 #include <iterator>
+#include <limits>
 #include <memory>
 
 #include <boost/scoped_ptr.hpp>
 
 #include <armadillo>
 
-#include "spl/common/DistanceCalculator.h"
+#include "spl/common/GeometrySnapshot.h"
 #include "spl/common/Structure.h"
 #include "spl/common/UnitCell.h"
 #include "spl/math/NumberAlgorithms.h"
 #include "spl/math/RunningStats.h"
 #include "spl/utility/GenericBufferedComparator.h"
+#include "spl/utility/Instrumentation.h"
 
 #define SORTED_DIST_COMP_DEBUG (SSLIB_DEBUG & 0)
 
@@ -37,68 +40,59 @@ SortedDistanceComparisonData::SortedDistanceComparisonData(
     const common::Structure & structure, const bool volumeAgnostic,
     const bool usePrimitive, const double cutoffFactor)
 {
-  // This needs to be in this scope so it lasts until we return
-  common::StructurePtr primitive(new common::Structure(structure));
-  if(usePrimitive)
-    primitive->makePrimitive();
+  // Work on a snapshot of the geometry, this avoids copying the structure and
+  // the primitive cell comes from the original's symmetry cache
+  common::GeometrySnapshot geometry(structure, usePrimitive);
 
-  common::UnitCell * const unitCell = primitive->getUnitCell();
-  if(volumeAgnostic)
+  const common::UnitCell * const unitCell = geometry.getUnitCell();
+  if(volumeAgnostic && unitCell)
   {
     // If we are to be volume agnostic then set the volume to 1.0 per atom
-    const double scaleFactor = primitive->getNumAtoms() / unitCell->getVolume();
-    primitive->scale(scaleFactor);
+    geometry.scale(geometry.getNumAtoms() / unitCell->getVolume());
   }
 
   // Get the unit cell and number of atoms, need to do this as making the
   // structure primitive may have changed these so we need to store them
-  numAtoms = primitive->getNumAtoms();
+  numAtoms = geometry.getNumAtoms();
   if(unitCell)
   {
-    //::arma::vec3 diag = unitCell->getLongestDiagonal();
-    //const double longestDiag = sqrt(::arma::dot(diag, diag));
-    //cutoff = cutoffFactor * longestDiag;
-    unitCell->niggliReduce();
+    geometry.niggliReduce();
     cutoff = cutoffFactor * unitCell->getLongestCellVectorLength();
+    volume = unitCell->getVolume();
   }
   else
   {
     // No repetitions to worry about so consider all distances
     cutoff = std::numeric_limits< double>::max();
     // Try using the number of atoms as the volume: not great, but will do for now
-    volume = static_cast< double>(primitive->getNumAtoms());
+    volume = static_cast< double>(numAtoms);
   }
 
-  const common::DistanceCalculator & distCalc =
-      primitive->getDistanceCalculator();
-
   {
-    std::set< common::AtomSpeciesId::Value> speciesSet;
-    primitive->getAtomSpecies(::std::inserter(speciesSet, speciesSet.begin()));
-    const size_t numSpecies = speciesSet.size();
-    species.resize(numSpecies);
-    std::copy(speciesSet.begin(), speciesSet.end(), species.begin());
+    const std::set< common::AtomSpeciesId::Value> speciesSet(
+        geometry.getSpecies().begin(), geometry.getSpecies().end());
+    species.assign(speciesSet.begin(), speciesSet.end());
   }
 
   initSpeciesDistancesMap();
 
   // Calculate the distances ...
+  const common::GeometrySnapshot::SpeciesList & atomSpecies =
+      geometry.getSpecies();
   common::AtomSpeciesId::Value specI, specJ;
   DistancesVecPtr distVecIJ;
   for(size_t i = 0; i < numAtoms; ++i)
   {
-    const common::Atom & atomI = primitive->getAtom(i);
-    specI = atomI.getSpecies();
+    specI = atomSpecies[i];
     DistancesMap & iDistMap = speciesDistancesMap[specI];
 
     // Now to all the others
     for(size_t j = 0; j < numAtoms; ++j)
     {
-      const common::Atom & atomJ = primitive->getAtom(j);
-      specJ = atomJ.getSpecies();
+      specJ = atomSpecies[j];
       distVecIJ = iDistMap[specJ];
 
-      distCalc.getDistsBetween(atomI, atomJ, cutoff, *distVecIJ);
+      geometry.getDistsBetween(i, j, cutoff, *distVecIJ);
     }
   }
 
@@ -184,25 +178,45 @@ double
 SortedDistanceComparator::compareStructures(
     const SortedDistanceComparisonData & dist1,
     const SortedDistanceComparisonData & dist2) const
+{
+  return compare(dist1, dist2, std::numeric_limits< double>::infinity());
+}
+
+bool
+SortedDistanceComparator::areSimilar(const SortedDistanceComparisonData & dist1,
+    const SortedDistanceComparisonData & dist2) const
+{
+  return compare(dist1, dist2, myTolerance) < myTolerance;
+}
+
+SortedDistanceComparator::ComparisonDataPtr
+SortedDistanceComparator::generateComparisonData(
+    const spl::common::Structure & str) const
+{
+  const instrumentation::ScopedTimer timer(
+      "utility.SortedDistanceComparator.generateComparisonData");
+  return ComparisonDataPtr(
+      new SortedDistanceComparisonData(str, myScaleVolumes, myUsePrimitive,
+          myCutoffFactor));
+}
+
+boost::shared_ptr< SortedDistanceComparator::BufferedTyp>
+SortedDistanceComparator::generateBuffered() const
+{
+  return boost::shared_ptr< IBufferedComparator>(
+      new GenericBufferedComparator< SortedDistanceComparator>(*this));
+}
+
+double
+SortedDistanceComparator::compare(const SortedDistanceComparisonData & dist1,
+    const SortedDistanceComparisonData & dist2, const double threshold) const
 {
   typedef StridedIndexAdapter< size_t> IndexAdapter;
 
+  // The species are stored sorted and without repeats so they can be
+  // compared directly, without allocating
   const size_t numSpecies = dist1.species.size();
-  if(numSpecies != dist2.species.size())
-    return std::numeric_limits< double>::max(); // Species mismatch
-
-  std::set< std::string> speciesCheck(dist1.species.begin(),
-      dist1.species.end());
-  std::set< std::string>::const_iterator it;
-  BOOST_FOREACH(const std::string & species2, dist2.species)
-  {
-    it = speciesCheck.find(species2);
-    if(it == speciesCheck.end())
-      return std::numeric_limits< double>::max(); // Species mismatch
-    else
-      speciesCheck.erase(it);
-  }
-  if(!speciesCheck.empty())
+  if(dist1.species != dist2.species)
     return std::numeric_limits< double>::max(); // Species mismatch
 
   // Set up the adapters
@@ -211,9 +225,29 @@ SortedDistanceComparator::compareStructures(
   IndexAdapter adapt1(leastCommonMultiple / dist1.numAtoms);
   IndexAdapter adapt2(leastCommonMultiple / dist2.numAtoms);
 
-  spl::math::RunningStats stats;
+  // The final rms is over at most this many distances so once the sum of
+  // squares reaches threshold^2 * maxNum it can't end up below the threshold
+  size_t maxNum = 0;
   common::AtomSpeciesId::Value specI, specJ;
   for(size_t i = 0; i < numSpecies; ++i)
+  {
+    specI = dist1.species[i];
+    for(size_t j = i; j < numSpecies; ++j)
+    {
+      specJ = dist1.species[j];
+      maxNum += std::min(
+          adapt1.inv(dist1.speciesDistancesMap(specI)(specJ)->size()),
+          adapt2.inv(dist2.speciesDistancesMap(specI)(specJ)->size()));
+    }
+  }
+  const double maxSqSum =
+      maxNum == 0 ?
+          std::numeric_limits< double>::infinity() :
+          threshold * threshold * static_cast< double>(maxNum);
+
+  spl::math::RunningStats stats;
+  size_t numVisited = 0;
+  for(size_t i = 0; i < numSpecies; ++i)
   {
     specI = dist1.species[i];
 
@@ -222,46 +256,31 @@ SortedDistanceComparator::compareStructures(
         dist1.speciesDistancesMap(specI);
     const SortedDistanceComparisonData::DistancesMap & distMapI2 =
         dist2.speciesDistancesMap(specI);
-    for(size_t j = i; j < numSpecies; ++j)
+    for(size_t j = i; j < numSpecies && stats.sqSum() < maxSqSum; ++j)
     {
       specJ = dist1.species[j];
-      calcProperties(stats, *distMapI1(specJ), adapt1, *distMapI2(specJ),
-          adapt2);
+      numVisited += calcProperties(stats, *distMapI1(specJ), adapt1,
+          *distMapI2(specJ), adapt2, maxSqSum);
     }
   }
 
-  return stats.rms();
-}
+  if(maxNum != 0 && threshold != std::numeric_limits< double>::infinity())
+    instrumentation::sample(
+        "utility.SortedDistanceComparator.fractionSkipped",
+        1.0 - static_cast< double>(numVisited) / static_cast< double>(maxNum));
 
-bool
-SortedDistanceComparator::areSimilar(const SortedDistanceComparisonData & dist1,
-    const SortedDistanceComparisonData & dist2) const
-{
-  return compareStructures(dist1, dist2) < myTolerance;
-}
+  if(stats.sqSum() >= maxSqSum)
+    return std::sqrt(stats.sqSum() / static_cast< double>(maxNum));
 
-SortedDistanceComparator::ComparisonDataPtr
-SortedDistanceComparator::generateComparisonData(
-    const spl::common::Structure & str) const
-{
-  return ComparisonDataPtr(
-      new SortedDistanceComparisonData(str, myScaleVolumes, myUsePrimitive,
-          myCutoffFactor));
-}
-
-boost::shared_ptr< SortedDistanceComparator::BufferedTyp>
-SortedDistanceComparator::generateBuffered() const
-{
-  return boost::shared_ptr< IBufferedComparator>(
-      new GenericBufferedComparator< SortedDistanceComparator>(*this));
+  return stats.rms();
 }
 
-void
+size_t
 SortedDistanceComparator::calcProperties(spl::math::RunningStats & stats,
     const SortedDistanceComparator::DistancesVec & dist1,
     const StridedIndexAdapter< size_t> & adapt1,
     const SortedDistanceComparator::DistancesVec & dist2,
-    const StridedIndexAdapter< size_t> & adapt2) const
+    const StridedIndexAdapter< size_t> & adapt2, const double maxSqSum) const
 {
   const size_t maxIdx = std::min(adapt1.inv(dist1.size()),
       adapt2.inv(dist2.size()));
@@ -278,8 +297,16 @@ SortedDistanceComparator::calcProperties(spl::math::RunningStats & stats,
 #endif
     sum = d1 + d2;
     if(sum > 0.0)
+    {
       stats.insert(2.0 * std::abs(d1 - d2) / sum);
+      if(stats.sqSum() >= maxSqSum)
+        return i + 1;
+    }
   }
+  return maxIdx;
+}
+
+}
 }
 
 }
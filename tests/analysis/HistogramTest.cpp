@@ -0,0 +1,36 @@
+/*
+ * HistogramTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include <spl/analysis/Histogram.h>
+
+namespace ssa = ::spl::analysis;
+
+BOOST_AUTO_TEST_CASE(HistogramMerge)
+{
+  std::vector< double> values;
+  for(int i = 0; i < 100; ++i)
+    values.push_back(0.05 * static_cast< double>(i));
+
+  ssa::Histogram single(0.5), first(0.5), second(0.5);
+  single.insert(values.begin(), values.end());
+  first.insert(&values[0], 30);
+  second.insert(&values[30], values.size() - 30);
+  first.merge(second);
+
+  BOOST_REQUIRE_EQUAL(first.numBins(), single.numBins());
+  for(size_t i = 0; i < single.numBins(); ++i)
+    BOOST_CHECK_EQUAL(first.getFrequency(i), single.getFrequency(i));
+
+  ssa::Histogram other(0.25);
+  BOOST_CHECK_THROW(first.merge(other), std::invalid_argument);
+}
@@ -0,0 +1,73 @@
+/*
+ * RadialDistributionTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <cmath>
+#include <vector>
+
+#include <spl/analysis/RadialDistribution.h>
+#include <spl/common/Constants.h>
+#include <spl/common/Structure.h>
+#include <spl/common/UnitCell.h>
+
+namespace ssa = ::spl::analysis;
+namespace ssc = ::spl::common;
+
+BOOST_AUTO_TEST_CASE(RadialDistributionCsCl)
+{
+  static const double TOL = 1e-8; // Percent
+  static const double A = 2.0;
+
+  // CsCl structure: each atom has 8 of the other species at sqrt(3)A / 2 and
+  // 6 of its own at A
+  ssc::Structure structure;
+  structure.setUnitCell(ssc::UnitCell(A, A, A, 90.0, 90.0, 90.0));
+  structure.newAtom("Cs").setPosition(arma::zeros< arma::vec>(3));
+  structure.newAtom("Cl").setPosition(arma::ones< arma::vec>(3) * 0.5 * A);
+
+  ssa::RadialDistribution::Settings settings;
+  settings.cutoff = 2.5;
+  settings.binWidth = 0.1;
+  ssa::RadialDistribution rdf(settings);
+  rdf.add(structure);
+
+  BOOST_REQUIRE_EQUAL(rdf.getSpecies().size(), 2u);
+  BOOST_CHECK_EQUAL(rdf.getSpecies()[0], "Cl");
+  BOOST_CHECK_EQUAL(rdf.getSpecies()[1], "Cs");
+  BOOST_REQUIRE_EQUAL(rdf.numBins(), 25u);
+
+  const double volume = A * A * A;
+  const size_t unlikeBin = static_cast< size_t>(
+      std::sqrt(3.0) * 0.5 * A / settings.binWidth);
+  const size_t likeBin = static_cast< size_t>(A / settings.binWidth);
+  const double shell = 4.0 * ssc::constants::PI / 3.0
+      * (std::pow(settings.binWidth * (unlikeBin + 1), 3)
+          - std::pow(settings.binWidth * unlikeBin, 3));
+
+  // Both Cs->Cl and Cl->Cs pairs are counted
+  const ssa::RadialDistribution::Distribution unlike = rdf.getPartial(0, 1);
+  BOOST_CHECK_CLOSE(unlike[unlikeBin], 16.0 / (2.0 / volume * shell), TOL);
+  BOOST_CHECK_EQUAL(unlike[likeBin], 0.0);
+
+  const ssa::RadialDistribution::Distribution like = rdf.getPartial(1, 1);
+  BOOST_CHECK_EQUAL(like[unlikeBin], 0.0);
+  BOOST_CHECK(like[likeBin] > 0.0);
+
+  // Adding a batch of the same structure shouldn't change the average
+  ssa::RadialDistribution batchRdf(settings);
+  const std::vector< const ssc::Structure *> batch(3, &structure);
+  batchRdf.add(batch);
+  BOOST_CHECK_EQUAL(batchRdf.numStructures(), 3u);
+
+  const ssa::RadialDistribution::Distribution total = rdf.getTotal();
+  const ssa::RadialDistribution::Distribution batchTotal =
+      batchRdf.getTotal();
+  for(size_t i = 0; i < total.size(); ++i)
+    BOOST_CHECK_CLOSE(batchTotal[i], total[i], TOL);
+}
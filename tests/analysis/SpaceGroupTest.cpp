@@ -53,4 +53,28 @@ BOOST_AUTO_TEST_CASE(SpgTest)
   BOOST_CHECK_EQUAL(info.number, 136);
 }
 
+BOOST_AUTO_TEST_CASE(CachedDataset)
+{
+  io::ResReaderWriter resReader;
+  UniquePtr<common::Structure>::Type structure =
+      resReader.readStructure(io::ResourceLocator("Rutile.res"));
+  BOOST_REQUIRE(structure.get());
+
+  // Repeat queries at the same tolerance should be served from the cache
+  const common::SymmetryCache::Dataset * const dataset =
+      structure->getSymmetryDataset(0.01);
+  BOOST_REQUIRE(dataset);
+  BOOST_CHECK_EQUAL(dataset->spacegroupNumber, 136);
+  BOOST_CHECK_EQUAL(structure->getSymmetryDataset(0.01), dataset);
+  BOOST_CHECK_EQUAL(dataset->equivalentAtoms.size(),
+      structure->getNumAtoms());
+
+  // Displacing an atom should break the symmetry
+  common::Atom & atom = structure->getAtom(0);
+  atom.setPosition(atom.getPosition() + arma::vec3("0.1 0.05 0.03"));
+  analysis::space_group::SpacegroupInfo info;
+  BOOST_REQUIRE(analysis::space_group::getSpacegroupInfo(info, *structure));
+  BOOST_CHECK_NE(info.number, 136);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+/*
+ * StructureTriangulationTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#ifdef SPL_USE_CGAL
+
+#include <vector>
+
+#include <armadillo>
+
+#include <spl/analysis/StructureTriangulation.h>
+#include <spl/common/Structure.h>
+#include <spl/common/UnitCell.h>
+
+namespace ssa = spl::analysis;
+namespace ssc = spl::common;
+
+namespace {
+
+// Body centred cubic where every atom has 8 nearest and 6 next nearest
+// Delaunay neighbours
+ssc::Structure
+bcc(const arma::vec3 & shift0, const arma::vec3 & shift1)
+{
+  static const double A = 3.0;
+
+  ssc::Structure structure(ssc::UnitCell(A, A, A, 90.0, 90.0, 90.0));
+  arma::vec3 pos;
+  pos.fill(0.1);
+  structure.newAtom("Fe").setPosition((pos + shift0) * A);
+  pos.fill(0.6);
+  structure.newAtom("Fe").setPosition((pos + shift1) * A);
+  return structure;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(StructureTriangulations)
+
+BOOST_AUTO_TEST_CASE(AtomsOutsideCellTest)
+{
+  static const int BCC_COORDINATION = 14;
+
+  const arma::vec3 zero = arma::zeros< arma::vec>(3);
+  arma::vec3 shift0, shift1;
+  shift0 << 1.0 << -1.0 << 2.0;
+  shift1 << -2.0 << 1.0 << 0.0;
+
+  const ssc::Structure inside = bcc(zero, zero);
+  // Same structure but with the atoms given outside [0, 1)
+  const ssc::Structure outside = bcc(shift0, shift1);
+
+  const ssa::StructureTriangulation fullInside(inside);
+  const ssa::StructureTriangulation fullOutside(outside);
+  // The longest Delaunay edge in bcc is the lattice parameter
+  const ssa::StructureTriangulation skinInside(inside, 4.0);
+  const ssa::StructureTriangulation skinOutside(outside, 4.0);
+
+  const std::vector< int> expected(2, BCC_COORDINATION);
+  const std::vector< int> coords[] =
+    { fullInside.getCoordinations(), fullOutside.getCoordinations(),
+        skinInside.getCoordinations(), skinOutside.getCoordinations() };
+  for(size_t i = 0; i < 4; ++i)
+    BOOST_CHECK(coords[i] == expected);
+
+  for(size_t i = 0; i < outside.getNumAtoms(); ++i)
+  {
+    BOOST_CHECK_EQUAL(fullOutside.getCoordination(outside.getAtom(i)),
+        BCC_COORDINATION);
+    BOOST_CHECK_EQUAL(skinOutside.getCoordination(outside.getAtom(i)),
+        BCC_COORDINATION);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif /* SPL_USE_CGAL */
@@ -8,6 +8,8 @@
 // INCLUDES //////////////////////////////////
 #include "sslibtest.h"
 
+#include <map>
+#include <string>
 #include <vector>
 #include <iostream>
 
@@ -83,7 +85,7 @@ BOOST_AUTO_TEST_CASE(ExtrusionTest)
     }
 
     ssbc::SeparationData sepData(structure);
-    sepData.separations.fill(minsep);
+    sepData.setUniformSeparation(minsep);
     extruded = separator.separatePoints(&sepData);
 
     if(extruded)
@@ -112,4 +114,36 @@ BOOST_AUTO_TEST_CASE(ExtrusionTest)
   }
 }
 
+BOOST_AUTO_TEST_CASE(SeparationsFromLabels)
+{
+  typedef spl::utility::OrderedPair< std::string> LabelPair;
+
+  ssc::Structure structure;
+  std::vector< std::string> labels;
+  labels.push_back("A");
+  labels.push_back("B");
+  labels.push_back("A");
+  labels.push_back("C");
+  for(size_t i = 0; i < labels.size(); ++i)
+    structure.newAtom(labels[i]);
+
+  std::map< LabelPair, double> sepList;
+  sepList[LabelPair("A", "A")] = 1.0;
+  sepList[LabelPair("A", "B")] = 2.0;
+
+  ssbc::SeparationData sepData(structure);
+  sepData.setSeparationsFromLabels(labels, sepList);
+
+  // Only one type per distinct label
+  BOOST_CHECK_EQUAL(sepData.typeSeparations.n_rows, 3u);
+  BOOST_CHECK_EQUAL(sepData.getSeparation(0, 2), 1.0);
+  BOOST_CHECK_EQUAL(sepData.getSeparation(1, 0), 2.0);
+  BOOST_CHECK_EQUAL(sepData.getSeparation(2, 1), 2.0);
+  BOOST_CHECK_EQUAL(sepData.getSeparation(3, 0), 0.0);
+
+  sepData.setSeparation(3, 0, 5.0);
+  BOOST_CHECK_EQUAL(sepData.getSeparation(0, 3), 5.0);
+  BOOST_CHECK_EQUAL(sepData.getSeparation(3, 2), 0.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
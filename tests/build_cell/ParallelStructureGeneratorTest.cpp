@@ -0,0 +1,67 @@
+/*
+ * ParallelStructureGeneratorTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <spl/build_cell/ParallelStructureGenerator.h>
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+
+#include <spl/build_cell/AtomsDescription.h>
+#include <spl/build_cell/AtomsGroup.h>
+#include <spl/build_cell/StructureBuilder.h>
+#include <spl/common/AtomSpeciesDatabase.h>
+#include <spl/common/Structure.h>
+#include <spl/common/Types.h>
+
+namespace ssbc = ::spl::build_cell;
+namespace ssc = ::spl::common;
+
+BOOST_AUTO_TEST_CASE(ParallelStructureGeneratorTest)
+{
+  static const size_t NUM_STRUCTURES = 20;
+  static const unsigned int NUM_ATOMS = 6;
+
+  ssbc::StructureBuilder builder;
+  {
+    ::spl::UniquePtr< ssbc::AtomsGroup>::Type atoms(new ssbc::AtomsGroup());
+    atoms->insertAtoms(ssbc::AtomsDescription("Na", NUM_ATOMS / 2));
+    atoms->insertAtoms(ssbc::AtomsDescription("Cl", NUM_ATOMS / 2));
+    builder.addGenerator(atoms);
+  }
+
+  const ssc::AtomSpeciesDatabase speciesDb;
+  ssbc::ParallelStructureGenerator::Settings settings;
+  settings.numWorkers = 3;
+  settings.queueCapacity = 4;
+  settings.numStructures = NUM_STRUCTURES;
+
+  ssbc::ParallelStructureGenerator generator(builder, speciesDb, settings);
+  generator.start();
+
+  size_t numReceived = 0;
+  ssc::StructurePtr structure;
+  while(generator.pop(structure))
+  {
+    BOOST_REQUIRE(structure.get());
+    BOOST_CHECK_EQUAL(structure->getNumAtoms(), NUM_ATOMS);
+    ++numReceived;
+  }
+  BOOST_CHECK_EQUAL(numReceived, NUM_STRUCTURES);
+
+  const ssbc::ParallelStructureGenerator::Stats stats = generator.getStats();
+  BOOST_CHECK_EQUAL(stats.successes, NUM_STRUCTURES);
+  BOOST_CHECK_EQUAL(stats.abandoned, 0u);
+  size_t numFailures = 0;
+  for(ssbc::ParallelStructureGenerator::Stats::Failures::const_iterator it =
+      stats.failures.begin(); it != stats.failures.end(); ++it)
+    numFailures += it->second;
+  BOOST_CHECK_EQUAL(stats.attempts, stats.successes + numFailures);
+}
+
+#endif // SPL_ENABLE_THREAD_AWARE
@@ -0,0 +1,67 @@
+/*
+ * CompactFormulaTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <stdexcept>
+
+#include <spl/common/AtomsFormula.h>
+#include <spl/common/CompactFormula.h>
+
+namespace ssc = ::spl::common;
+
+BOOST_AUTO_TEST_CASE(CompactFormulaTest)
+{
+  ssc::AtomsFormula formula;
+  BOOST_REQUIRE(formula.fromString("Na4Cl4"));
+
+  ssc::CompactFormula compact(formula);
+  BOOST_REQUIRE(compact.numSpecies() == 2);
+  BOOST_REQUIRE(compact.total() == 8);
+  BOOST_REQUIRE(compact.numberOf(ssc::CompactFormula::intern("Na")) == 4);
+
+  BOOST_REQUIRE(compact.reduce() == 4);
+  BOOST_REQUIRE(compact.toString() == "ClNa");
+
+  ssc::AtomsFormula reduced;
+  reduced.fromString("NaCl");
+  const ssc::CompactFormula compactReduced(reduced);
+  BOOST_REQUIRE(compact == compactReduced);
+  BOOST_REQUIRE(compact.hash() == compactReduced.hash());
+  BOOST_REQUIRE(!(compact < compactReduced) && !(compactReduced < compact));
+
+  compact += compactReduced;
+  BOOST_REQUIRE(compact != compactReduced);
+  BOOST_REQUIRE(compact.toFormula().toString() == "Cl2Na2");
+}
+
+BOOST_AUTO_TEST_CASE(CompactFormulaTooManySpecies)
+{
+  static const char * const SPECIES[] =
+    { "H", "He", "Li", "Be", "B", "C", "N", "O", "F" };
+
+  ssc::AtomsFormula formula;
+  for(size_t i = 0; i < ssc::CompactFormula::MAX_SPECIES; ++i)
+    formula += ssc::AtomsFormula(SPECIES[i], 1);
+  BOOST_REQUIRE(ssc::CompactFormula::fits(formula));
+  const ssc::CompactFormula full(formula);
+  BOOST_REQUIRE(full.numSpecies()
+      == static_cast< int>(ssc::CompactFormula::MAX_SPECIES));
+
+  // One more species than will fit mustn't be silently dropped
+  formula += ssc::AtomsFormula(SPECIES[ssc::CompactFormula::MAX_SPECIES], 1);
+  BOOST_REQUIRE(!ssc::CompactFormula::fits(formula));
+  BOOST_CHECK_THROW(ssc::CompactFormula compact(formula), std::length_error);
+
+  ssc::CompactFormula sum(full);
+  const ssc::CompactFormula extra(
+      ssc::AtomsFormula(SPECIES[ssc::CompactFormula::MAX_SPECIES], 1));
+  BOOST_CHECK_THROW(sum += extra, std::length_error);
+  // and is left unchanged
+  BOOST_REQUIRE(sum == full);
+}
@@ -8,16 +8,19 @@
 // INCLUDES //////////////////////////////////
 #include "sslibtest.h"
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/variant/static_visitor.hpp>
 
 #include <armadillo>
 
 #include <spl/build_cell/GenerationOutcome.h>
 #include <spl/build_cell/RandomUnitCellGenerator.h>
 #include <spl/common/Atom.h>
+#include <spl/common/DistanceCalculatorDelegator.h>
 #include <spl/common/OrthoCellDistanceCalculator.h>
 #include <spl/common/ReferenceDistanceCalculator.h>
 #include <spl/common/Structure.h>
@@ -365,4 +368,152 @@ BOOST_AUTO_TEST_CASE(DistanceComparisonPathological)
   }
 }
 
+BOOST_AUTO_TEST_CASE(SkewedCellMinImage)
+{
+  // SETTINGS ////////////////
+  const size_t numAtoms = 10;
+  const double tolerance = 1e-10;
+
+  // A very skewed basis for what is really a simple cubic lattice
+  arma::mat33 orthoMtx;
+  orthoMtx << 1.0 << 5.0 << 3.0 << arma::endr << 0.0 << 1.0 << 7.0
+      << arma::endr << 0.0 << 0.0 << 1.0 << arma::endr;
+
+  ssc::Structure structure;
+  structure.setUnitCell(ssc::UnitCell(orthoMtx));
+  for(size_t i = 0; i < numAtoms; ++i)
+    structure.newAtom("Na").setPosition(structure.getUnitCell()->randomPoint());
+
+  ssc::UniversalCrystalDistanceCalculator univCalc(structure.getUnitCell());
+  ssc::ReferenceDistanceCalculator referenceCalc(*structure.getUnitCell());
+
+  for(size_t i = 0; i < numAtoms; ++i)
+  {
+    const ssc::Atom & atom1 = structure.getAtom(i);
+    for(size_t j = i; j < numAtoms; ++j)
+    {
+      const ssc::Atom & atom2 = structure.getAtom(j);
+      const double univDistSq = univCalc.getDistSqMinImg(atom1, atom2);
+      BOOST_REQUIRE(ssu::stable::eq(univDistSq,
+          referenceCalc.getDistSqMinImg(atom1, atom2), tolerance));
+      // The minimum image in the cubic lattice can't be longer than half the
+      // body diagonal
+      BOOST_REQUIRE(univDistSq <= 0.75 + tolerance);
+    }
+  }
+}
+
+// Sums the minimum image distances between all pairs using whatever calculator
+// the visit gives us
+struct SumMinImgDistsSq : public boost::static_visitor< double>
+{
+  SumMinImgDistsSq(const arma::mat & positions) :
+      myPositions(positions)
+  {
+  }
+
+  template< class DistCalc>
+    double
+    operator()(const DistCalc & distCalc) const
+    {
+      double sum = 0.0;
+      for(size_t i = 0; i < myPositions.n_cols; ++i)
+      {
+        for(size_t j = i + 1; j < myPositions.n_cols; ++j)
+          sum += distCalc.getDistSqMinImg(myPositions.col(i),
+              myPositions.col(j));
+      }
+      return sum;
+    }
+
+private:
+  const arma::mat & myPositions;
+};
+
+BOOST_AUTO_TEST_CASE(StaticVisitorMatchesVirtual)
+{
+  // SETTINGS ////////////////
+  const size_t numAtoms = 20;
+  const double tolerance = 1e-10;
+
+  ssc::Structure structure;
+  for(size_t i = 0; i < numAtoms; ++i)
+    structure.newAtom("Na").setPosition(arma::randu< arma::vec>(3) * 5.0);
+
+  // Cluster, orthogonal and general cells in turn
+  for(size_t cellType = 0; cellType < 3; ++cellType)
+  {
+    if(cellType == 1)
+      structure.setUnitCell(ssc::UnitCell(3.0, 4.0, 5.0, 90.0, 90.0, 90.0));
+    else if(cellType == 2)
+      structure.setUnitCell(ssc::UnitCell(3.0, 4.0, 5.0, 70.0, 80.0, 100.0));
+
+    arma::mat positions;
+    structure.getAtomPositions(positions);
+    const ssc::DistanceCalculator & distCalc = structure.getDistanceCalculator();
+
+    double expected = 0.0;
+    for(size_t i = 0; i < numAtoms; ++i)
+    {
+      for(size_t j = i + 1; j < numAtoms; ++j)
+        expected += distCalc.getDistSqMinImg(positions.col(i),
+            positions.col(j));
+    }
+
+    SumMinImgDistsSq sumDists(positions);
+    const double sum = ssc::visitDistanceCalculator(distCalc, sumDists);
+    BOOST_REQUIRE(ssu::stable::eq(sum, expected, tolerance));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(IndexQueriesMatchPositionQueries)
+{
+  // SETTINGS ////////////////
+  const size_t numAtoms = 15;
+  const double cutoff = 6.0;
+  const double tolerance = 1e-10;
+
+  ssc::Structure structure;
+  for(size_t i = 0; i < numAtoms; ++i)
+    structure.newAtom("Na").setPosition(arma::randu< arma::vec>(3) * 12.0);
+
+  std::vector< double> byIndex, byPosition;
+  for(size_t cellType = 0; cellType < 3; ++cellType)
+  {
+    if(cellType == 1)
+      structure.setUnitCell(ssc::UnitCell(3.0, 4.0, 5.0, 90.0, 90.0, 90.0));
+    else if(cellType == 2)
+      structure.setUnitCell(ssc::UnitCell(3.0, 4.0, 5.0, 70.0, 80.0, 100.0));
+
+    // Move an atom after the wrapped positions have been built to make sure
+    // they get invalidated
+    structure.getDistanceCalculator().getWrappedPositions();
+    structure.getAtom(0).setPosition(arma::randu< arma::vec>(3) * 12.0);
+
+    const ssc::DistanceCalculatorDelegator & distCalc =
+        structure.getDistanceCalculator();
+    for(size_t i = 0; i < numAtoms; ++i)
+    {
+      const arma::vec3 posI = structure.getAtom(i).getPosition();
+      for(size_t j = 0; j < numAtoms; ++j)
+      {
+        const arma::vec3 posJ = structure.getAtom(j).getPosition();
+        BOOST_REQUIRE(
+            ssu::stable::eq(distCalc.getDistSqMinImg(i, j),
+                distCalc.getDistSqMinImg(posI, posJ), tolerance));
+
+        byIndex.clear();
+        byPosition.clear();
+        distCalc.getDistsBetween(i, j, cutoff, byIndex);
+        distCalc.getDistsBetween(posI, posJ, cutoff, byPosition);
+        BOOST_REQUIRE_EQUAL(byIndex.size(), byPosition.size());
+        std::sort(byIndex.begin(), byIndex.end());
+        std::sort(byPosition.begin(), byPosition.end());
+        for(size_t k = 0; k < byIndex.size(); ++k)
+          BOOST_REQUIRE(ssu::stable::eq(byIndex[k], byPosition[k], tolerance));
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+/*
+ * GeometrySnapshotTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <armadillo>
+
+#include <spl/common/GeometrySnapshot.h>
+#include <spl/common/Structure.h>
+#include <spl/common/UnitCell.h>
+
+namespace ssc = spl::common;
+
+BOOST_AUTO_TEST_SUITE(GeometrySnapshots)
+
+BOOST_AUTO_TEST_CASE(DistancesTest)
+{
+  static const double CUTOFF = 6.0;
+
+  ssc::Structure structure(ssc::UnitCell(3.0, 4.0, 5.0, 70.0, 80.0, 100.0));
+  for(size_t i = 0; i < 4; ++i)
+    structure.newAtom(i % 2 ? "Na" : "Cl").setPosition(
+        arma::randu< arma::vec>(3) * 10.0);
+
+  ssc::GeometrySnapshot snapshot(structure);
+  BOOST_REQUIRE(snapshot.getNumAtoms() == structure.getNumAtoms());
+  // Reducing the cell must not change any of the distances
+  snapshot.niggliReduce();
+
+  std::vector< double> expected, actual;
+  for(size_t i = 0; i < structure.getNumAtoms(); ++i)
+  {
+    BOOST_REQUIRE(snapshot.getSpecies()[i] == structure.getAtom(i).getSpecies());
+    for(size_t j = 0; j < structure.getNumAtoms(); ++j)
+    {
+      expected.clear();
+      actual.clear();
+      structure.getDistanceCalculator().getDistsBetween(i, j, CUTOFF,
+          expected);
+      snapshot.getDistsBetween(i, j, CUTOFF, actual);
+      BOOST_REQUIRE(expected.size() == actual.size());
+
+      std::sort(expected.begin(), expected.end());
+      std::sort(actual.begin(), actual.end());
+      for(size_t k = 0; k < expected.size(); ++k)
+        BOOST_REQUIRE_CLOSE(expected[k], actual[k], 1e-6);
+    }
+  }
+
+  // Scaling keeps fractional positions
+  const double volume = structure.getUnitCell()->getVolume();
+  snapshot.scale(2.0);
+  BOOST_REQUIRE_CLOSE(snapshot.getUnitCell()->getVolume(), 2.0 * volume,
+      1e-6);
+  // The original is untouched
+  BOOST_REQUIRE_CLOSE(structure.getUnitCell()->getVolume(), volume, 1e-6);
+}
+
+BOOST_AUTO_TEST_CASE(PrimitiveTest)
+{
+  static const double A = 3.0;
+
+  // CsCl in a cell doubled along a
+  ssc::Structure doubled(ssc::UnitCell(2.0 * A, A, A, 90.0, 90.0, 90.0));
+  for(size_t i = 0; i < 2; ++i)
+  {
+    arma::vec3 pos;
+    pos.zeros();
+    pos(0) = i * A;
+    doubled.newAtom("Cs").setPosition(pos);
+    pos.fill(0.5 * A);
+    pos(0) += i * A;
+    doubled.newAtom("Cl").setPosition(pos);
+  }
+
+  const ssc::GeometrySnapshot full(doubled);
+  BOOST_REQUIRE(full.getNumAtoms() == 4);
+
+  const ssc::GeometrySnapshot primitive(doubled, true);
+  BOOST_REQUIRE(primitive.getNumAtoms() == 2);
+  BOOST_REQUIRE_CLOSE(primitive.getUnitCell()->getVolume(), A * A * A, 1e-6);
+  BOOST_REQUIRE_CLOSE(
+      primitive.getDistanceCalculator().getDistMinImg(
+          primitive.getPositions().unsafe_col(0),
+          primitive.getPositions().unsafe_col(1)), 0.5 * std::sqrt(3.0) * A,
+      1e-6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,105 @@
+/*
+ * StructureNeighboursTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <armadillo>
+
+#include <spl/common/Atom.h>
+#include <spl/common/Structure.h>
+#include <spl/math/Random.h>
+
+namespace ssc = spl::common;
+namespace ssm = spl::math;
+
+namespace {
+
+void
+bruteForceNeighbours(const ssc::Structure & structure,
+    const arma::vec3 & point, const double radius,
+    std::vector< size_t> * const neighbours)
+{
+  for(size_t i = 0; i < structure.getNumAtoms(); ++i)
+  {
+    const arma::vec3 dr = structure.getAtom(i).getPosition() - point;
+    if(arma::dot(dr, dr) <= radius * radius)
+      neighbours->push_back(i);
+  }
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(StructureNeighbours)
+
+BOOST_AUTO_TEST_CASE(ClusterQueries)
+{
+  const size_t numAtoms = 500;
+  const size_t numQueries = 50;
+  const double boxSize = 20.0;
+
+  ssc::Structure structure;
+  for(size_t i = 0; i < numAtoms; ++i)
+  {
+    arma::vec3 pos;
+    for(size_t d = 0; d < 3; ++d)
+      pos(d) = ssm::randu(0.0, boxSize);
+    structure.newAtom("Na").setPosition(pos);
+  }
+
+  std::vector< size_t> expected, found;
+  for(size_t q = 0; q < numQueries; ++q)
+  {
+    // Move an atom each time so the index has to be rebuilt
+    const size_t moved = ssm::randu< size_t>(numAtoms - 1);
+    arma::vec3 pos;
+    for(size_t d = 0; d < 3; ++d)
+      pos(d) = ssm::randu(0.0, boxSize);
+    structure.getAtom(moved).setPosition(pos);
+
+    const double radius = ssm::randu(0.0, 0.5 * boxSize);
+    expected.clear();
+    found.clear();
+    bruteForceNeighbours(structure, pos, radius, &expected);
+    BOOST_REQUIRE_EQUAL(structure.getNeighbours(pos, radius, &found),
+        expected.size());
+    std::sort(found.begin(), found.end());
+    BOOST_REQUIRE(found == expected);
+
+    // Around the moved atom itself, which should be excluded
+    found.clear();
+    structure.getNeighbours(moved, radius, &found);
+    BOOST_REQUIRE_EQUAL(found.size(), expected.size() - 1);
+    BOOST_REQUIRE(std::find(found.begin(), found.end(), moved) == found.end());
+
+    // Nearest neighbours should come back in order of distance
+    const size_t k = ssm::randu< size_t>(1, 20);
+    found.clear();
+    BOOST_REQUIRE_EQUAL(structure.getNearestNeighbours(moved, k, &found), k);
+    std::vector< double> distsSq;
+    for(size_t i = 0; i < found.size(); ++i)
+    {
+      const arma::vec3 dr = structure.getAtom(found[i]).getPosition() - pos;
+      distsSq.push_back(arma::dot(dr, dr));
+      if(i > 0)
+        BOOST_REQUIRE_LE(distsSq[i - 1], distsSq[i]);
+    }
+    // and nothing that wasn't returned may be closer than the furthest one
+    for(size_t i = 0; i < numAtoms; ++i)
+    {
+      if(i == moved || std::find(found.begin(), found.end(), i) != found.end())
+        continue;
+      const arma::vec3 dr = structure.getAtom(i).getPosition() - pos;
+      BOOST_REQUIRE_GE(arma::dot(dr, dr), distsSq.back());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
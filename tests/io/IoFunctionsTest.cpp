@@ -0,0 +1,115 @@
+/*
+ * IoFunctionsTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/lexical_cast.hpp>
+
+#include <spl/io/IoFunctions.h>
+
+namespace ssio = ::spl::io;
+
+namespace {
+
+std::vector< double>
+testNumbers()
+{
+  static const double SPECIAL[] =
+    { 0.0, 0.5, 1.0, 0.125, 0.375, 2.5, 9.9999999999, 0.1, 1.0 / 3.0, 2.0
+        / 3.0, 123456.789, 1e-30, 1e-9, 4.2e-5, 1e10, 1e15, 1e20, 1e300,
+        std::numeric_limits< double>::denorm_min(), std::numeric_limits<
+            double>::infinity() };
+
+  std::vector< double> numbers(SPECIAL, SPECIAL + sizeof(SPECIAL)
+      / sizeof(SPECIAL[0]));
+  // Values across a range of magnitudes with a spread of last digits
+  unsigned long state = 12345;
+  for(int exponent = -12; exponent <= 18; ++exponent)
+  {
+    for(int i = 0; i < 50; ++i)
+    {
+      state = state * 1103515245ul + 12345ul;
+      const double mantissa = static_cast< double>((state >> 8) % 1000000)
+          / 100000.0;
+      numbers.push_back(mantissa * std::pow(10.0, exponent));
+    }
+  }
+  // and with both signs
+  const size_t numPositive = numbers.size();
+  for(size_t i = 0; i < numPositive; ++i)
+    numbers.push_back(-numbers[i]);
+  numbers.push_back(std::numeric_limits< double>::quiet_NaN());
+  return numbers;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IoFunctions)
+
+BOOST_AUTO_TEST_CASE(AppendFixedTest)
+{
+  const std::vector< double> numbers = testNumbers();
+  std::string buffer;
+  for(unsigned int digits = 0; digits <= 12; ++digits)
+  {
+    for(size_t i = 0; i < numbers.size(); ++i)
+    {
+      buffer.clear();
+      ssio::appendFixed(&buffer, numbers[i], digits);
+      BOOST_REQUIRE_EQUAL(buffer, ssio::toString(numbers[i], digits));
+    }
+  }
+
+  // Appends rather than replaces
+  buffer = "x=";
+  ssio::appendFixed(&buffer, -1.5, 2);
+  BOOST_REQUIRE_EQUAL(buffer, "x=" + ssio::toString(-1.5, 2));
+}
+
+BOOST_AUTO_TEST_CASE(AppendGeneralTest)
+{
+  const std::vector< double> numbers = testNumbers();
+  std::string buffer;
+  for(int precision = 0; precision <= 17; ++precision)
+  {
+    for(size_t i = 0; i < numbers.size(); ++i)
+    {
+      std::ostringstream ss;
+      ss << std::setprecision(precision) << numbers[i];
+
+      buffer.clear();
+      ssio::appendGeneral(&buffer, numbers[i], precision);
+      BOOST_REQUIRE_EQUAL(buffer, ss.str());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AppendUnsignedTest)
+{
+  static const unsigned long NUMBERS[] =
+    { 0ul, 1ul, 9ul, 10ul, 99ul, 100ul, 4294967295ul, std::numeric_limits<
+        unsigned long>::max() };
+
+  std::string buffer;
+  for(size_t i = 0; i < sizeof(NUMBERS) / sizeof(NUMBERS[0]); ++i)
+  {
+    buffer.clear();
+    ssio::appendUnsigned(&buffer, NUMBERS[i]);
+    BOOST_REQUIRE_EQUAL(buffer,
+        boost::lexical_cast< std::string>(NUMBERS[i]));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
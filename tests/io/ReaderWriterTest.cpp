@@ -9,9 +9,12 @@
 #include "sslibtest.h"
 
 #include <iterator>
+#include <sstream>
 
 #include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
 #include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
 
 #include <spl/common/AtomSpeciesId.h>
 #include <spl/common/Structure.h>
@@ -21,6 +24,7 @@
 #include <spl/io/InfoLine.h>
 #include <spl/io/ResourceLocator.h>
 #include <spl/io/ResReaderWriter.h>
+#include <spl/io/SplIndex.h>
 #include <spl/io/SplReaderWriter.h>
 #include <spl/io/StructureReadWriteManager.h>
 #include <spl/io/XyzReaderWriter.h>
@@ -37,6 +41,14 @@ namespace properties = ssc::structure_properties;
 void
 checkSimilar(const ssc::Structure & str1, const ssc::Structure & str2);
 
+// Is there an up to date index on disk that has the id
+bool
+isIndexed(const fs::path & filepath, const std::string & id)
+{
+  ssio::SplIndex index(filepath);
+  return index.loadIfFresh() && index.find(id) != NULL;
+}
+
 BOOST_AUTO_TEST_CASE(SimilarityTest)
 {
   // SETTINGS ///////
@@ -201,6 +213,212 @@ BOOST_AUTO_TEST_CASE(InfoLineStructure)
       newProperties[properties::searching::TIMES_FOUND]);
 }
 
+BOOST_AUTO_TEST_CASE(SplAppend)
+{
+  // SETTINGS //
+  const size_t NUM_STRUCTURES = 4;
+  const fs::path SAVE_PATH("splAppendTest.yaml");
+
+  if(fs::exists(SAVE_PATH))
+    fs::remove(SAVE_PATH);
+  ssio::SplIndex::remove(SAVE_PATH);
+
+  ssio::SplReaderWriter splIo;
+  splIo.setAppend(true);
+
+  ssio::StructuresContainer structures;
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    ssc::Structure * const structure = new ssc::Structure();
+    structure->setName("str" + boost::lexical_cast< std::string>(i));
+    structure->newAtom("Na").setPosition(arma::randu(3));
+    structures.push_back(structure);
+  }
+
+  splIo.writeStructures(structures, SAVE_PATH);
+  // Writing again appends a second entry with the same id, but with a
+  // different structure
+  ssc::Structure replacement;
+  replacement.setName("str0");
+  replacement.newAtom("Cl").setPosition(arma::randu(3));
+  replacement.newAtom("Cl").setPosition(arma::randu(3));
+  splIo.writeStructure(replacement, SAVE_PATH);
+
+  // The file should still be valid YAML and the last entry should win
+  ssio::StructuresContainer loaded;
+  BOOST_REQUIRE_EQUAL(splIo.readStructures(loaded, SAVE_PATH), NUM_STRUCTURES);
+  ssc::StructurePtr structure = splIo.readStructure(
+      ssio::ResourceLocator(SAVE_PATH, "str0"));
+  BOOST_REQUIRE(structure.get());
+  checkSimilar(replacement, *structure);
+
+  // Compacting should remove the duplicate and keep the last entry
+  BOOST_REQUIRE(splIo.compact(SAVE_PATH));
+  loaded.clear();
+  BOOST_REQUIRE_EQUAL(splIo.readStructures(loaded, SAVE_PATH), NUM_STRUCTURES);
+  structure = splIo.readStructure(ssio::ResourceLocator(SAVE_PATH, "str0"));
+  BOOST_REQUIRE(structure.get());
+  checkSimilar(replacement, *structure);
+
+  ssio::ResourceLocator loc(SAVE_PATH, "str2");
+  structure = splIo.readStructure(loc);
+  BOOST_REQUIRE(structure.get());
+  checkSimilar(structures[2], *structure);
+  // Compacting should have left an up to date index
+  BOOST_REQUIRE(isIndexed(SAVE_PATH, "str2"));
+  BOOST_REQUIRE(splIo.updateIndex(SAVE_PATH));
+
+  // Appending should keep the index up to date
+  structures[3].setName("str4");
+  splIo.writeStructure(structures[3], SAVE_PATH);
+  loc.setId("str4");
+  structure = splIo.readStructure(loc);
+  BOOST_REQUIRE(structure.get());
+  checkSimilar(structures[3], *structure);
+
+  BOOST_REQUIRE(isIndexed(SAVE_PATH, "str4"));
+
+  // A duplicate id should resolve to the last entry whether it is read using
+  // the saved index, a rebuilt one or by parsing the whole file
+  splIo.writeStructure(structures[0], SAVE_PATH);
+  splIo.writeStructure(replacement, SAVE_PATH);
+  loc.setId("str0");
+  structure = splIo.readStructure(loc);
+  BOOST_REQUIRE(structure.get());
+  checkSimilar(replacement, *structure);
+
+  // Reading by id rebuilds a missing index
+  ssio::SplIndex::remove(SAVE_PATH);
+  structure = splIo.readStructure(loc);
+  BOOST_REQUIRE(structure.get());
+  checkSimilar(replacement, *structure);
+  BOOST_REQUIRE(isIndexed(SAVE_PATH, "str0"));
+
+  loaded.clear();
+  BOOST_REQUIRE_EQUAL(splIo.readStructures(loaded, SAVE_PATH),
+      NUM_STRUCTURES + 1);
+  size_t numFound = 0;
+  BOOST_FOREACH(const ssc::Structure & str, loaded)
+  {
+    const ssio::ResourceLocator * const loadedLoc = str.properties().find(
+        properties::io::LAST_ABS_FILE_PATH);
+    BOOST_REQUIRE(loadedLoc);
+    if(loadedLoc->id() == "str0")
+    {
+      checkSimilar(replacement, str);
+      ++numFound;
+    }
+  }
+  BOOST_REQUIRE_EQUAL(numFound, 1u);
+
+  // A plain write followed by an append should leave an up to date index
+  fs::remove(SAVE_PATH);
+  ssio::SplIndex::remove(SAVE_PATH);
+  splIo.setAppend(false);
+  splIo.writeStructure(structures[0], SAVE_PATH);
+  BOOST_REQUIRE(isIndexed(SAVE_PATH, "str0"));
+  splIo.setAppend(true);
+  splIo.writeStructure(structures[1], SAVE_PATH);
+  BOOST_REQUIRE(isIndexed(SAVE_PATH, "str0"));
+  BOOST_REQUIRE(isIndexed(SAVE_PATH, "str1"));
+
+  fs::remove(SAVE_PATH);
+  ssio::SplIndex::remove(SAVE_PATH);
+}
+
+BOOST_AUTO_TEST_CASE(BulkWriters)
+{
+  // SETTINGS //
+  const size_t NUM_STRUCTURES = 3;
+  const size_t NUM_ATOMS = 5;
+  const fs::path SAVE_DIR("bulkWriteTest");
+
+  if(fs::exists(SAVE_DIR))
+    fs::remove_all(SAVE_DIR);
+
+  ssio::StructuresContainer structures;
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    ssc::Structure * const structure = new ssc::Structure(
+        ssc::UnitCell(2.0 + i, 3.0, 4.0, 80.0, 90.0, 100.0));
+    structure->setName("bulk" + boost::lexical_cast< std::string>(i));
+    for(size_t j = 0; j < NUM_ATOMS + i; ++j)
+      structure->newAtom(j % 2 ? "Na" : "Cl").setPosition(arma::randu(3));
+    structures.push_back(structure);
+  }
+
+  const ssio::ResReaderWriter resIo;
+  const ssio::XyzReaderWriter xyzIo;
+
+  // Directory writers
+  resIo.writeStructures(structures, SAVE_DIR / "res");
+  xyzIo.writeStructures(structures, SAVE_DIR / "xyz");
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    const std::string name = structures[i].getName();
+    ssc::StructurePtr loaded = resIo.readStructure(
+        ssio::ResourceLocator(SAVE_DIR / "res" / (name + ".res")));
+    BOOST_REQUIRE(loaded.get());
+    checkSimilar(structures[i], *loaded);
+
+    loaded = xyzIo.readStructure(
+        ssio::ResourceLocator(SAVE_DIR / "xyz" / (name + ".xyz")));
+    BOOST_REQUIRE(loaded.get());
+    checkSimilar(structures[i], *loaded);
+
+    BOOST_REQUIRE(
+        structures[i].properties().find(properties::io::LAST_ABS_FILE_PATH));
+  }
+
+  // A file that can't be opened mustn't be recorded as the structure's path
+  ssio::StructuresContainer unwritable;
+  unwritable.push_back(new ssc::Structure());
+  unwritable[0].setName("unwritable");
+  unwritable[0].newAtom("Na");
+  fs::create_directories(SAVE_DIR / "blocked" / "unwritable.res");
+  resIo.writeStructures(unwritable, SAVE_DIR / "blocked");
+  BOOST_REQUIRE(
+      !unwritable[0].properties().find(properties::io::LAST_ABS_FILE_PATH));
+
+  // Stream writers
+  std::stringstream resStream;
+  resIo.writeStructures(resStream, structures);
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    const ssc::StructurePtr loaded = resIo.readStructure(resStream);
+    BOOST_REQUIRE(loaded.get());
+    checkSimilar(structures[i], *loaded);
+  }
+
+  // Split the multi-frame xyz into one file per frame to read it back
+  std::stringstream xyzStream;
+  xyzIo.writeStructures(xyzStream, structures);
+  std::string line;
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    BOOST_REQUIRE(std::getline(xyzStream, line));
+    const size_t numAtoms = boost::lexical_cast< size_t>(line);
+    BOOST_REQUIRE_EQUAL(numAtoms, structures[i].getNumAtoms());
+
+    const fs::path framePath = SAVE_DIR / "frame.xyz";
+    {
+      fs::ofstream frame(framePath);
+      frame << line << "\n";
+      for(size_t j = 0; j < numAtoms + 1; ++j)
+      {
+        BOOST_REQUIRE(std::getline(xyzStream, line));
+        frame << line << "\n";
+      }
+    }
+    const ssc::StructurePtr loaded = xyzIo.readStructure(
+        ssio::ResourceLocator(framePath));
+    BOOST_REQUIRE(loaded.get());
+    checkSimilar(structures[i], *loaded);
+  }
+
+  fs::remove_all(SAVE_DIR);
+}
+
 void
 checkSimilar(const ssc::Structure & str1, const ssc::Structure & str2)
 {
@@ -0,0 +1,63 @@
+/*
+ * RandomTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <vector>
+
+#include <spl/math/Random.h>
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+#  include <boost/bind.hpp>
+#  include <boost/thread/thread.hpp>
+#endif
+
+namespace ssm = spl::math;
+
+namespace {
+
+const size_t NUM_SAMPLES = 16;
+
+void
+sample(std::vector< double> * const samples)
+{
+  for(size_t i = 0; i < NUM_SAMPLES; ++i)
+    samples->push_back(ssm::randu< double>());
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(Random)
+
+BOOST_AUTO_TEST_CASE(ReseedTest)
+{
+  std::vector< double> first, second;
+  ssm::seed(42);
+  sample(&first);
+  ssm::seed(42);
+  sample(&second);
+  BOOST_CHECK(first == second);
+}
+
+#ifdef SPL_ENABLE_THREAD_AWARE
+BOOST_AUTO_TEST_CASE(ThreadStreamsTest)
+{
+  ssm::seed(42);
+
+  std::vector< double> samples[2];
+  boost::thread first(boost::bind(&sample, &samples[0]));
+  boost::thread second(boost::bind(&sample, &samples[1]));
+  first.join();
+  second.join();
+
+  // Each thread's generator gets a different seed derived from the global one
+  BOOST_CHECK(samples[0] != samples[1]);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+/*
+ * RunningStatsTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <vector>
+
+#include <spl/math/RunningStats.h>
+
+namespace ssm = ::spl::math;
+
+BOOST_AUTO_TEST_CASE(RunningStatsMerge)
+{
+  static const double TOL = 1e-6; // Percent
+  // A large offset makes the naive sqSum/n - mean^2 variance useless
+  static const double OFFSET = 1e9;
+
+  std::vector< double> values;
+  for(int i = 0; i < 1001; ++i)
+    values.push_back(OFFSET + static_cast< double>(i % 7));
+
+  ssm::RunningStats single;
+  single.insert(values.begin(), values.end());
+
+  // Split across separate accumulators, as if on different threads
+  ssm::RunningStats first, second, bulk;
+  first.insert(values.begin(), values.begin() + 400);
+  second.insert(&values[400], values.size() - 400);
+  first.merge(second);
+  bulk.insert(&values[0], values.size());
+
+  double mean = 0.0, variance = 0.0;
+  for(size_t i = 0; i < values.size(); ++i)
+    mean += values[i] - OFFSET;
+  mean /= static_cast< double>(values.size());
+  for(size_t i = 0; i < values.size(); ++i)
+    variance += (values[i] - OFFSET - mean) * (values[i] - OFFSET - mean);
+  variance /= static_cast< double>(values.size());
+
+  const ssm::RunningStats * const stats[] = { &single, &first, &bulk };
+  for(size_t i = 0; i < 3; ++i)
+  {
+    BOOST_CHECK_EQUAL(stats[i]->num(), values.size());
+    BOOST_CHECK_EQUAL(stats[i]->min(), OFFSET);
+    BOOST_CHECK_EQUAL(stats[i]->max(), OFFSET + 6.0);
+    BOOST_CHECK_CLOSE(stats[i]->mean(), OFFSET + mean, TOL);
+    BOOST_CHECK_CLOSE(stats[i]->variance(), variance, TOL);
+  }
+
+  // Merging with an empty set changes nothing
+  ssm::RunningStats empty;
+  empty.merge(single);
+  single.merge(ssm::RunningStats());
+  BOOST_CHECK_CLOSE(empty.variance(), single.variance(), TOL);
+  BOOST_CHECK_EQUAL(empty.num(), single.num());
+}
@@ -51,3 +51,61 @@ BOOST_AUTO_TEST_CASE(ExternalOptimiserTest)
   BOOST_REQUIRE(optData.numIters);
   BOOST_CHECK_EQUAL(*optData.numIters, 1000);
 }
+
+BOOST_AUTO_TEST_CASE(ExternalOptimiserPersistentTest)
+{
+  // The stub worker echoes the structure back and reports the number of
+  // requests it has served as the number of iterations
+  potential::ExternalOptimiser optimiser("./external_optimiser_worker.sh",
+      true);
+  BOOST_REQUIRE(optimiser.isPersistent());
+
+  common::Structure structure;
+  structure.setName("NaCl-external_worker");
+  structure.setUnitCell(common::UnitCell()); // Create a 1 1 1 90 90 90 unit cell
+  structure.newAtom("Na").setPosition(structure.getUnitCell()->randomPoint());
+  structure.newAtom("Cl").setPosition(structure.getUnitCell()->randomPoint());
+
+  potential::OptimisationSettings optSettings;
+  optSettings.energyTol = 2e-5;
+  optSettings.optimisationType =
+      potential::OptimisationSettings::Optimise::ATOMS_AND_LATTICE;
+
+  for(unsigned int i = 1; i <= 3; ++i)
+  {
+    potential::OptimisationData optData;
+    BOOST_REQUIRE(optimiser.optimise(structure, optData, optSettings));
+
+    BOOST_REQUIRE(optData.enthalpy);
+    BOOST_CHECK_EQUAL(*optData.enthalpy, 2.0);
+    BOOST_REQUIRE(optData.internalEnergy);
+    BOOST_CHECK_EQUAL(*optData.internalEnergy, 1.0);
+    BOOST_REQUIRE(optData.numIters);
+    // Same process should have served all the requests
+    BOOST_CHECK_EQUAL(*optData.numIters, i);
+
+    BOOST_REQUIRE_EQUAL(structure.getNumAtoms(), 2);
+    BOOST_CHECK_EQUAL(structure.getName(), "NaCl-external_worker");
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ExternalOptimiserEmptyFrameTest)
+{
+  // The worker claims success but sends back an empty structure frame
+  potential::ExternalOptimiser optimiser(
+      "./external_optimiser_worker.sh --empty", true);
+
+  common::Structure structure;
+  structure.setName("NaCl-external_empty");
+  structure.setUnitCell(common::UnitCell());
+  structure.newAtom("Na").setPosition(structure.getUnitCell()->randomPoint());
+  structure.newAtom("Cl").setPosition(structure.getUnitCell()->randomPoint());
+
+  potential::OptimisationSettings optSettings;
+  potential::OptimisationData optData;
+  BOOST_CHECK(!optimiser.optimise(structure, optData, optSettings));
+
+  // The structure must be left as it was
+  BOOST_REQUIRE_EQUAL(structure.getNumAtoms(), 2);
+  BOOST_CHECK_EQUAL(structure.getName(), "NaCl-external_empty");
+}
@@ -0,0 +1,47 @@
+#!/bin/bash
+
+# Stub persistent optimiser: reads length-prefixed settings and structure
+# frames from stdin and echoes the structure back along with fixed results.
+# finalIters is the number of requests served so far so callers can check
+# that the same process is being reused.  With --empty an empty structure
+# frame is sent back instead.
+
+export LC_ALL=C
+
+function read_frame {
+  local len
+  IFS= read -r len || return 1
+  frame=""
+  if [ "$len" -gt 0 ]; then
+    IFS= read -r -N "$len" frame || return 1
+  fi
+  return 0
+}
+
+function write_frame {
+  printf '%d\n%s' "${#1}" "$1"
+}
+
+declare -i served=0
+
+while read_frame; do
+  settings="$frame"
+  read_frame || exit 1
+  structure="$frame"
+  served=served+1
+
+  results="successful: true
+finalEnthalpy: 2
+finalInternalEnergy: 1
+finalPressure: 0
+finalIters: $served
+"
+  write_frame "$results"
+  if [ "$1" = "--empty" ]; then
+    write_frame ""
+  else
+    write_frame "$structure"
+  fi
+done
+
+exit 0
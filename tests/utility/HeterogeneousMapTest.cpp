@@ -115,3 +115,38 @@ BOOST_AUTO_TEST_CASE(HeterogeneousMapExTest)
   map.insert(AGE_KEY, 15);
   map.erase(AGE_KEY);
 }
+
+BOOST_AUTO_TEST_CASE(HeterogeneousMapValueTypes)
+{
+  ssu::Key< double> doubleKey;
+  ssu::Key< ::arma::mat33> matKey;
+  // Not stored inline
+  ssu::Key< long> longKey;
+
+  ssu::HeterogeneousMap map;
+  map[doubleKey] = 1.5;
+  ::arma::mat33 mat;
+  mat.eye();
+  BOOST_REQUIRE(map.insert(matKey, mat));
+  BOOST_REQUIRE(!map.insert(matKey, mat));
+  map[longKey] = 42L;
+
+  ssu::HeterogeneousMap copy(map);
+  BOOST_REQUIRE(copy.size() == 3);
+  BOOST_REQUIRE(copy.find(doubleKey) && *copy.find(doubleKey) == 1.5);
+  BOOST_REQUIRE(copy.find(matKey) && (*copy.find(matKey))(1, 1) == 1.0);
+  BOOST_REQUIRE(copy.find(longKey) && *copy.find(longKey) == 42L);
+
+  // Values in the copy are independent of the original
+  copy[doubleKey] = 2.5;
+  BOOST_REQUIRE(*map.find(doubleKey) == 1.5);
+
+  {
+    ssu::Key< ::std::string> scopedKey;
+    map[scopedKey] = "scoped";
+    copy[scopedKey] = "scoped";
+  }
+  // The key should have removed itself from both maps
+  BOOST_REQUIRE(map.size() == 3);
+  BOOST_REQUIRE(copy.size() == 3);
+}
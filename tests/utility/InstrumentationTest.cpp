@@ -0,0 +1,61 @@
+/*
+ * InstrumentationTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <sstream>
+
+#include <spl/utility/Instrumentation.h>
+
+namespace instr = ::spl::utility::instrumentation;
+
+BOOST_AUTO_TEST_CASE(InstrumentationTest)
+{
+  const bool wasEnabled = instr::isEnabled();
+
+  instr::reset();
+  instr::setEnabled(false);
+  instr::count("test.counter");
+  BOOST_CHECK(instr::getReport().counters.empty());
+
+  instr::setEnabled(true);
+  instr::count("test.counter");
+  instr::count("test.counter", 2);
+  instr::sample("test.histogram", 0.0);
+  instr::sample("test.histogram", 3.0);
+  instr::sample("test.histogram", 3.5);
+  {
+    const instr::ScopedTimer timer("test.timer");
+  }
+
+  const instr::Report report = instr::getReport();
+  BOOST_REQUIRE(report.counters.find("test.counter") != report.counters.end());
+  BOOST_CHECK_EQUAL(report.counters.find("test.counter")->second, 3);
+
+  BOOST_REQUIRE(report.timers.find("test.timer") != report.timers.end());
+  BOOST_CHECK_EQUAL(report.timers.find("test.timer")->second.calls, 1);
+
+  BOOST_REQUIRE(
+      report.histograms.find("test.histogram") != report.histograms.end());
+  const instr::HistogramStats & hist =
+      report.histograms.find("test.histogram")->second;
+  BOOST_CHECK_EQUAL(hist.count, 3);
+  BOOST_CHECK_EQUAL(hist.min, 0.0);
+  BOOST_CHECK_EQUAL(hist.max, 3.5);
+  // 0 is in the lowest bin, 3 and 3.5 are both in [2, 4)
+  BOOST_CHECK_EQUAL(hist.bins.size(), 2u);
+
+  std::ostringstream json;
+  report.writeJson(json);
+  BOOST_CHECK(json.str().find("\"test.counter\": 3") != std::string::npos);
+
+  instr::reset();
+  BOOST_CHECK(instr::getReport().counters.empty());
+
+  instr::setEnabled(wasEnabled);
+}
@@ -0,0 +1,89 @@
+/*
+ * MultiArrayTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <set>
+
+#include <spl/utility/MultiArray.h>
+#include <spl/utility/MultiIdx.h>
+
+namespace ssu = ::spl::utility;
+
+BOOST_AUTO_TEST_CASE(FixedDimsArrayTest)
+{
+  typedef ssu::MultiArray<int, 3> Array3;
+
+  Array3::Index extents;
+  extents[0] = 2;
+  extents[1] = 3;
+  extents[2] = 4;
+  Array3 fixed(extents, -1);
+  ssu::MultiArray<int> dynamic(extents.toDynamic(), -1);
+  BOOST_CHECK(fixed.getExtents() == extents);
+
+  Array3::Index idx;
+  for(idx[2] = 0; idx[2] < extents[2]; ++idx[2])
+  {
+    for(idx[1] = 0; idx[1] < extents[1]; ++idx[1])
+    {
+      for(idx[0] = 0; idx[0] < extents[0]; ++idx[0])
+      {
+        BOOST_REQUIRE(fixed[idx] == -1);
+        // The first dimension varies fastest, as for the runtime array
+        const int linear = static_cast<int>(idx[0] + 2 * idx[1] + 6 * idx[2]);
+        fixed[idx] = linear;
+        dynamic[idx.toDynamic()] = linear;
+      }
+    }
+  }
+
+  // Every index maps to its own element and agrees with the runtime array
+  std::set<int> seen;
+  for(idx[2] = 0; idx[2] < extents[2]; ++idx[2])
+  {
+    for(idx[1] = 0; idx[1] < extents[1]; ++idx[1])
+    {
+      for(idx[0] = 0; idx[0] < extents[0]; ++idx[0])
+      {
+        const Array3 & constFixed = fixed;
+        BOOST_CHECK(constFixed[idx]
+            == static_cast<int>(idx[0] + 2 * idx[1] + 6 * idx[2]));
+        BOOST_CHECK(constFixed[idx] == dynamic[idx.toDynamic()]);
+        seen.insert(constFixed[idx]);
+      }
+    }
+  }
+  BOOST_CHECK(seen.size() == extents.product());
+
+  fixed.fill(7);
+  BOOST_CHECK(fixed[idx - idx] == 7);
+  BOOST_CHECK(fixed[Array3::Index(1)] == 7);
+}
+
+BOOST_AUTO_TEST_CASE(FixedDimsArrayZeroExtentTest)
+{
+  typedef ssu::MultiArray<int, 2> Array2;
+
+  // Zero extents are ignored so the index in that dimension doesn't matter
+  Array2::Index extents;
+  extents[0] = 0;
+  extents[1] = 3;
+  Array2 array(extents, 0);
+
+  Array2::Index idx;
+  for(idx[1] = 0; idx[1] < extents[1]; ++idx[1])
+    array[idx] = static_cast<int>(idx[1]) + 1;
+
+  for(idx[1] = 0; idx[1] < extents[1]; ++idx[1])
+  {
+    Array2::Index other(idx);
+    other[0] = 5;
+    BOOST_CHECK(array[other] == static_cast<int>(idx[1]) + 1);
+  }
+}
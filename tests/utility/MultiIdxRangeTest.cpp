@@ -84,3 +84,69 @@ BOOST_AUTO_TEST_CASE(OneDimensionalRange)
   //  --i;
   //}
 }
+
+BOOST_AUTO_TEST_CASE(FixedDimsRange)
+{
+  typedef ssu::MultiIdx<unsigned int, 3> Idx3;
+  typedef ssu::MultiIdxRange<unsigned int, 3> Range3;
+
+  Idx3 x0, x1;
+  x0[0] = 1;
+  x0[1] = 0;
+  x0[2] = 2;
+  x1[0] = 3;
+  x1[1] = 2;
+  x1[2] = 4;
+
+  const Range3 range(x0, x1);
+  BOOST_CHECK(range.dims() == 3);
+  BOOST_CHECK(*range.begin() == x0);
+
+  // The first digit goes fastest and wraps back to its start, carrying into
+  // the next one
+  Idx3 expected(x0);
+  size_t i = 0;
+  for(Range3::const_iterator it = range.begin(), end = range.end(); it != end;
+      ++it)
+  {
+    BOOST_REQUIRE(i < (x1 - x0).product());
+    BOOST_CHECK(*it == expected);
+    BOOST_CHECK(x0 <= *it);
+
+    for(size_t d = 0; d < 3; ++d)
+    {
+      if(++expected[d] < x1[d])
+        break;
+      expected[d] = x0[d];
+    }
+    ++i;
+  }
+  BOOST_CHECK(i == (x1 - x0).product());
+
+  // Incrementing the last index in the range gives the end
+  Idx3 last(x1);
+  last -= Idx3(1);
+  Range3::const_iterator it = range.begin();
+  for(size_t j = 1; j < i; ++j)
+    ++it;
+  BOOST_CHECK(*it == last);
+  ++it;
+  BOOST_CHECK(it == range.end());
+  BOOST_CHECK(*it == x1);
+}
+
+BOOST_AUTO_TEST_CASE(FixedDimsOneDimensionalRange)
+{
+  typedef ssu::MultiIdx<int, 1> Idx1;
+
+  const ssu::MultiIdxRange<int, 1> range(Idx1(-2), Idx1(5));
+
+  int i = -2;
+  for(ssu::MultiIdxRange<int, 1>::const_iterator it = range.begin(),
+      end = range.end(); it != end; ++it)
+  {
+    BOOST_CHECK((*it)[0] == i);
+    ++i;
+  }
+  BOOST_CHECK(i == 5);
+}
@@ -44,3 +44,29 @@ BOOST_AUTO_TEST_CASE(BasicTest)
 
 
 }
+
+BOOST_AUTO_TEST_CASE(FixedDimsTest)
+{
+  typedef ssu::MultiIdx<unsigned int, 3> Idx3;
+  Idx3 a, b(3);
+
+  BOOST_CHECK(a.dims() == 3);
+  for(size_t i = 0; i < a.dims(); ++i)
+    BOOST_CHECK(a[i] == 0);
+  BOOST_CHECK(a != b);
+  BOOST_CHECK(b > a);
+  BOOST_CHECK(b.sum() == 9);
+  BOOST_CHECK(b.product() == 27);
+
+  a += b;
+  BOOST_CHECK(a == b);
+  BOOST_CHECK((a - b) == Idx3());
+
+  // Round trip through the runtime index
+  const ssu::MultiIdx<unsigned int> dynamic = b.toDynamic();
+  BOOST_REQUIRE(dynamic.dims() == 3);
+  BOOST_CHECK(dynamic[2] == 3);
+  BOOST_CHECK(Idx3(dynamic) == b);
+  const ssu::MultiIdx<unsigned int> wrongDims(2);
+  BOOST_CHECK_THROW(Idx3(wrongDims).sum(), std::logic_error);
+}
@@ -0,0 +1,104 @@
+/*
+ * PoolAllocatedTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <set>
+
+#include <spl/utility/PoolAllocated.h>
+
+namespace ssu = ::spl::utility;
+
+namespace {
+
+class Pooled : public ssu::PoolAllocated< Pooled>
+{
+public:
+  explicit
+  Pooled(const double value) :
+      myValue(value)
+  {
+  }
+  virtual
+  ~Pooled()
+  {
+  }
+  double
+  getValue() const
+  {
+    return myValue;
+  }
+private:
+  double myValue;
+};
+
+// Too big for the pool of its base so has to fall back to the heap
+class BigPooled : public Pooled
+{
+public:
+  BigPooled() :
+      Pooled(1.0)
+  {
+    for(size_t i = 0; i < 16; ++i)
+      myExtra[i] = static_cast< double>(i);
+  }
+  double
+  getExtra(const size_t i) const
+  {
+    return myExtra[i];
+  }
+private:
+  double myExtra[16];
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(PoolAllocatedTests)
+
+BOOST_AUTO_TEST_CASE(ReuseTest)
+{
+  static const size_t NUM_OBJECTS = 100;
+
+  std::set< const void *> addresses;
+  Pooled * objects[NUM_OBJECTS];
+  for(size_t i = 0; i < NUM_OBJECTS; ++i)
+  {
+    objects[i] = new Pooled(static_cast< double>(i));
+    addresses.insert(objects[i]);
+  }
+  // All distinct and intact
+  BOOST_REQUIRE_EQUAL(addresses.size(), NUM_OBJECTS);
+  for(size_t i = 0; i < NUM_OBJECTS; ++i)
+    BOOST_REQUIRE_EQUAL(objects[i]->getValue(), static_cast< double>(i));
+
+  for(size_t i = 0; i < NUM_OBJECTS; ++i)
+    delete objects[i];
+
+  // Once warmed up the pool should hand back blocks it already has
+  for(size_t i = 0; i < NUM_OBJECTS; ++i)
+  {
+    objects[i] = new Pooled(0.0);
+    BOOST_CHECK(addresses.count(objects[i]) == 1);
+  }
+  for(size_t i = 0; i < NUM_OBJECTS; ++i)
+    delete objects[i];
+}
+
+BOOST_AUTO_TEST_CASE(DerivedTest)
+{
+  // Deleting through the base has to give the block back to the right place
+  Pooled * const big = new BigPooled();
+  BOOST_REQUIRE_EQUAL(static_cast< BigPooled *>(big)->getExtra(15), 15.0);
+  delete big;
+
+  Pooled * const small = new Pooled(2.0);
+  BOOST_REQUIRE_EQUAL(small->getValue(), 2.0);
+  delete small;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,172 @@
+/*
+ * SimilarityIndexTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <boost/ptr_container/ptr_vector.hpp>
+
+#include <spl/common/Structure.h>
+#include <spl/common/UnitCell.h>
+#include <spl/utility/FingerprintComparator.h>
+#include <spl/utility/SimilarityIndex.h>
+
+namespace ssc = spl::common;
+namespace ssu = spl::utility;
+
+namespace {
+
+ssc::StructurePtr
+randomStructure(const size_t numPairs)
+{
+  static const double A = 4.0;
+
+  ssc::StructurePtr structure(new ssc::Structure());
+  structure->setUnitCell(ssc::UnitCell(A, A, A, 90.0, 90.0, 90.0));
+  for(size_t i = 0; i < numPairs; ++i)
+  {
+    structure->newAtom("Na").setPosition(arma::randu< arma::vec>(3) * A);
+    structure->newAtom("Cl").setPosition(arma::randu< arma::vec>(3) * A);
+  }
+  return structure;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(SimilarityIndexTest)
+{
+  static const size_t NUM_STRUCTURES = 80;
+  static const size_t K = 5;
+
+  ssu::FingerprintComparator::ConstructionInfo info;
+  info.cutoff = 4.0;
+  info.metric = ssu::FingerprintMetric::EUCLIDEAN;
+  const ssu::FingerprintComparator comparator(info);
+  BOOST_REQUIRE(comparator.isMetric());
+
+  ssu::SimilarityIndex index(comparator);
+  boost::ptr_vector< ssc::Structure> structures;
+  std::vector< bool> erased;
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    // NaCl and Na2Cl2 share a partition
+    structures.push_back(randomStructure(1 + i % 2).release());
+    BOOST_REQUIRE(index.insert(structures.back()) == i);
+    erased.push_back(false);
+  }
+  for(size_t i = 0; i < NUM_STRUCTURES; i += 3)
+  {
+    BOOST_REQUIRE(index.erase(i));
+    erased[i] = true;
+  }
+  BOOST_REQUIRE(!index.erase(0));
+  BOOST_REQUIRE(index.size() == NUM_STRUCTURES - (NUM_STRUCTURES + 2) / 3);
+
+  // Compare against a brute force search
+  for(size_t q = 0; q < 10; ++q)
+  {
+    const ssc::StructurePtr query = randomStructure(1);
+    const ssu::SimilarityIndex::Matches matches = index.findNearest(*query,
+        K);
+
+    ssu::SimilarityIndex::Matches expected;
+    for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+    {
+      if(!erased[i])
+        expected.push_back(
+            ssu::SimilarityIndex::Match(
+                comparator.compareStructures(*query, structures[i]), i));
+    }
+    std::sort(expected.begin(), expected.end());
+    expected.resize(K);
+
+    BOOST_REQUIRE(matches.size() == K);
+    for(size_t i = 0; i < K; ++i)
+    {
+      BOOST_REQUIRE(matches[i].second == expected[i].second);
+      BOOST_REQUIRE(std::abs(matches[i].first - expected[i].first) < 1e-6);
+    }
+  }
+
+  // Different compositions are never matched
+  ssc::Structure sodium;
+  sodium.setUnitCell(ssc::UnitCell(4.0, 4.0, 4.0, 90.0, 90.0, 90.0));
+  sodium.newAtom("Na").setPosition(arma::zeros< arma::vec>(3));
+  BOOST_REQUIRE(index.findNearest(sodium, K).empty());
+
+  // Nothing is further than the maximum distance
+  const ssu::SimilarityIndex::Matches close = index.findNearest(structures[1],
+      K, 1e-6);
+  BOOST_REQUIRE(close.size() == 1);
+  BOOST_REQUIRE(close[0].second == 1);
+
+  index.clear();
+  BOOST_REQUIRE(index.empty());
+  BOOST_REQUIRE(index.findNearest(structures[1], K).empty());
+}
+
+BOOST_AUTO_TEST_CASE(SimilarityIndexDuplicatesTest)
+{
+  static const size_t NUM_DUPLICATES = 200;
+  static const size_t NUM_OTHERS = 40;
+  static const size_t K = 5;
+
+  ssu::FingerprintComparator::ConstructionInfo info;
+  info.cutoff = 4.0;
+  info.metric = ssu::FingerprintMetric::EUCLIDEAN;
+  const ssu::FingerprintComparator comparator(info);
+
+  // Deduplicating sees many copies of the same structure which shouldn't
+  // unbalance the tree
+  ssu::SimilarityIndex index(comparator);
+  const ssc::StructurePtr original = randomStructure(2);
+  boost::ptr_vector< ssc::Structure> structures;
+  for(size_t i = 0; i < NUM_DUPLICATES + NUM_OTHERS; ++i)
+  {
+    if(i % 6 == 0)
+      structures.push_back(randomStructure(2).release());
+    else
+      structures.push_back(new ssc::Structure(*original));
+    index.insert(structures.back());
+  }
+  BOOST_REQUIRE(index.size() == NUM_DUPLICATES + NUM_OTHERS);
+
+  const ssu::SimilarityIndex::Matches copies = index.findNearest(*original,
+      K);
+  BOOST_REQUIRE(copies.size() == K);
+  for(size_t i = 0; i < K; ++i)
+    BOOST_REQUIRE(copies[i].first == 0.0);
+  BOOST_REQUIRE(index.getNumComparisons() < structures.size() / 4);
+
+  // Compare distances against a brute force search, ids of equidistant
+  // entries can come in any order
+  for(size_t q = 0; q < 5; ++q)
+  {
+    const ssc::StructurePtr query = randomStructure(2);
+    const ssu::SimilarityIndex::Matches matches = index.findNearest(*query,
+        K);
+
+    std::vector< double> expected;
+    for(size_t i = 0; i < structures.size(); ++i)
+      expected.push_back(comparator.compareStructures(*query, structures[i]));
+    std::sort(expected.begin(), expected.end());
+
+    BOOST_REQUIRE(matches.size() == K);
+    for(size_t i = 0; i < K; ++i)
+    {
+      BOOST_REQUIRE(std::abs(matches[i].first - expected[i]) < 1e-6);
+      BOOST_REQUIRE(
+          std::abs(
+              comparator.compareStructures(*query,
+                  structures[matches[i].second]) - matches[i].first) < 1e-6);
+    }
+  }
+}
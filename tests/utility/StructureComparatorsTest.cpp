@@ -25,6 +25,7 @@
 #include <spl/io/ResourceLocator.h>
 #include <spl/io/ResReaderWriter.h>
 #include <spl/utility/DistanceMatrixComparator.h>
+#include <spl/utility/FingerprintComparator.h>
 #include <spl/utility/IBufferedComparator.h>
 #include <spl/utility/StableComparison.h>
 #include <spl/utility/SortedDistanceComparator.h>
@@ -292,4 +293,129 @@ BOOST_AUTO_TEST_CASE(SupercellTest)
 
 }
 
+BOOST_AUTO_TEST_CASE(FingerprintComparatorTest)
+{
+  static const double A = 2.0;
+
+  // CsCl in one cell and in a doubled cell
+  ssc::Structure cscl;
+  cscl.setUnitCell(ssc::UnitCell(A, A, A, 90.0, 90.0, 90.0));
+  cscl.newAtom("Cs").setPosition(arma::zeros< arma::vec>(3));
+  cscl.newAtom("Cl").setPosition(arma::ones< arma::vec>(3) * 0.5 * A);
+
+  ssc::Structure doubled;
+  doubled.setUnitCell(ssc::UnitCell(2.0 * A, A, A, 90.0, 90.0, 90.0));
+  for(size_t i = 0; i < 2; ++i)
+  {
+    for(size_t atom = 0; atom < cscl.getNumAtoms(); ++atom)
+    {
+      const ssc::Atom & orig = cscl.getAtom(atom);
+      doubled.newAtom(orig.getSpecies()).setPosition(
+          orig.getPosition() + cscl.getUnitCell()->getAVec() * i);
+    }
+  }
+
+  // Same lattice but with the Cl atom moved off the body centre
+  ssc::Structure distorted(cscl);
+  distorted.getAtom(1).setPosition(arma::ones< arma::vec>(3) * 0.3 * A);
+
+  ssc::Structure differentSpecies;
+  differentSpecies.setUnitCell(*cscl.getUnitCell());
+  differentSpecies.newAtom("Cs").setPosition(cscl.getAtom(0).getPosition());
+  differentSpecies.newAtom("Na").setPosition(cscl.getAtom(1).getPosition());
+
+  ssu::FingerprintComparator::ConstructionInfo info;
+  info.cutoff = 5.0;
+  const ssu::FingerprintComparator cosine(info);
+  info.metric = ssu::FingerprintMetric::EUCLIDEAN;
+  const ssu::FingerprintComparator euclidean(info);
+
+  const ssu::IStructureComparator * const comparators[] =
+    { &cosine, &euclidean };
+  for(size_t i = 0; i < 2; ++i)
+  {
+    BOOST_CHECK_SMALL(comparators[i]->compareStructures(cscl, cscl), 1e-6);
+    BOOST_CHECK_SMALL(comparators[i]->compareStructures(cscl, doubled), 1e-4);
+    BOOST_CHECK(comparators[i]->areSimilar(cscl, doubled));
+    BOOST_CHECK(!comparators[i]->areSimilar(cscl, distorted));
+    BOOST_CHECK_EQUAL(
+        comparators[i]->compareStructures(cscl, differentSpecies),
+        std::numeric_limits< double>::max());
+  }
+
+  // The fingerprints have one fixed length block per species pair
+  const ssu::FingerprintComparator::ComparisonDataPtr data =
+      cosine.generateComparisonData(cscl);
+  BOOST_CHECK_EQUAL(data->fingerprint.size(), 3u * 100u);
+
+  // Only a volume agnostic comparator should see an expanded copy as the same
+  ssc::Structure expanded(cscl);
+  expanded.scale(1.5 * 1.5 * 1.5);
+  info.metric = ssu::FingerprintMetric::COSINE;
+  info.volumeAgnostic = true;
+  const ssu::FingerprintComparator agnostic(info);
+  BOOST_CHECK(!cosine.areSimilar(cscl, expanded));
+  BOOST_CHECK(agnostic.areSimilar(cscl, expanded));
+  BOOST_CHECK_SMALL(agnostic.compareStructures(cscl, expanded), 1e-4);
+  BOOST_CHECK_EQUAL(agnostic.generateComparisonData(expanded)->fingerprint.size(),
+      3u * 100u);
+}
+
+BOOST_AUTO_TEST_CASE(ThresholdedComparisonTest)
+{
+  typedef boost::ptr_vector< ssu::IStructureComparator> Comparators;
+  static const double A = 4.0;
+  static const size_t NUM_STRUCTURES = 10;
+
+  // Random structures and slightly perturbed copies of them
+  boost::ptr_vector< ssc::Structure> structures;
+  for(size_t i = 0; i < NUM_STRUCTURES; ++i)
+  {
+    ssc::StructurePtr structure(new ssc::Structure());
+    structure->setUnitCell(ssc::UnitCell(A, A, A, 90.0, 90.0, 90.0));
+    for(size_t atom = 0; atom < 2; ++atom)
+    {
+      structure->newAtom("Na").setPosition(arma::randu< arma::vec>(3) * A);
+      structure->newAtom("Cl").setPosition(arma::randu< arma::vec>(3) * A);
+    }
+    ssc::StructurePtr perturbed(new ssc::Structure(*structure));
+    ssc::Atom & atom = perturbed->getAtom(0);
+    atom.setPosition(atom.getPosition() + arma::randu< arma::vec>(3) * 1e-4);
+
+    structures.push_back(structure.release());
+    structures.push_back(perturbed.release());
+  }
+
+  // The tolerances are the defaults for each comparator
+  Comparators comparators;
+  std::vector< double> tolerances;
+  comparators.push_back(new ssu::SortedDistanceComparator());
+  tolerances.push_back(ssu::SortedDistanceComparator::DEFAULT_TOLERANCE);
+  // Full and fast distance matrix comparisons
+  comparators.push_back(new ssu::DistanceMatrixComparator());
+  tolerances.push_back(ssu::DistanceMatrixComparator::DEFAULT_TOLERANCE);
+  comparators.push_back(new ssu::DistanceMatrixComparator(0));
+  tolerances.push_back(ssu::DistanceMatrixComparator::DEFAULT_TOLERANCE);
+
+  // Stopping early must never change the outcome of areSimilar
+  for(size_t k = 0; k < comparators.size(); ++k)
+  {
+    const boost::shared_ptr< ssu::IBufferedComparator> buffered =
+        comparators[k].generateBuffered();
+    std::vector< ssu::IBufferedComparator::ComparisonDataHandle> handles;
+    for(size_t i = 0; i < structures.size(); ++i)
+      handles.push_back(buffered->generateComparisonData(structures[i]));
+
+    for(size_t i = 0; i < structures.size(); ++i)
+    {
+      for(size_t j = i; j < structures.size(); ++j)
+      {
+        BOOST_CHECK_EQUAL(buffered->areSimilar(handles[i], handles[j]),
+            buffered->compareStructures(handles[i], handles[j])
+                < tolerances[k]);
+      }
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
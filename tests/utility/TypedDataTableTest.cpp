@@ -0,0 +1,55 @@
+/*
+ * TypedDataTableTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Martin Uhrin
+ */
+
+// INCLUDES //////////////////////////////////
+#include "sslibtest.h"
+
+#include <string>
+#include <vector>
+
+#include <spl/utility/TypedDataTable.h>
+
+namespace ssu = ::spl::utility;
+
+BOOST_AUTO_TEST_CASE(TypedDataTableTest)
+{
+  typedef ssu::TypedDataTable< ::std::string> Table;
+
+  ssu::TypedColumn< double, ::std::string> enthalpy("enthalpy");
+  Table table;
+
+  table.set(::std::string("c"), enthalpy, 3.0);
+  table.set(::std::string("a"), enthalpy, 1.0);
+  table.set(::std::string("b"), enthalpy, 2.0);
+  BOOST_REQUIRE(table.size() == 3);
+  BOOST_REQUIRE(table.get(::std::string("a"), enthalpy));
+  BOOST_REQUIRE(*table.get(::std::string("a"), enthalpy) == 1.0);
+
+  {
+    // A row without a value should be last in the sorted keys
+    ssu::TypedColumn< int, ::std::string> other("other");
+    table.set(::std::string("d"), other, 1);
+
+    Table::SortedKeys keys;
+    table.getDescending(keys, enthalpy);
+    BOOST_REQUIRE(keys.size() == 4);
+    BOOST_REQUIRE(keys[0] == "c" && keys[2] == "a" && keys[3] == "d");
+  }
+  // Check the column going out of scope removed its values
+  table.set(::std::string("e"), enthalpy, 0.5);
+  table.eraseRow(::std::string("d"));
+  table.eraseRow(::std::string("b"));
+
+  Table::SortedKeys keys;
+  table.getAscending(keys, enthalpy);
+  BOOST_REQUIRE(keys.size() == 3);
+  BOOST_REQUIRE(keys[0] == "e" && keys[1] == "a" && keys[2] == "c");
+
+  ::std::vector< double> values;
+  table.getValues(values, enthalpy);
+  BOOST_REQUIRE(values.size() == 3);
+}